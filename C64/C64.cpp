@@ -74,7 +74,7 @@ void
 // Class methods
 //
 
-C64::C64()
+C64::C64() : rewindBuffer(this), profiler(this), hasher(this)
 {
 	setDescription("C64");
 	debug("Creating virtual C64[%p]\n", this);
@@ -97,12 +97,14 @@ C64::C64()
         &expansionport,
         &floppy,
         &datasette,
+        &virtualDrive,
         &mouse1350,
         &mouse1351,
         &neosMouse,
         &keyboard,
         &port1,
         &port2,
+        &movie,
         NULL };
     
     registerSubComponents(subcomponents, sizeof(subcomponents));
@@ -111,10 +113,8 @@ C64::C64()
     // Register snapshot items
     SnapshotItem items[] = {
  
-        { &wakeUpCycleCIA1, sizeof(wakeUpCycleCIA1),    CLEAR_ON_RESET },
-        { &idleCounterCIA1, sizeof(idleCounterCIA1),    CLEAR_ON_RESET },
-        { &wakeUpCycleCIA2, sizeof(wakeUpCycleCIA2),    CLEAR_ON_RESET },
-        { &idleCounterCIA2, sizeof(idleCounterCIA2),    CLEAR_ON_RESET },
+        { wakeUpCycle,      sizeof(wakeUpCycle),        CLEAR_ON_RESET | QUAD_WORD_FORMAT },
+        { &nextWakeUpCycle, sizeof(nextWakeUpCycle),    CLEAR_ON_RESET },
         { &warp,            sizeof(warp),               CLEAR_ON_RESET },
         { &alwaysWarp,      sizeof(alwaysWarp),         CLEAR_ON_RESET },
         { &warpLoad,        sizeof(warpLoad),           KEEP_ON_RESET },
@@ -138,19 +138,13 @@ C64::C64()
     mouse = &mouse1350;
     mousePort = 0;
     setPAL();
-			
-    // Initialize mach timer info
-    mach_timebase_info(&timebase);
 
 	// Initialize snapshot ringbuffers
-    for (unsigned i = 0; i < MAX_AUTO_SAVED_SNAPSHOTS; i++) {
-		autoSavedSnapshots[i] = new Snapshot();
-    }
     for (unsigned i = 0; i < MAX_USER_SAVED_SNAPSHOTS; i++) {
         userSavedSnapshots[i] = new Snapshot();
     }
     autoSaveSnapshots = true;
-    autoSaveInterval = 3;
+    autoSaveInterval = 1;
 
     reset();
 }
@@ -334,6 +328,11 @@ C64::run()
         // Power up sub components
         sid.run();
         
+#ifdef VC64_PROFILE
+        // Don't charge the time the emulator was halted to the first frame
+        profiler.beginFrame();
+#endif
+        
         // Start execution thread
         pthread_create(&p, NULL, runThread, (void *)this);
     }
@@ -344,6 +343,9 @@ C64::threadCleanup()
 {
     p = NULL;
     debug(1, "Execution thread cleanup\n");
+    
+    // Let the debugger see the current drive state
+    floppy.wakeUp();
 }
 
 bool
@@ -406,11 +408,11 @@ C64::step()
 // '---------------------------------------------------------------'
 
 #define EXECUTE \
-if (cycle >= wakeUpCycleCIA1) cia1.executeOneCycle(); else idleCounterCIA1++; \
-if (cycle >= wakeUpCycleCIA2) cia2.executeOneCycle(); else idleCounterCIA2++; \
+if (cycle >= nextWakeUpCycle) executeEventsBeforeCPU(); \
+PROFILE_SWITCH(profiler, PROF_CPU); \
 if (!cpu.executeOneCycle()) result = false; \
-if (!floppy.executeOneCycle()) result = false; \
-datasette.execute(); \
+if (!floppy.isSleeping() && !floppy.executeOneCycle()) result = false; \
+if (cycle >= nextWakeUpCycle) executeEventsAfterCPU(); \
 cycle++; \
 rasterlineCycle++;
 
@@ -419,6 +421,7 @@ C64::executeOneCycle()
 {
     bool result = true; // Don't break execution
     
+    PROFILE_SWITCH(profiler, PROF_VIC);
     switch(rasterlineCycle) {
         case 1:
             beginOfRasterline();
@@ -561,6 +564,30 @@ C64::executeOneCycle()
     return result;
 }
 
+void
+C64::executeEventsBeforeCPU()
+{
+    if (cycle >= wakeUpCycle[EVENT_INPUT]) movie.execute();
+    PROFILE_SWITCH(profiler, PROF_CIA);
+    if (cycle >= wakeUpCycle[EVENT_CIA1]) cia1.executeOneCycle();
+    if (cycle >= wakeUpCycle[EVENT_CIA2]) cia2.executeOneCycle();
+    if (cycle >= wakeUpCycle[EVENT_VC1541]) floppy.wakeUp();
+}
+
+void
+C64::executeEventsAfterCPU()
+{
+    PROFILE_SWITCH(profiler, PROF_DATASETTE);
+    if (cycle >= wakeUpCycle[EVENT_DATASETTE]) datasette.execute();
+    
+    // Determine the next cycle in which a component needs attention
+    nextWakeUpCycle = wakeUpCycle[0];
+    for (unsigned i = 1; i < EVENT_SLOTS; i++) {
+        if (wakeUpCycle[i] < nextWakeUpCycle)
+            nextWakeUpCycle = wakeUpCycle[i];
+    }
+}
+
 bool
 C64::executeOneLine()
 {
@@ -572,6 +599,16 @@ C64::executeOneLine()
     return true;
 }
 
+bool
+C64::executeOneFrame()
+{
+    do {
+        if (!executeOneLine())
+            return false;
+    } while (rasterline != 0);
+    return true;
+}
+
 void
 C64::beginOfRasterline()
 {
@@ -593,6 +630,9 @@ C64::endOfRasterline()
         rasterline = 0;
         endOfFrame();
     }
+    
+    // Apply the input that has been reported by the GUI in the meantime
+    if (movie.hasPendingInput()) movie.processInput();
 }
 
 void
@@ -600,6 +640,7 @@ C64::endOfFrame()
 {
     frame++;
     vic.endFrame();
+    PROFILE_SWITCH(profiler, PROF_OTHER);
     
     // Increment time of day clocks every tenth of a second
     cia1.incrementTOD();
@@ -615,15 +656,26 @@ C64::endOfFrame()
     // Update mouse coordinates
     if (mousePort != 0) mouse->execute();
     
+    // Hash the internal state if requested
+    if (hasher.isEnabled()) hasher.endOfFrame();
+    
     // Take a snapshot once in a while
     if (autoSaveSnapshots && frame % (vic.getFramesPerSecond() * autoSaveInterval) == 0) {
         takeAutoSnapshot();
     }
     
+#ifdef VC64_PROFILE
+    profiler.endFrame();
+#endif
+    
     // Count some sheep (zzzzzz) ...
     if (!getWarp()) {
             synchronizeTiming();
     }
+    
+#ifdef VC64_PROFILE
+    profiler.beginFrame();
+#endif
 }
 
 //
@@ -677,10 +729,7 @@ C64::setWarpLoad(bool b)
 void
 C64::restartTimer()
 {
-    uint64_t kernelNow = mach_absolute_time();
-    uint64_t nanoNow = abs_to_nanos(kernelNow);
-    
-    nanoTargetTime = nanoNow + vic.getFrameDelay();
+    nanoTargetTime = nanos() + vic.getFrameDelay();
 }
 
 void
@@ -688,11 +737,8 @@ C64::synchronizeTiming()
 {
     const uint64_t earlyWakeup = 1500000; /* 1.5 milliseconds */
     
-    // Convert usec into kernel unit
-    int64_t kernelTargetTime = nanos_to_abs(nanoTargetTime);
-    
     // Check how long we're supposed to sleep
-    int64_t timediff = kernelTargetTime - (int64_t)mach_absolute_time();
+    int64_t timediff = (int64_t)nanoTargetTime - (int64_t)nanos();
     if (timediff > 200000000 /* 0.2 sec */) {
         
         // The emulator seems to be out of sync, so we better reset the synchronization timer
@@ -703,9 +749,12 @@ C64::synchronizeTiming()
     }
     
     // Sleep and update target timer
-    // debug(2, "%p Sleeping for %lld\n", this, kernelTargetTime - mach_absolute_time());
-    int64_t jitter = sleepUntil(kernelTargetTime, earlyWakeup);
+    // debug(2, "%p Sleeping for %lld\n", this, nanoTargetTime - nanos());
+    int64_t jitter = sleepUntil(nanoTargetTime, earlyWakeup);
     nanoTargetTime += vic.getFrameDelay();
+#ifdef VC64_PROFILE
+    profiler.recordSyncJitter(jitter);
+#endif
     
     // debug(2, "Jitter = %d", jitter);
     if (jitter > 1000000000 /* 1 sec */) {
@@ -780,7 +829,7 @@ void C64::loadFromSnapshotUnsafe(Snapshot *snapshot)
     uint8_t *ptr;
     
     if (snapshot && (ptr = snapshot->getData())) {
-        loadFromBuffer(&ptr);
+        loadFromBuffer(&ptr, snapshot->getFormat());
         keyboard.releaseAll(); // Avoid constantly pressed keys
         ping();
     }
@@ -799,10 +848,12 @@ C64::loadFromSnapshotSafe(Snapshot *snapshot)
 bool
 C64::restoreAutoSnapshot(unsigned nr)
 {
-    if (autoSnapshot(nr)->isEmpty())
+    Snapshot *snapshot = autoSnapshot(nr);
+    
+    if (snapshot == NULL)
         return false;
     
-    loadFromSnapshotSafe(autoSnapshot(nr));
+    loadFromSnapshotSafe(snapshot);
     return true;
 }
 
@@ -816,6 +867,23 @@ C64::restoreLatestAutoSnapshot()
     return true;
 }
 
+bool
+C64::rewind(unsigned seconds)
+{
+    // Keep the emulator thread from recording while the state is looked up
+    suspend();
+    
+    uint64_t frames = (uint64_t)seconds * vic.getFramesPerSecond();
+    int nr = (frame >= frames) ? rewindBuffer.lookup(frame - frames) : -1;
+    Snapshot *snapshot = (nr >= 0) ? autoSnapshot(nr) : NULL;
+    
+    if (snapshot)
+        loadFromSnapshotUnsafe(snapshot);
+    
+    resume();
+    return snapshot != NULL;
+}
+
 bool
 C64::restoreUserSnapshot(unsigned nr)
 {
@@ -840,10 +908,17 @@ C64::saveToSnapshotUnsafe(Snapshot *snapshot)
     
     snapshot->setCapacity(stateSize());
     snapshot->setTimestamp(time(NULL));
-    snapshot->takeScreenshot((uint32_t *)vic.screenBuffer(), isPAL());
+    if (vic.getPaletteIndexMode()) {
+        uint32_t *screen = new uint32_t[PAL_RASTERLINES * NTSC_PIXELS];
+        vic.screenBufferToRGBA(screen);
+        snapshot->takeScreenshot(screen, isPAL());
+        delete[] screen;
+    } else {
+        snapshot->takeScreenshot((uint32_t *)vic.screenBuffer(), isPAL());
+    }
 
     uint8_t *ptr = snapshot->getData();
-    saveToBuffer(&ptr);
+    saveToBuffer(&ptr, PORTABLE_SNAPSHOT);
 }
 
 void
@@ -876,44 +951,56 @@ C64::takeSnapshotSafe()
     return snapshot;
 }
 
-unsigned
-C64::numAutoSnapshots()
+void
+C64::convertSnapshot(Snapshot *snapshot, SnapshotFormat format)
 {
-    unsigned result;
+    if (snapshot == NULL || snapshot->isEmpty() || snapshot->getFormat() == format)
+        return;
     
-    for (result = 0; result < MAX_AUTO_SAVED_SNAPSHOTS; result++) {
-        if (autoSavedSnapshots[result]->isEmpty())
-            break;
-    }
+    debug(2, "Converting snapshot to %s format\n",
+          format == NATIVE_SNAPSHOT ? "native" : "portable");
     
-    return result;
+    suspend();
+    
+    // Save the current state
+    uint8_t *backup = new uint8_t[stateSize()];
+    uint8_t *ptr = backup;
+    saveToBuffer(&ptr, NATIVE_SNAPSHOT);
+    
+    // Run the snapshot through the emulator
+    ptr = snapshot->getData();
+    loadFromBuffer(&ptr, snapshot->getFormat());
+    assert(stateSize() == snapshot->getDataSize());
+    ptr = snapshot->getData();
+    saveToBuffer(&ptr, format);
+    snapshot->setFormat(format);
+    
+    // Restore the current state
+    ptr = backup;
+    loadFromBuffer(&ptr, NATIVE_SNAPSHOT);
+    delete[] backup;
+    
+    resume();
+}
+
+unsigned
+C64::numAutoSnapshots()
+{
+    return rewindBuffer.numEntries();
 }
 
 void
 C64::takeAutoSnapshot()
 {
-    Snapshot *last = autoSavedSnapshots[MAX_AUTO_SAVED_SNAPSHOTS - 1];
-    
-    // Shuffle slots
-    for (unsigned i = MAX_AUTO_SAVED_SNAPSHOTS - 1; i > 0; i--)
-        autoSavedSnapshots[i] = autoSavedSnapshots[i - 1];
-    autoSavedSnapshots[0] = last;
-    
-    // Save state
-    saveToSnapshotUnsafe(autoSavedSnapshots[0]);
+    PROFILE_SCOPE(profiler, PROF_SNAPSHOT);
+    rewindBuffer.record();
     putMessage(MSG_SNAPSHOT_TAKEN);
 }
 
 void
 C64::deleteAutoSnapshot(unsigned index)
 {
-    Snapshot *first = autoSavedSnapshots[index];
-    first->dealloc();
-    
-    // Shuffle slots
-    for (unsigned i = index; i < MAX_AUTO_SAVED_SNAPSHOTS - 1; i++)
-        autoSavedSnapshots[i] = autoSavedSnapshots[i + 1];
-    autoSavedSnapshots[MAX_AUTO_SAVED_SNAPSHOTS - 1] = first;
+    rewindBuffer.discardLatest(index + 1);
 }
 
 unsigned
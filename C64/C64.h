@@ -40,7 +40,7 @@
 // Snapshot version number of this release
 #define V_MAJOR 1
 #define V_MINOR 11
-#define V_SUBMINOR 0
+#define V_SUBMINOR 1
 
 // Disables assert checking in relase version
 // #define NDEBUG
@@ -53,6 +53,9 @@
 
 // Loading and saving
 #include "Snapshot.h"
+#include "RewindBuffer.h"
+#include "HostProfiler.h"
+#include "StateHasher.h"
 #include "T64Archive.h"
 #include "D64Archive.h"
 #include "G64Archive.h"
@@ -86,6 +89,8 @@
 // Peripherals
 #include "VC1541.h"
 #include "Datasette.h"
+#include "VirtualDrive.h"
+#include "Movie.h"
 #include "Mouse1350.h"
 #include "Mouse1351.h"
 #include "NeosMouse.h"
@@ -192,6 +197,29 @@ It has the same effect as switching a real C64 off and on again. Note that a
  */
 
 
+/*! @brief    Event slots of the component scheduler
+ *  @details  Each slot belongs to a component that is not executed in every cycle.
+ *            Instead, the component registers the next cycle in which it needs attention.
+ *            Slots are processed in the order listed here. The first group is serviced
+ *            before the CPU executes, the second group afterwards. The VIAs have no slot
+ *            of their own. They are clocked by the VC1541 which sleeps as a whole.
+ */
+typedef enum {
+    
+    // Executed before the CPU (o2 low phase)
+    EVENT_INPUT = 0,
+    EVENT_CIA1,
+    EVENT_CIA2,
+    EVENT_VC1541,
+    
+    // Executed after the CPU
+    EVENT_DATASETTE,
+    
+    EVENT_SLOTS
+    
+} EventSlot;
+
+
 //! @class    A complete virtual C64
 class C64 : public VirtualComponent {
 
@@ -216,21 +244,9 @@ public:
     //! @brief    The C64s first versatile interface adapter
     CIA1 cia1;
     
-    //! @brief    Wakeup cycle for CIA1
-    uint64_t wakeUpCycleCIA1;
-    
-    //! @brief    Number of skipped executions of CIA1
-    uint64_t idleCounterCIA1;
-    
     //! @brief    The C64s second versatile interface adapter
     CIA2 cia2;
 
-    //! @brief    Wakeup cycle for CIA2
-    uint64_t wakeUpCycleCIA2;
-
-    //! @brief    Number of skipped executions of CIA2
-    uint64_t idleCounterCIA2;
-
     //! @brief    Sound chip
     SIDBridge sid;
     
@@ -243,6 +259,9 @@ public:
     //! @brief    Control port 2
     ControlPort port2 = ControlPort(2);
 
+    //! @brief    Input recorder and player
+    Movie movie;
+
     //! @brief    Bus interface for connecting the VC1541 drive
     IEC iec;
 
@@ -255,6 +274,9 @@ public:
     //! @brief    Commodore 1530 (C2N) Datasette
     Datasette datasette;
 
+    //! @brief    Kernal level emulation of device 8 (fast LOAD and SAVE)
+    VirtualDrive virtualDrive;
+
     //! @brief    Commodore Mouse 1350
     Mouse1350 mouse1350;
 
@@ -296,6 +318,23 @@ public:
     uint8_t rasterlineCycle;
 
 private:
+    
+    //
+    // Event scheduler
+    //
+    
+    /*! @brief    Wake-up cycle of each event slot
+     *  @details  A component is executed in every cycle that is greater or equal to
+     *            its wake-up cycle. Hence, 0 means "execute in every cycle" and
+     *            UINT64_MAX means "sleep until rescheduled".
+     */
+    uint64_t wakeUpCycle[EVENT_SLOTS];
+    
+    /*! @brief    Earliest wake-up cycle of all event slots
+     *  @details  As long as the current cycle is smaller, no scheduled component needs
+     *            to be looked at. This keeps the per-cycle overhead at a single comparison.
+     */
+    uint64_t nextWakeUpCycle;
 
     //
     // Execution thread
@@ -304,11 +343,6 @@ private:
     //! @brief    The emulators execution thread
     pthread_t p;
     
-    /*! @brief    System timer information
-     *  @details  Used to put the emulation thread to sleep for the proper amount of time
-     */
-    mach_timebase_info_data_t timebase;
-    
     /*! @brief    Wake-up time of the synchronization timer in nanoseconds
      *  @details  This value is recomputed each time the emulator thread is put to sleep
      */
@@ -358,13 +392,16 @@ public:
     //! @brief    Time in seconds between two auto-saved snapshots
     unsigned autoSaveInterval;
     
-private:
-    
-    //! @brief    Maximum number of auto-taken snapshots
-    #define MAX_AUTO_SAVED_SNAPSHOTS 16
-
     //! @brief    Storage for auto-taken snapshots
-    Snapshot *autoSavedSnapshots[MAX_AUTO_SAVED_SNAPSHOTS];
+    RewindBuffer rewindBuffer;
+    
+    //! @brief    Host time measurements (only collected if built with VC64_PROFILE)
+    HostProfiler profiler;
+    
+    //! @brief    Per-frame state hashes for validating the emulator against a reference run
+    StateHasher hasher;
+    
+private:
     
     //! @brief    Maximum number of user-taken snapshots
     #define MAX_USER_SAVED_SNAPSHOTS 32
@@ -510,11 +547,24 @@ public:
     //! @brief    Executes until the end of the rasterline
     bool executeOneLine();
     
+    /*! @brief    Executes until the end of the current frame
+     *  @details  This method is meant for running the emulator without an execution thread,
+     *            e.g., in a headless batch environment. Timing synchronization takes place
+     *            as usual, unless warp mode is enabled.
+     */
+    bool executeOneFrame();
+    
 private:
     
     //! @brief    Executes virtual C64 for one cycle
     bool executeOneCycle();
     
+    //! @brief    Executes all scheduled components that are due before the CPU
+    void executeEventsBeforeCPU();
+    
+    //! @brief    Executes all scheduled components that are due after the CPU
+    void executeEventsAfterCPU();
+    
     //! @brief    Invoked before executing the first cycle of rasterline
     void beginOfRasterline();
     
@@ -525,16 +575,11 @@ private:
     void endOfFrame();
 
     
+    
     //
     //! @functiongroup Managing the execution thread
     //
     
-    //! @brief    Converts kernel time to nanoseconds
-    uint64_t abs_to_nanos(uint64_t abs) { return abs * timebase.numer / timebase.denom; }
-    
-    //! @brief    Converts nanoseconds to kernel time
-    uint64_t nanos_to_abs(uint64_t nanos) { return nanos * timebase.denom / timebase.numer; }
-    
 public:
     
     //! @brief    Returns true iff cpu runs at maximum speed (timing sychronization is disabled).
@@ -565,6 +610,26 @@ public:
     void synchronizeTiming();
     
     
+    //
+    //! @functiongroup Scheduling components
+    //
+    
+    //! @brief    Returns the wake-up cycle of an event slot.
+    uint64_t getWakeUpCycle(EventSlot slot) { return wakeUpCycle[slot]; }
+    
+    /*! @brief    Requests execution of a component in the specified cycle
+     *  @details  The component is executed in this cycle and in all subsequent cycles
+     *            until it reschedules itself.
+     */
+    void scheduleEvent(EventSlot slot, uint64_t cycle) {
+        wakeUpCycle[slot] = cycle;
+        if (cycle < nextWakeUpCycle) nextWakeUpCycle = cycle;
+    }
+    
+    //! @brief    Puts a component to sleep until it is rescheduled.
+    void cancelEvent(EventSlot slot) { wakeUpCycle[slot] = UINT64_MAX; }
+    
+    
     //
     //! @functiongroup Accessing cycle, rasterline, and frame information
     //
@@ -625,6 +690,13 @@ public:
      */
     bool restoreLatestAutoSnapshot();
 
+    /*! @brief    Reverts the emulator state by a certain amount of time
+     *  @details  Restores the latest auto-saved snapshot that has been taken at least
+     *            the specified number of seconds (emulated time) ago.
+     *  @return   false, if the history does not reach back far enough
+     */
+    bool rewind(unsigned seconds);
+
     //! @brief    Restores a snapshot from the user storage
     bool restoreUserSnapshot(unsigned nr);
 
@@ -654,23 +726,37 @@ public:
      *  @seealso  saveToSnapshotUnsafe
      */
     Snapshot *takeSnapshotSafe();
+    
+    /*! @brief    Converts the internal state data of a snapshot into another format
+     *  @details  The snapshot is loaded into the emulator and saved again in the
+     *            requested format. The current state is restored afterwards. Use this
+     *            function to export a snapshot in native format, e.g., one taken from
+     *            the rewind buffer.
+     *  @note     Use this function outside the execution thread.
+     */
+    void convertSnapshot(Snapshot *snapshot, SnapshotFormat format);
 
     //! @brief    Returns the number of auto-saved snapshots
     unsigned numAutoSnapshots();
     
-    //! @brief    Returns an auto-saved snapshot
-    Snapshot *autoSnapshot(unsigned nr) { return autoSavedSnapshots[nr]; }
+    /*! @brief    Returns an auto-saved snapshot
+     *  @details  The snapshot is reconstructed from the rewind buffer. The returned
+     *            object is only valid until this function is called again.
+     *  @return   NULL, if no such snapshot exists
+     */
+    Snapshot *autoSnapshot(unsigned nr) { return rewindBuffer.snapshot(nr); }
     
     /*! @brief    Takes a snapshot and inserts it into the auto-save storage
      *  @details  The new snapshot is inserted at position 0 and all others are moved
-     *            one position up. If the buffer is full, the oldest snapshot is deleted.
+     *            one position up. If the buffer is full, the oldest snapshots are deleted.
      *  @note     This function does not halt the emulator and must therefore be
      *            called inside the execution thread, only.
      */
     void takeAutoSnapshot();
     
     /*! @brief    Deletes a snapshot from the auto-save storage
-     *  @details  All snapshots that follow are moved one position down.
+     *  @details  Because auto-saved snapshots are stored as deltas, all snapshots
+     *            taken after the specified one are deleted, too.
      */
     void deleteAutoSnapshot(unsigned nr);
     
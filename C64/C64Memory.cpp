@@ -31,6 +31,12 @@ C64Memory::C64Memory()
 	charRomFile = NULL;
 	kernalRomFile = NULL;
 	basicRomFile = NULL;
+    memset(peekPage, 0, sizeof(peekPage));
+    memset(pokePage, 0, sizeof(pokePage));
+    memset(watchedPage, 0, sizeof(watchedPage));
+    memset(&hit, 0, sizeof(hit));
+    hit.nr = -1;
+    numWatchpoints = 0;
     
     // Register snapshot items
     SnapshotItem items[] = {
@@ -87,6 +93,8 @@ C64Memory::reset()
     for (unsigned i = 0x1; i <= 0xF; i++)
         pokeTarget[i] = M_RAM;
     pokeTarget[0x0] = M_PP;
+    
+    updatePageTables();
 }
 
 
@@ -109,6 +117,13 @@ C64Memory::dumpState()
         if (c64->cpu.softBreakpoint(addr))
             msg("Soft breakpoint at %04X\n", addr);
 	}
+    for (unsigned nr = 0; nr < numWatchpoints; nr++) {
+        Watchpoint &w = watchpoints[nr];
+        msg("Watchpoint %d: %04X - %04X (%s%s%s)\n", nr, w.from, w.to,
+            (w.type & WATCH_READ) ? "r" : "-",
+            (w.type & WATCH_WRITE) ? "w" : "-",
+            (w.type & WATCH_EXECUTE) ? "x" : "-");
+    }
     
 	msg("\n");
 }
@@ -258,6 +273,74 @@ C64Memory::updatePeekPokeLookupTables()
     MemorySource target;
     target = BankMap[index][4]; // 0xD000 - 0xDFFF (I/O or RAM)
     pokeTarget[0xD] = (target == M_IO ? M_IO : M_RAM);
+    
+    updatePageTables();
+}
+
+void
+C64Memory::updatePageTables()
+{
+    for (unsigned bank = 0; bank < 16; bank++) {
+        
+        uint16_t addr = bank << 12;
+        uint8_t *peekBase, *pokeBase;
+        
+        switch (peekSrc[bank]) {
+                
+            case M_RAM:
+            case M_NONE:
+            case M_PP:
+                peekBase = ram + addr;
+                break;
+                
+            case M_ROM:
+                peekBase = rom + addr;
+                break;
+                
+            case M_CRTLO:
+            case M_CRTHI:
+                // Cartridge chips are blended in with a granularity of 4 KB
+                peekBase = c64->expansionport.romPage(bank << 4);
+                break;
+                
+            default:
+                peekBase = NULL;
+        }
+        
+        switch (pokeTarget[bank]) {
+                
+            case M_RAM:
+            case M_PP:
+                pokeBase = ram + addr;
+                break;
+                
+            default:
+                pokeBase = NULL;
+        }
+        
+        // Skip banks that have not changed (the last page of a bank is never special)
+        unsigned last = (bank << 4) | 0xF;
+        if (peekPage[last] != (peekBase ? peekBase + 0xF00 : NULL)) {
+            for (unsigned i = 0; i < 16; i++)
+                peekPage[(bank << 4) | i] = peekBase ? peekBase + (i << 8) : NULL;
+        }
+        if (pokePage[last] != (pokeBase ? pokeBase + 0xF00 : NULL)) {
+            for (unsigned i = 0; i < 16; i++)
+                pokePage[(bank << 4) | i] = pokeBase ? pokeBase + (i << 8) : NULL;
+        }
+    }
+    
+    // The processor port registers are located in the first page
+    if (peekSrc[0x0] == M_PP) peekPage[0] = NULL;
+    if (pokeTarget[0x0] == M_PP) pokePage[0] = NULL;
+    
+    // Watched pages are handled by the slow path
+    if (numWatchpoints) {
+        for (unsigned i = 0; i < 256; i++) {
+            if (watchedPage[i] & WATCH_READ) peekPage[i] = NULL;
+            if (watchedPage[i] & WATCH_WRITE) pokePage[i] = NULL;
+        }
+    }
 }
 
 
@@ -361,8 +444,23 @@ uint8_t C64Memory::spyIO(uint16_t addr)
 
 uint8_t C64Memory::peek(uint16_t addr)
 {
-    MemorySource src = peekSrc[addr >> 12];
+    uint8_t *page = peekPage[addr >> 8];
     
+    if (page)
+        return page[addr & 0xFF];
+    
+    if (watchedPage[addr >> 8] & WATCH_READ) {
+        uint8_t value = peek(addr, peekSrc[addr >> 12]);
+        if (checkWatchpoints(addr, value, WATCH_READ))
+            c64->cpu.signalWatchpoint();
+        return value;
+    }
+    
+    return peek(addr, peekSrc[addr >> 12]);
+}
+
+uint8_t C64Memory::peek(uint16_t addr, MemorySource src)
+{
     switch(src) {
             
         case M_RAM:
@@ -507,6 +605,18 @@ void C64Memory::pokeIO(uint16_t addr, uint8_t value)
 
 void C64Memory::poke(uint16_t addr, uint8_t value)
 {	
+    uint8_t *page = pokePage[addr >> 8];
+    
+    if (page) {
+        page[addr & 0xFF] = value;
+        return;
+    }
+    
+    if (watchedPage[addr >> 8] & WATCH_WRITE) {
+        if (checkWatchpoints(addr, value, WATCH_WRITE))
+            c64->cpu.signalWatchpoint();
+    }
+    
 	MemorySource target = pokeTarget[addr >> 12];
 	    
 	switch(target) {
@@ -568,3 +678,120 @@ C64Memory::pokeTo(uint16_t addr, uint8_t value, MemorySource target)
     }
 }
 
+
+// --------------------------------------------------------------------------------
+//                                    Watchpoints
+// --------------------------------------------------------------------------------
+
+int
+C64Memory::addWatchpoint(Watchpoint watchpoint)
+{
+    if (numWatchpoints == maxWatchpoints) {
+        warn("Cannot add more than %d watchpoints\n", maxWatchpoints);
+        return -1;
+    }
+    if (watchpoint.from > watchpoint.to) {
+        warn("Invalid watchpoint range %04X - %04X\n", watchpoint.from, watchpoint.to);
+        return -1;
+    }
+    
+    watchpoints[numWatchpoints++] = watchpoint;
+    updateWatchedPages();
+    return numWatchpoints - 1;
+}
+
+void
+C64Memory::removeWatchpoint(unsigned nr)
+{
+    assert(nr < numWatchpoints);
+    
+    for (unsigned i = nr; i + 1 < numWatchpoints; i++) {
+        watchpoints[i] = watchpoints[i + 1];
+    }
+    numWatchpoints--;
+    updateWatchedPages();
+}
+
+void
+C64Memory::removeAllWatchpoints()
+{
+    numWatchpoints = 0;
+    updateWatchedPages();
+}
+
+void
+C64Memory::updateWatchedPages()
+{
+    // Remove all execution tags
+    for (unsigned addr = 0; addr <= 0xFFFF; addr++) {
+        c64->cpu.deleteWatchpointTag(addr);
+    }
+    memset(watchedPage, 0, sizeof(watchedPage));
+    
+    for (unsigned nr = 0; nr < numWatchpoints; nr++) {
+        
+        Watchpoint &w = watchpoints[nr];
+        
+        for (unsigned page = w.from >> 8; page <= (unsigned)(w.to >> 8); page++) {
+            watchedPage[page] |= w.type & (WATCH_READ | WATCH_WRITE);
+        }
+        if (w.type & WATCH_EXECUTE) {
+            for (unsigned addr = w.from; addr <= w.to; addr++) {
+                c64->cpu.setWatchpointTag(addr);
+            }
+        }
+    }
+    
+    // Rebuild the page tables from scratch
+    memset(peekPage, 0, sizeof(peekPage));
+    memset(pokePage, 0, sizeof(pokePage));
+    updatePageTables();
+}
+
+bool
+C64Memory::checkWatchpoints(uint16_t addr, uint8_t value, WatchType type)
+{
+    for (unsigned nr = 0; nr < numWatchpoints; nr++) {
+        
+        Watchpoint &w = watchpoints[nr];
+        
+        if (!(w.type & type) || addr < w.from || addr > w.to)
+            continue;
+        
+        uint16_t operand;
+        switch (w.operand) {
+            case OPERAND_VALUE: operand = value; break;
+            case OPERAND_A:     operand = c64->cpu.getA(); break;
+            case OPERAND_X:     operand = c64->cpu.getX(); break;
+            case OPERAND_Y:     operand = c64->cpu.getY(); break;
+            case OPERAND_SP:    operand = c64->cpu.getSP(); break;
+            case OPERAND_P:     operand = c64->cpu.getP(); break;
+            case OPERAND_PC:    operand = c64->cpu.getPC_at_cycle_0(); break;
+            default:            assert(false); operand = 0;
+        }
+        
+        bool result;
+        switch (w.condition) {
+            case COND_ALWAYS:     result = true; break;
+            case COND_EQUAL:      result = operand == w.value; break;
+            case COND_NOT_EQUAL:  result = operand != w.value; break;
+            case COND_LESS:       result = operand < w.value; break;
+            case COND_GREATER:    result = operand > w.value; break;
+            case COND_BITS_SET:   result = (operand & w.value) == w.value; break;
+            case COND_BITS_CLEAR: result = (operand & w.value) == 0; break;
+            default:              assert(false); result = false;
+        }
+        
+        if (result) {
+            hit.nr = nr;
+            hit.type = type;
+            hit.addr = addr;
+            hit.value = value;
+            hit.pc = c64->cpu.getPC_at_cycle_0();
+            debug(2, "Watchpoint %d triggered at %04X (value %02X, PC %04X)\n",
+                  nr, addr, value, hit.pc);
+            return true;
+        }
+    }
+    return false;
+}
@@ -189,10 +189,54 @@ private:
     //! @brief    Lookup table for poke()
     MemorySource pokeTarget[16];
     
+    /*! @brief    Page table for peek()
+     *  @details  Each entry refers to a 256 byte memory page and points to the memory cell
+     *            that shows up at the beginning of the page. RAM, ROM, and cartridge ROM pages
+     *            are read directly from this table. Pages that cannot be accessed without side
+     *            effects (I/O space, processor port) are marked with NULL and handled by the
+     *            lookup table above.
+     */
+    uint8_t *peekPage[256];
+    
+    //! @brief    Page table for poke()
+    uint8_t *pokePage[256];
+    
+    //! @brief    Rebuilds both page tables from the peek and poke lookup tables
+    void updatePageTables();
+    
+public:
+    
+    //! @brief    Maximum number of watchpoints
+    static const unsigned maxWatchpoints = 16;
+    
+private:
+    
+    //! @brief    Active watchpoints
+    Watchpoint watchpoints[maxWatchpoints];
+    
+    //! @brief    Number of active watchpoints
+    unsigned numWatchpoints;
+    
+    /*! @brief    Watched accesses per memory page
+     *  @details  Each entry is a combination of WATCH_READ and WATCH_WRITE. The page tables
+     *            contain NULL for all watched pages. Hence, accesses to unwatched pages run
+     *            through the fast path without any additional check. For all other accesses,
+     *            a single lookup in this table decides if the watchpoints need to be checked.
+     */
+    uint8_t watchedPage[256];
+    
+    //! @brief    Most recently triggered watchpoint
+    WatchpointHit hit;
+    
+    //! @brief    Recomputes watchedPage and the execution tags of the CPU
+    void updateWatchedPages();
+    
 public:
     
     /*! @brief    Updates the peek and poke lookup tables.
-     *  @details  The lookup values depend on three processor port bits and the cartridge exrom and game lines 
+     *  @details  The lookup values depend on three processor port bits and the cartridge exrom and game lines.
+     *            The page tables are rebuilt, too. Hence, this function needs to be called whenever the
+     *            cartridge banks in or banks out a ROM chip.
      */
     void updatePeekPokeLookupTables();
 
@@ -200,6 +244,7 @@ public:
     MemorySource peekSource(uint16_t addr) { return peekSrc[addr >> 12]; }
     
     uint8_t peek(uint16_t addr);
+    uint8_t peek(uint16_t addr, MemorySource src);
     uint8_t peekIO(uint16_t addr);
     
     uint8_t spy(uint16_t addr);
@@ -225,6 +270,38 @@ public:
     /*! @details  This method is only used by the debugger only.
      */
     void pokeTo(uint16_t addr, uint8_t value, MemorySource target);
+    
+    
+    //
+    //! @functiongroup Managing watchpoints
+    //
+    
+    /*! @brief    Adds a watchpoint
+     *  @return   Number of the new watchpoint or -1, if no more watchpoints can be added
+     */
+    int addWatchpoint(Watchpoint watchpoint);
+    
+    //! @brief    Removes a watchpoint. Higher numbers move down by one.
+    void removeWatchpoint(unsigned nr);
+    
+    //! @brief    Removes all watchpoints
+    void removeAllWatchpoints();
+    
+    //! @brief    Returns the number of active watchpoints
+    unsigned getNumWatchpoints() { return numWatchpoints; }
+    
+    //! @brief    Returns a watchpoint
+    Watchpoint getWatchpoint(unsigned nr) { assert(nr < numWatchpoints); return watchpoints[nr]; }
+    
+    //! @brief    Returns information about the most recently triggered watchpoint
+    WatchpointHit getWatchpointHit() { return hit; }
+    
+    /*! @brief    Checks all watchpoints covering a memory access
+     *  @details  If a watchpoint triggers, it is recorded as the most recent hit.
+     *  @param    value  Value that is read or written (the opcode for WATCH_EXECUTE)
+     *  @return   true, if a watchpoint has triggered
+     */
+    bool checkWatchpoints(uint16_t addr, uint8_t value, WatchType type);
 };
 
 #endif
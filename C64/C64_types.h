@@ -11,6 +11,8 @@
 #include "Cartridge_types.h"
 #include "ControlPort_types.h"
 #include "Mouse_types.h"
+#include "HostProfiler_types.h"
+#include "Movie_types.h"
 
 /*! @brief    Color schemes
  *  @details  Predefined RGB color values
@@ -30,6 +32,17 @@ typedef enum {
     GRAYSCALE       = 0x0B
 } ColorScheme;
 
+/*! @brief    Render policies
+ *  @details  Determine which frames are drawn by the pixel engine. In all other frames,
+ *            only the information needed for collision detection is computed.
+ */
+typedef enum {
+    RENDER_ALL_FRAMES   = 0x00,
+    RENDER_EVERY_NTH    = 0x01,
+    RENDER_ON_DEMAND    = 0x02,
+    RENDER_NO_FRAMES    = 0x03
+} RenderPolicy;
+
 /*! @brief    Message types
  *  @details  List of all possible message id's
  */
@@ -55,6 +68,7 @@ typedef enum {
     MSG_CPU_SOFT_BREAKPOINT_REACHED,
     MSG_CPU_HARD_BREAKPOINT_REACHED,
     MSG_CPU_ILLEGAL_INSTRUCTION,
+    MSG_CPU_WATCHPOINT_REACHED,
     MSG_WARP_ON,
     MSG_WARP_OFF,
     MSG_ALWAYS_WARP_ON,
@@ -91,7 +105,13 @@ typedef enum {
 
     // Peripherals (Expansion port)
     MSG_CARTRIDGE,
-    MSG_NO_CARTRIDGE
+    MSG_NO_CARTRIDGE,
+
+    // Host time profiler (instrumented builds only)
+    MSG_PROFILE,
+
+    // Determinism checks
+    MSG_STATE_DIVERGED
 
 } VC64Message;
 
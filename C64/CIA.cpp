@@ -52,6 +52,8 @@ CIA::CIA()
         { &CNT,             sizeof(CNT),            CLEAR_ON_RESET },
         { &INT,             sizeof(INT),            CLEAR_ON_RESET },
         { &tiredness,       sizeof(tiredness),      CLEAR_ON_RESET },
+        { &sleeping,        sizeof(sleeping),       CLEAR_ON_RESET },
+        { &sleepCycle,      sizeof(sleepCycle),     CLEAR_ON_RESET },
         { NULL,             0,                      0 }};
 
     registerSnapshotItems(items, sizeof(items));
@@ -99,7 +101,7 @@ CIA::peek(uint16_t addr)
 {
 	uint8_t result;
 
-    wakeUp();
+    wakeUp(c64->cycle);
 
     assert(addr <= 0x000F);
 	switch(addr) {
@@ -281,7 +283,7 @@ CIA::spy(uint16_t addr)
 
 void CIA::poke(uint16_t addr, uint8_t value)
 {
-    wakeUp();
+    wakeUp(c64->cycle);
     
 	switch(addr) {
 		
@@ -577,7 +579,8 @@ void CIA::poke(uint16_t addr, uint8_t value)
 void
 CIA::incrementTOD()
 {
-    wakeUp();
+    // Called at the end of a frame. The cycle counter has already been advanced.
+    wakeUp(c64->cycle - 1);
     tod.increment();
 }
 
@@ -684,7 +687,7 @@ CIA::getInfo()
 void
 CIA::executeOneCycle()
 {
-    wakeUp();
+    wakeUp(c64->cycle - 1);
     
     uint64_t oldDelay = delay;
     uint64_t oldFeed  = feed;
@@ -997,7 +1000,7 @@ CIA::executeOneCycle()
 void
 CIA::sleep()
 {
-    assert(idleCounter() == 0);
+    assert(!sleeping);
     
     // Determine maximum possible sleep cycles based on timer counts
     uint64_t sleepA = (counterA > 2) ? (c64->cycle + counterA - 1) : 0;
@@ -1007,16 +1010,20 @@ CIA::sleep()
     if (!(feed & CountA0)) sleepA = UINT64_MAX;
     if (!(feed & CountB0)) sleepB = UINT64_MAX;
     
+    sleeping = true;
+    sleepCycle = c64->cycle;
     setWakeUpCycle(MIN(sleepA, sleepB));
 }
 
 void
-CIA::wakeUp()
+CIA::wakeUp(uint64_t lastCycle)
 {
-    uint64_t idleCycles = idleCounter();
-    
     // Make up for missed cycles
-    if (idleCycles) {
+    if (sleeping) {
+        
+        assert(lastCycle >= sleepCycle);
+        uint64_t idleCycles = lastCycle - sleepCycle;
+        
         if (feed & CountA0) {
             assert(counterA >= idleCycles);
             counterA -= idleCycles;
@@ -1025,11 +1032,17 @@ CIA::wakeUp()
             assert(counterB >= idleCycles);
             counterB -= idleCycles;
         }
-        resetIdleCounter();
+        sleeping = false;
     }
     setWakeUpCycle(0);
 }
 
+uint64_t
+CIA::idleCounter()
+{
+    return sleeping ? c64->cycle - 1 - sleepCycle : 0;
+}
+
 
 // -----------------------------------------------------------------------------------------
 // Complex Interface Adapter 1
@@ -1171,10 +1184,8 @@ CIA1::updatePB()
         c64->neosMouse.risingStrobe(1 /* Port */);
 }
 
-uint64_t CIA1::wakeUpCycle() { return c64->wakeUpCycleCIA1; }
-void CIA1::setWakeUpCycle(uint64_t cycle) { c64->wakeUpCycleCIA1 = cycle; }
-uint64_t CIA1::idleCounter() { return c64->idleCounterCIA1; }
-void CIA1::resetIdleCounter() { c64->idleCounterCIA1 = 0; }
+uint64_t CIA1::wakeUpCycle() { return c64->getWakeUpCycle(EVENT_CIA1); }
+void CIA1::setWakeUpCycle(uint64_t cycle) { c64->scheduleEvent(EVENT_CIA1, cycle); }
 
 
 // -----------------------------------------------------------------------------------------
@@ -1300,7 +1311,5 @@ CIA2::updatePB()
     PB = (portBinternal() & DDRB) | (portBexternal() & ~DDRB);
 }
 
-uint64_t CIA2::wakeUpCycle() { return c64->wakeUpCycleCIA2; }
-void CIA2::setWakeUpCycle(uint64_t cycle) { c64->wakeUpCycleCIA2 = cycle; }
-uint64_t CIA2::idleCounter() { return c64->idleCounterCIA2; }
-void CIA2::resetIdleCounter() { c64->idleCounterCIA2 = 0; }
+uint64_t CIA2::wakeUpCycle() { return c64->getWakeUpCycle(EVENT_CIA2); }
+void CIA2::setWakeUpCycle(uint64_t cycle) { c64->scheduleEvent(EVENT_CIA2, cycle); }
@@ -233,6 +233,15 @@ public:
      */
     uint8_t tiredness;
     
+    //! @brief    Indicates whether the chip has been put into idle state
+    bool sleeping;
+    
+    /*! @brief    Cycle in which the chip has been put into idle state
+     *  @details  The number of skipped executions is computed from this value when the
+     *            chip wakes up. Hence, no bookkeeping is needed while the chip sleeps.
+     */
+    uint64_t sleepCycle;
+    
     // ------------------------------------------------------------------------------------------
     //                                             Methods
     // ------------------------------------------------------------------------------------------
@@ -368,8 +377,12 @@ private:
     //! @brief    Puts the CIA chip into idle state
     virtual void sleep();
     
-    //! @brief    Emulate all previously skipped cycles
-    virtual void wakeUp();
+    /*! @brief    Emulate all previously skipped cycles
+     *  @param    lastCycle The last cycle to make up for. If the chip is woken up by
+     *            the CPU, this is the current cycle, because the CIA's time slot in this
+     *            cycle has already passed. Otherwise, it is the previous cycle.
+     */
+    virtual void wakeUp(uint64_t lastCycle);
     
     //! @brief    Returns the wake up cycle for this CIA chip
     virtual uint64_t wakeUpCycle() = 0;
@@ -377,11 +390,11 @@ private:
     //! @brief    Sets the wake up cycle for this CIA chip
     virtual void setWakeUpCycle(uint64_t cycle) = 0;
     
-    //! @brief    Returns the number of skipped executions for this CIA chip
-    virtual uint64_t idleCounter() = 0;
-    
-    //! @brief    Resets the skipped execution cycle counter to zero
-    virtual void resetIdleCounter() = 0;
+    /*! @brief    Returns the number of skipped executions for this CIA chip
+     *  @details  The value refers to the last completed cycle, i.e., it is meant to be
+     *            called outside of the execution loop.
+     */
+    uint64_t idleCounter();
 };
 
 
@@ -412,8 +425,6 @@ private:
     
     uint64_t wakeUpCycle();
     void setWakeUpCycle(uint64_t cycle);
-    uint64_t idleCounter();
-    void resetIdleCounter();
     
     
 };
@@ -447,8 +458,6 @@ private:
     
     uint64_t wakeUpCycle();
     void setWakeUpCycle(uint64_t cycle);
-    uint64_t idleCounter();
-    void resetIdleCounter();
 };
 
 #endif
@@ -33,6 +33,7 @@ CPU::CPU()
 	for (int i = 0; i <  65536; i++) {
 		breakpoint[i] = NO_BREAKPOINT;	
 	}
+    watchpointReached = false;
     
     // Register snapshot items
     SnapshotItem items[] = {
@@ -92,6 +93,7 @@ CPU::reset()
     B = 1;
 	rdyLine = true;
 	next = fetch;
+    watchpointReached = false;
 }
 
 void 
@@ -155,6 +157,24 @@ CPU::releaseIrqLine(InterruptSource source)
     write8_delayed(levelDetector, irqLine);
 }
 
+bool
+CPU::interruptsIdle()
+{
+    return
+    !irqLine && !levelDetector.value && !levelDetector.prevValue &&
+    !nmiLine && !edgeDetector.value && !edgeDetector.prevValue &&
+    !doIrq && !doNmi;
+}
+
+void
+CPU::shiftTimeStamps(uint64_t from, uint64_t to, uint64_t offset)
+{
+    if (levelDetector.timeStamp >= from && levelDetector.timeStamp <= to)
+        levelDetector.timeStamp += offset;
+    if (edgeDetector.timeStamp >= from && edgeDetector.timeStamp <= to)
+        edgeDetector.timeStamp += offset;
+}
+
 void
 CPU::setRDY(bool value)
 {
@@ -210,11 +230,30 @@ CPU::getLengthOfInstruction(uint8_t opcode)
 
 DisassembledInstruction
 CPU::disassemble(uint16_t addr, bool hex)
+{
+    TraceRecord record;
+    
+    record.pc = addr;
+    record.bytes[0] = mem->spy(addr);
+    record.bytes[1] = mem->spy(addr + 1);
+    record.bytes[2] = mem->spy(addr + 2);
+    record.a = A;
+    record.x = X;
+    record.y = Y;
+    record.sp = SP;
+    record.p = getP();
+    
+    return disassemble(record, hex);
+}
+
+DisassembledInstruction
+CPU::disassemble(const TraceRecord &record, bool hex)
 {
     DisassembledInstruction instr;
-        
+    uint16_t addr = record.pc;
+    
     // Get opcode
-    uint8_t opcode = mem->spy(addr);
+    uint8_t opcode = record.bytes[0];
     instr.addr = addr; 
     instr.size = getLengthOfInstruction(opcode);
     
@@ -228,7 +267,7 @@ CPU::disassemble(uint16_t addr, bool hex)
         case ADDR_ZERO_PAGE_Y:
         case ADDR_INDIRECT_X:
         case ADDR_INDIRECT_Y: {
-            uint8_t value = mem->spy(addr+1);
+            uint8_t value = record.bytes[1];
             hex ? sprint8x(operand, value) : sprint8d(operand, value);
             break;
         }
@@ -237,12 +276,12 @@ CPU::disassemble(uint16_t addr, bool hex)
         case ADDR_ABSOLUTE:
         case ADDR_ABSOLUTE_X:
         case ADDR_ABSOLUTE_Y: {
-            uint16_t value = LO_HI(mem->spy(addr+1),mem->spy(addr+2));
+            uint16_t value = LO_HI(record.bytes[1], record.bytes[2]);
             hex ? sprint16x(operand, value) : sprint16d(operand, value);
             break;
         }
         case ADDR_RELATIVE: {
-            uint16_t value = addr + 2 + (int8_t)mem->spy(addr+1);
+            uint16_t value = addr + 2 + (int8_t)record.bytes[1];
             hex ? sprint16x(operand, value) : sprint16d(operand, value);
             break;
         }
@@ -310,45 +349,65 @@ CPU::disassemble(uint16_t addr, bool hex)
     
     // Convert register contents to strings
     hex ? sprint16x(instr.pc, addr) : sprint16d(instr.pc, addr);
-    hex ? sprint8x(instr.A, A) : sprint8d(instr.A, A);
-    hex ? sprint8x(instr.X, X) : sprint8d(instr.X, X);
-    hex ? sprint8x(instr.Y, Y) : sprint8d(instr.Y, Y);
-    hex ? sprint8x(instr.SP, SP) : sprint8d(instr.SP, SP);
+    hex ? sprint8x(instr.A, record.a) : sprint8d(instr.A, record.a);
+    hex ? sprint8x(instr.X, record.x) : sprint8d(instr.X, record.x);
+    hex ? sprint8x(instr.Y, record.y) : sprint8d(instr.Y, record.y);
+    hex ? sprint8x(instr.SP, record.sp) : sprint8d(instr.SP, record.sp);
 
     // Convert memory contents to strings
     if (instr.size >= 1) {
-        uint8_t byte = mem->spy(addr);
+        uint8_t byte = record.bytes[0];
         hex ? sprint8x(instr.byte1, byte) : sprint8d(instr.byte1, byte);
     } else {
         hex ? strcpy(instr.byte1, "  ") : strcpy(instr.byte1, "   ");
     }
     if (instr.size >= 2) {
-        uint8_t byte = mem->spy(addr + 1);
+        uint8_t byte = record.bytes[1];
         hex ? sprint8x(instr.byte2, byte) : sprint8d(instr.byte2, byte);
     } else {
         hex ? strcpy(instr.byte2, "  ") : strcpy(instr.byte2, "   ");
     }
     if (instr.size >= 3) {
-        uint8_t byte = mem->spy(addr + 2);
+        uint8_t byte = record.bytes[2];
         hex ? sprint8x(instr.byte3, byte) : sprint8d(instr.byte3, byte);
     } else {
         hex ? strcpy(instr.byte3, "  ") : strcpy(instr.byte3, "   ");
     }
     
     // Convert flags to a string
-    instr.flags[0] = N ? 'N' : 'n';
-    instr.flags[1] = V ? 'V' : 'v';
+    instr.flags[0] = (record.p & N_FLAG) ? 'N' : 'n';
+    instr.flags[1] = (record.p & V_FLAG) ? 'V' : 'v';
     instr.flags[2] = '-';
-    instr.flags[3] = B ? 'B' : 'b';
-    instr.flags[4] = D ? 'D' : 'd';
-    instr.flags[5] = I ? 'I' : 'i';
-    instr.flags[6] = Z ? 'Z' : 'z';
-    instr.flags[7] = C ? 'C' : 'c';
+    instr.flags[3] = (record.p & B_FLAG) ? 'B' : 'b';
+    instr.flags[4] = (record.p & D_FLAG) ? 'D' : 'd';
+    instr.flags[5] = (record.p & I_FLAG) ? 'I' : 'i';
+    instr.flags[6] = (record.p & Z_FLAG) ? 'Z' : 'z';
+    instr.flags[7] = (record.p & C_FLAG) ? 'C' : 'c';
     instr.flags[8] = 0;
     
     return instr;
 }
 
+void
+CPU::recordInstruction(TraceRecordType type)
+{
+    TraceRecord *record = binaryTrace.nextRecord();
+    
+    record->cycle = c64->getCycles();
+    record->pc = PC_at_cycle_0;
+    record->rasterline = c64->getRasterline();
+    record->bytes[0] = mem->spy(PC_at_cycle_0);
+    record->bytes[1] = mem->spy(PC_at_cycle_0 + 1);
+    record->bytes[2] = mem->spy(PC_at_cycle_0 + 2);
+    record->a = A;
+    record->x = X;
+    record->y = Y;
+    record->sp = SP;
+    record->p = getP();
+    record->rasterCycle = c64->getRasterlineCycle();
+    record->type = type;
+}
+
 void 
 CPU::setErrorState(ErrorState state)
 {
@@ -370,6 +429,9 @@ CPU::setErrorState(ErrorState state)
         case CPU_ILLEGAL_INSTRUCTION:
             c64->putMessage(MSG_CPU_ILLEGAL_INSTRUCTION);
             return;
+        case CPU_WATCHPOINT_REACHED:
+            c64->putMessage(MSG_CPU_WATCHPOINT_REACHED);
+            return;
         default:
             assert(false);
     }
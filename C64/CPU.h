@@ -23,6 +23,8 @@
 
 #include "CPU_types.h"
 #include "Memory.h"
+#include "InstructionTrace.h"
+#include "GuestProfiler.h"
 
 /*! @class  The virtual 6502 / 6510 processor
  */
@@ -70,6 +72,19 @@ public:
      */
     CPUChipModel chipModel;
 
+    /*! @brief    Binary instruction trace
+     *  @details  If enabled, a TraceRecord is written for each fetched opcode and each
+     *            interrupt. Unlike the text trace, this is fast enough to record millions
+     *            of instructions.
+     */
+    InstructionTrace binaryTrace;
+
+    /*! @brief    Hot spot profiler
+     *  @details  If enabled, the cycles and instructions executed by the guest program are
+     *            counted per instruction address and per subroutine call.
+     */
+    GuestProfiler guestProfiler;
+
 private:
     
 	//! @brief    Accumulator
@@ -214,6 +229,25 @@ private:
     
 	//! @brief    Breakpoint tag for each memory cell
 	uint8_t breakpoint[65536];
+    
+    /*! @brief    Indicates that a read or write watchpoint has triggered
+     *  @details  The current instruction is completed and the CPU halts at the end of the
+     *            first cycle of the next instruction or interrupt sequence.
+     */
+    bool watchpointReached;
+    
+    /*! @brief    Enters the watchpoint error state if a watchpoint has triggered
+     *  @details  Called after the work of a fetch cycle has been done, so halting does not
+     *            cost an emulated cycle.
+     *  @return   true, if the CPU has to halt
+     */
+    bool haltOnWatchpoint() {
+        if (!watchpointReached) return false;
+        watchpointReached = false;
+        setErrorState(CPU_WATCHPOINT_REACHED);
+        debug(1, "Watchpoint reached\n");
+        return true;
+    }
 	
 #include "Instructions.h"
 		
@@ -399,6 +433,17 @@ public:
      */
     void releaseIrqLine(InterruptSource source);
     
+    /*! @brief    Returns true iff no interrupt is pending
+     *  @details  Both interrupt lines must be high and must have been high in the previous cycle.
+     */
+    bool interruptsIdle();
+    
+    /*! @brief    Moves the time stamps of the interrupt detectors forward
+     *  @details  Time stamps in the range [from, to] are increased by offset. The function is
+     *            used by the VC1541 drive when it skips iterations of the DOS idle loop.
+     */
+    void shiftTimeStamps(uint64_t from, uint64_t to, uint64_t offset);
+    
 	//! @brief    Sets the RDY line.
     void setRDY(bool value);
 		
@@ -441,9 +486,22 @@ public:
                                         
 	//! @brief    Disassembles the current instruction.
     DisassembledInstruction disassemble(bool hex) { return disassemble(PC_at_cycle_0, hex); }
+    
+    /*! @brief    Disassembles an instruction of the binary trace
+     *  @details  Only the record is evaluated. Hence, the function works for recorded traces
+     *            of any CPU instance, even if the memory contents have changed in between.
+     */
+    DisassembledInstruction disassemble(const TraceRecord &record, bool hex);
 				
 	//! @brief    Returns true, iff the next cycle is the first cycle of a command.
     bool atBeginningOfNewCommand() { return next == fetch; }
+    
+private:
+    
+    //! @brief    Writes a record into the binary trace
+    void recordInstruction(TraceRecordType type);
+    
+public:
 	
     
     //
@@ -493,6 +551,21 @@ public:
     
 	//! @brief    Sets or deletes a hard breakpoint at the specified address.
 	void toggleSoftBreakpoint(uint16_t addr) { breakpoint[addr] ^= SOFT_BREAKPOINT; }
+    
+    //! @brief    Sets a ROM trap at the specified address.
+    void setTrap(uint16_t addr) { breakpoint[addr] |= ROM_TRAP; }
+    
+    //! @brief    Deletes a ROM trap at the specified address.
+    void deleteTrap(uint16_t addr) { breakpoint[addr] &= (0xFF - ROM_TRAP); }
+    
+    //! @brief    Tags the specified address as being covered by an execution watchpoint.
+    void setWatchpointTag(uint16_t addr) { breakpoint[addr] |= WATCHPOINT; }
+    
+    //! @brief    Removes the execution watchpoint tag from the specified address.
+    void deleteWatchpointTag(uint16_t addr) { breakpoint[addr] &= (0xFF - WATCHPOINT); }
+    
+    //! @brief    Requests the CPU to halt once the current instruction has been completed.
+    void signalWatchpoint() { watchpointReached = true; }
 };
 
 #endif
@@ -44,7 +44,8 @@ typedef enum {
     CPU_OK = 0,
     CPU_SOFT_BREAKPOINT_REACHED,
     CPU_HARD_BREAKPOINT_REACHED,
-    CPU_ILLEGAL_INSTRUCTION
+    CPU_ILLEGAL_INSTRUCTION,
+    CPU_WATCHPOINT_REACHED
 } ErrorState;
 
 /*! @brief    Breakpoint type
@@ -54,13 +55,107 @@ typedef enum {
  *
  *            HARD_BREAKPOINT: execution is halted
  *            SOFT_BREAKPOINT: execution is halted and the tag is deleted
+ *
+ *            In addition, a cell can be tagged with ROM_TRAP. This tag doesn't halt the CPU.
+ *            It hands control over to the virtual drive that may emulate the Kernal routine
+ *            starting at this address. Cells tagged with WATCHPOINT are covered by an
+ *            execution watchpoint. The CPU halts if the watchpoint condition holds.
  */
 typedef enum {
     NO_BREAKPOINT   = 0x00,
     HARD_BREAKPOINT = 0x01,
-    SOFT_BREAKPOINT = 0x02
+    SOFT_BREAKPOINT = 0x02,
+    ROM_TRAP        = 0x04,
+    WATCHPOINT      = 0x08
 } Breakpoint;
 
+//! @brief    Memory accesses monitored by a watchpoint (can be combined)
+typedef enum {
+    WATCH_READ      = 0x01,
+    WATCH_WRITE     = 0x02,
+    WATCH_EXECUTE   = 0x04
+} WatchType;
+
+/*! @brief    Left operand of a watchpoint condition
+ *  @details  OPERAND_VALUE refers to the value that is read or written. For execution
+ *            watchpoints, it refers to the opcode. All register values are taken at the
+ *            time of the memory access.
+ */
+typedef enum {
+    OPERAND_VALUE,
+    OPERAND_A,
+    OPERAND_X,
+    OPERAND_Y,
+    OPERAND_SP,
+    OPERAND_P,
+    OPERAND_PC
+} WatchOperand;
+
+//! @brief    Comparison performed by a watchpoint condition
+typedef enum {
+    COND_ALWAYS,
+    COND_EQUAL,
+    COND_NOT_EQUAL,
+    COND_LESS,
+    COND_GREATER,
+    COND_BITS_SET,
+    COND_BITS_CLEAR
+} WatchCondition;
+
+/*! @brief    Watchpoint
+ *  @details  The watchpoint triggers if one of the selected accesses hits the address
+ *            range [from; to] and the condition "operand <condition> value" holds.
+ *            COND_BITS_SET and COND_BITS_CLEAR check if all bits of value are set or
+ *            cleared in the operand, respectively.
+ */
+typedef struct {
+    uint16_t from;
+    uint16_t to;
+    uint8_t type;
+    WatchOperand operand;
+    WatchCondition condition;
+    uint16_t value;
+} Watchpoint;
+
+//! @brief    Information about the most recently triggered watchpoint
+typedef struct {
+    int nr;
+    uint8_t type;
+    uint16_t addr;
+    uint8_t value;
+    uint16_t pc;
+} WatchpointHit;
+
+/*! @brief    Type of a binary trace record
+ *  @details  Interrupts are recorded when the CPU enters the interrupt sequence. In this
+ *            case, the record contains the address of the next instruction that has been
+ *            fetched, but not executed yet.
+ */
+typedef enum : uint8_t {
+    TRACE_INSTRUCTION = 0,
+    TRACE_IRQ = 1,
+    TRACE_NMI = 2
+} TraceRecordType;
+
+/*! @brief    Binary trace record
+ *  @details  Written by the CPU whenever it fetches an opcode while binary tracing is
+ *            enabled. The register values are the ones before the instruction is executed.
+ *            The record size is fixed to 24 bytes.
+ */
+typedef struct {
+    uint64_t cycle;
+    uint16_t pc;
+    uint16_t rasterline;
+    uint8_t bytes[3];
+    uint8_t a;
+    uint8_t x;
+    uint8_t y;
+    uint8_t sp;
+    uint8_t p;
+    uint8_t rasterCycle;
+    TraceRecordType type;
+} TraceRecord;
+
 //! @brief    Disassembled instruction
 typedef struct {
     uint16_t addr; 
@@ -150,7 +150,7 @@ Cartridge::stateSize()
 }
 
 void
-Cartridge::loadFromBuffer(uint8_t **buffer)
+Cartridge::loadFromBuffer(uint8_t **buffer, SnapshotFormat)
 {
     uint8_t *old = *buffer;
     
@@ -175,11 +175,11 @@ Cartridge::loadFromBuffer(uint8_t **buffer)
     regValue = read8(buffer);
     
     debug(2, "  Cartridge state loaded (%d bytes)\n", *buffer - old);
-    assert(*buffer - old == stateSize());
+    assert((size_t)(*buffer - old) == stateSize());
 }
 
 void
-Cartridge::saveToBuffer(uint8_t **buffer)
+Cartridge::saveToBuffer(uint8_t **buffer, SnapshotFormat)
 {
     uint8_t *old = *buffer;
     
@@ -200,7 +200,25 @@ Cartridge::saveToBuffer(uint8_t **buffer)
     write8(buffer, regValue);
     
     debug(4, "  Cartridge state saved (%d bytes)\n", *buffer - old);
-    assert(*buffer - old == stateSize());
+    assert((size_t)(*buffer - old) == stateSize());
+}
+
+uint64_t
+Cartridge::hashState(uint64_t seed)
+{
+    uint8_t lines[2] = { (uint8_t)initialGameLine, (uint8_t)initialExromLine };
+    uint64_t hash = hashBlock(seed, lines, sizeof(lines));
+    
+    hash = hashBlock(hash, chipStartAddress, sizeof(chipStartAddress));
+    hash = hashBlock(hash, chipSize, sizeof(chipSize));
+    for (unsigned i = 0; i < 64; i++) {
+        if (chipSize[i] > 0) {
+            hash = hashBlock(hash, chip[i], chipSize[i]);
+        }
+    }
+    hash = hashBlock(hash, blendedIn, sizeof(blendedIn));
+    hash = hashBlock(hash, &cycle, sizeof(cycle));
+    return hashBlock(hash, &regValue, sizeof(regValue));
 }
 
 void
@@ -242,6 +260,26 @@ Cartridge::peek(uint16_t addr)
     return c64->mem.ram[addr];
 }
 
+uint8_t *
+Cartridge::romPage(uint8_t page)
+{
+    uint16_t addr = page << 8;
+    uint8_t  nr   = blendedIn[addr >> 12];
+    
+    if (nr < 64) {
+        
+        assert(chip[nr] != NULL);
+        
+        uint16_t offset = addr - chipStartAddress[nr];
+        assert(offset < chipSize[nr]);
+        
+        return chip[nr] + offset;
+    }
+    
+    // No cartridge chip is mapped to this memory area
+    return c64->mem.ram + addr;
+}
+
 unsigned
 Cartridge::numberOfChips()
 {
@@ -283,6 +321,8 @@ Cartridge::bankIn(unsigned nr)
     for (unsigned i = 0; i < numBanks; i++)
         blendedIn[firstBank + i] = nr;
     
+    c64->mem.updatePeekPokeLookupTables();
+    
     /*
     debug(1, "Chip %d banked in (start: %04X size: %d KB)\n", nr, start, size / 1024);
     for (unsigned i = 0; i < 16; i++) {
@@ -307,6 +347,8 @@ Cartridge::bankOut(unsigned nr)
     for (unsigned i = 0; i < numBanks; i++)
         blendedIn[firstBank + i] = 255;
     
+    c64->mem.updatePeekPokeLookupTables();
+    
     debug(1, "Chip %d banked out (start: %04X size: %d KB)\n", nr, start, size / 1024);
     for (unsigned i = 0; i < 16; i++) {
         printf("%d ", blendedIn[i]);
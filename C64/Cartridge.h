@@ -115,10 +115,13 @@ public:
     size_t stateSize();
     
     //! @brief    Loads the current state from a buffer
-    void loadFromBuffer(uint8_t **buffer);
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
     
     //! @brief    Save the current state into a buffer
-    void saveToBuffer(uint8_t **buffer);
+    void saveToBuffer(uint8_t **buffer, SnapshotFormat format);
+    
+    //! @brief    Hashes the data written by saveToBuffer
+    uint64_t hashState(uint64_t seed);
     
     //! @brief    Prints debugging information
     void dumpState();
@@ -132,6 +135,12 @@ public:
      */
     virtual void execute() { };
     
+    /*! @brief    Returns a direct pointer to the ROM data visible in a memory page
+     *  @details  The C64 memory uses this pointer to read from the page without calling
+     *            peek(). Cartridges with a custom peek() method return NULL.
+     */
+    virtual uint8_t *romPage(uint8_t page);
+    
     //! @brief    Peek fallthrough
     virtual uint8_t peek(uint16_t addr); 
     
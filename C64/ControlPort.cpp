@@ -52,9 +52,9 @@ ControlPort::reset()
 }
 
 void
-ControlPort::loadFromBuffer(uint8_t **buffer)
+ControlPort::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
-    VirtualComponent::loadFromBuffer(buffer);
+    VirtualComponent::loadFromBuffer(buffer, format);
     
     // Discard any active joystick movements
     button = false;
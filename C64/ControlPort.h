@@ -56,11 +56,14 @@ public:
     void reset();
 
     //! @brief    Method from VirtualComponent
-    void loadFromBuffer(uint8_t **buffer);
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
     
     //! @brief    Method from VirtualComponent
     void dumpState();
     
+    //! @brief   Returns the port number (1 or 2)
+    int getNr() { return nr; }
+    
     //! @brief   Triggers a joystick event
     void trigger(JoystickEvent event);
     
@@ -110,6 +110,7 @@ public:
     CartridgeType getCartridgeType() { return CRT_EPYX_FASTLOAD; }
     void reset();
     void execute();
+    uint8_t *romPage(uint8_t) { return NULL; }
     uint8_t peek(uint16_t addr);
     uint8_t read(uint16_t addr);
     uint8_t peekIO1(uint16_t addr);
@@ -143,6 +144,7 @@ class Zaxxon : public Cartridge {
 public:
     using Cartridge::Cartridge;
     CartridgeType getCartridgeType() { return CRT_ZAXXON; }
+    uint8_t *romPage(uint8_t) { return NULL; }
     uint8_t peek(uint16_t addr);
     uint8_t read(uint16_t addr);
 };
@@ -759,6 +759,184 @@ D64Archive::markSectorAsUsed(uint8_t track, uint8_t sector)
     }
 }
 
+void
+D64Archive::markSectorAsFree(uint8_t track, uint8_t sector)
+{
+    int bam = offset(18,0) + (4 * track);
+    uint8_t bitmask = 0x01 << (sector & 0x07);
+    
+    if (!(data[bam + 1 + (sector >> 3)] & bitmask)) {
+        
+        // Set bit and increase number of free sectors
+        data[bam + 1 + (sector >> 3)] |= bitmask;
+        data[bam]++;
+    }
+}
+
+bool
+D64Archive::sectorIsFree(uint8_t track, uint8_t sector)
+{
+    int bam = offset(18,0) + (4 * track);
+    return (data[bam + 1 + (sector >> 3)] & (0x01 << (sector & 0x07))) != 0;
+}
+
+bool
+D64Archive::allocateSector(uint8_t *track, uint8_t *sector)
+{
+    for (uint8_t t = 1; t <= 35; t++) {
+        
+        if (t == 18)
+            continue; // Reserved for the directory
+        
+        for (uint8_t s = 0; s < D64Map[t].numberOfSectors; s++) {
+            
+            if (sectorIsFree(t, s)) {
+                markSectorAsUsed(t, s);
+                memset(data + offset(t, s), 0, 256);
+                *track = t;
+                *sector = s;
+                return true;
+            }
+        }
+    }
+    return false; // Sorry, disk is full
+}
+
+unsigned
+D64Archive::numberOfFreeBlocks()
+{
+    unsigned result = 0;
+    
+    for (unsigned t = 1; t <= 35; t++) {
+        if (t != 18)
+            result += data[offset(18,0) + (4 * t)];
+    }
+    return result;
+}
+
+int
+D64Archive::findFreeDirectoryEntry()
+{
+    int pos = offset(18, 1);
+    uint32_t chain = (1 << 0) | (1 << 1); // Sectors occupied by the BAM and the directory
+    
+    for (unsigned i = 0; i < 18; i++) {
+        
+        // Directory items start with the file type byte. Zero means 'unused'
+        for (unsigned k = 0; k < 8; k++) {
+            if (data[pos + 2 + 0x20 * k] == 0x00)
+                return pos + 2 + 0x20 * k;
+        }
+        
+        if (data[pos] == 0x00) {
+            
+            /* Append a new directory sector. Because not all images mark the directory
+             * track correctly in the BAM, we pick the first sector that isn't part of
+             * the directory chain.
+             */
+            uint8_t sector;
+            for (sector = 2; sector < D64Map[18].numberOfSectors; sector++) {
+                if (!(chain & (1 << sector)))
+                    break;
+            }
+            if (sector == D64Map[18].numberOfSectors)
+                return -1;
+            
+            markSectorAsUsed(18, sector);
+            data[pos] = 18;
+            data[pos + 1] = sector;
+            pos = offset(18, sector);
+            memset(data + pos, 0, 256);
+            data[pos + 1] = 0xFF;
+            return pos + 2;
+        }
+        
+        if (data[pos] != 18 || !jumpToNextSector(&pos))
+            return -1;
+        chain |= 1 << ((pos - offset(18, 0)) / 256);
+    }
+    return -1;
+}
+
+bool
+D64Archive::addFile(const char *name, const uint8_t *buffer, size_t length)
+{
+    assert(buffer != NULL);
+    
+    unsigned blocks = length ? (unsigned)((length + 253) / 254) : 1;
+    if (blocks > numberOfFreeBlocks())
+        return false;
+    
+    int entry = findFreeDirectoryEntry();
+    if (entry < 0)
+        return false;
+    
+    // Write data sectors
+    uint8_t track, sector, firstTrack = 0, firstSector = 0;
+    int prev = -1;
+    for (unsigned i = 0; i < blocks; i++) {
+        
+        if (!allocateSector(&track, &sector))
+            return false;
+        
+        int pos = offset(track, sector);
+        size_t chunk = (length - 254 * i < 254) ? length - 254 * i : 254;
+        memcpy(data + pos + 2, buffer + 254 * i, chunk);
+        
+        // The last sector links to the position of its last byte
+        data[pos] = 0x00;
+        data[pos + 1] = (uint8_t)(chunk + 1);
+        
+        if (prev < 0) {
+            firstTrack = track;
+            firstSector = sector;
+        } else {
+            data[prev] = track;
+            data[prev + 1] = sector;
+        }
+        prev = pos;
+    }
+    
+    // Write directory entry
+    memset(data + entry, 0x00, 0x1E);
+    data[entry] = 0x82; // PRG
+    data[entry + 0x01] = firstTrack;
+    data[entry + 0x02] = firstSector;
+    size_t len = strlen(name);
+    for (unsigned k = 0; k < 16; k++)
+        data[entry + 0x03 + k] = (len > k) ? name[k] : 0xA0;
+    data[entry + 0x1C] = LO_BYTE(blocks);
+    data[entry + 0x1D] = HI_BYTE(blocks);
+    
+    return true;
+}
+
+void
+D64Archive::deleteItem(int n)
+{
+    int entry = findDirectoryEntry(n);
+    if (entry <= 0)
+        return;
+    
+    // Release all data sectors
+    uint8_t track = data[entry + 0x01];
+    uint8_t sector = data[entry + 0x02];
+    for (unsigned i = 0; i < 683; i++) {
+        
+        if (track < 1 || track > 35 || sector >= D64Map[track].numberOfSectors)
+            break;
+        if (sectorIsFree(track, sector))
+            break;
+        
+        int pos = offset(track, sector);
+        markSectorAsFree(track, sector);
+        track = data[pos];
+        sector = data[pos + 1];
+    }
+    
+    data[entry] = 0x00;
+}
+
 void
 D64Archive::writeBAM(const char *name)
 {
@@ -203,6 +203,10 @@ private:
      */
     void markSectorAsUsed(uint8_t track, uint8_t sector);
 
+    /*! @brief   Marks a single sector as "unused"
+     */
+    void markSectorAsFree(uint8_t track, uint8_t sector);
+
     /*! @brief   Writes the Block Availability Map (BAM)
      *  @details On a C64 diskette, the BAM is located ion track 18, sector 0.
      *  @param   name Name of the disk
@@ -249,6 +253,44 @@ private:
      */
     bool writeDirectoryEntry(unsigned nr, const char *name, uint8_t startTrack, uint8_t startSector, size_t filesize);
     
+    /*! @brief    Searches the directory for an unused entry
+     *  @details  If all directory sectors are full, a new one is appended on track 18.
+     *  @returns  Offset to the file type byte of the entry or -1 if the directory is full
+     */
+    int findFreeDirectoryEntry();
+    
+    /*! @brief    Returns true iff the BAM marks the specified sector as free
+     */
+    bool sectorIsFree(uint8_t track, uint8_t sector);
+    
+    /*! @brief    Picks a free sector outside the directory track
+     *  @details  The sector is marked as used and its contents is cleared.
+     *  @result   false if no free sector is left
+     */
+    bool allocateSector(uint8_t *track, uint8_t *sector);
+    
+public:
+    
+    /*! @brief    Returns the number of free blocks as shown in the directory listing
+     */
+    unsigned numberOfFreeBlocks();
+    
+    /*! @brief    Adds a new PRG file to the archive
+     *  @details  The sectors are allocated in the BAM and a new directory entry is created.
+     *            Existing files with the same name are not touched.
+     *  @param    name    File name in PETSCII (at most 16 characters are used)
+     *  @param    buffer  File contents including the two byte load address
+     *  @result   false if the disk is full
+     */
+    bool addFile(const char *name, const uint8_t *buffer, size_t length);
+    
+    /*! @brief    Removes a file from the archive
+     *  @details  The directory entry is marked as unused and all sectors of the file are
+     *            released in the BAM.
+     *  @param    n   Number of the item as used by getNameOfItem()
+     */
+    void deleteItem(int n);
+    
 
     //
     //! @functiongroup Debugging
@@ -40,6 +40,7 @@ Datasette::Datasette()
         { &headInSeconds,           sizeof(headInSeconds),          CLEAR_ON_RESET },
         { &nextRisingEdge,          sizeof(nextRisingEdge),         CLEAR_ON_RESET },
         { &nextFallingEdge,         sizeof(nextFallingEdge),        CLEAR_ON_RESET },
+        { &syncCycle,               sizeof(syncCycle),              CLEAR_ON_RESET },
         { &playKey,                 sizeof(playKey),                CLEAR_ON_RESET },
         { &motor,                   sizeof(motor),                  CLEAR_ON_RESET },
         
@@ -86,14 +87,13 @@ Datasette::stateSize()
 }
 
 void
-Datasette::loadFromBuffer(uint8_t **buffer)
+Datasette::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
     uint8_t *old = *buffer;
     
-    VirtualComponent::loadFromBuffer(buffer);
+    VirtualComponent::loadFromBuffer(buffer, format);
     if (size) {
-        if (data == NULL)
-            data = (uint8_t *)malloc(size);
+        data = (uint8_t *)realloc(data, size);
         readBlock(buffer, (uint8_t *)data, size);
     }
     
@@ -102,11 +102,11 @@ Datasette::loadFromBuffer(uint8_t **buffer)
 }
 
 void
-Datasette::saveToBuffer(uint8_t **buffer)
+Datasette::saveToBuffer(uint8_t **buffer, SnapshotFormat format)
 {
     uint8_t *old = *buffer;
     
-    VirtualComponent::saveToBuffer(buffer);
+    VirtualComponent::saveToBuffer(buffer, format);
     if (size) {
         assert(data != NULL);
         writeBlock(buffer, (uint8_t *)data, size);
@@ -116,6 +116,13 @@ Datasette::saveToBuffer(uint8_t **buffer)
         assert(0);
 }
 
+uint64_t
+Datasette::hashState(uint64_t seed)
+{
+    uint64_t hash = VirtualComponent::hashState(seed);
+    return size ? hashBlock(hash, data, size) : hash;
+}
+
 void
 Datasette::dumpState()
 {
@@ -166,7 +173,8 @@ Datasette::ejectTape()
     if (!hasTape())
         return;
     
-    pressStop();
+    c64->suspend();
+    _pressStop();
     
     assert(data != NULL);
     free(data);
@@ -175,6 +183,7 @@ Datasette::ejectTape()
     type = 0;
     durationInCycles = 0;
     head = -1;
+    c64->resume();
 
     c64->putMessage(MSG_VC1530_NO_TAPE);
 }
@@ -230,18 +239,33 @@ Datasette::pressPlay()
         return;
     
     debug("Datasette::pressPlay\n");
+    
+    // The event scheduler must not run while the first pulse is scheduled
+    c64->suspend();
     playKey = true;
 
     // Schedule first pulse
     uint64_t length = pulseLength();
     nextRisingEdge = length / 2;
     nextFallingEdge = length;
+    syncCycle = c64->cycle - 1;
+    scheduleNextEvent();
+    c64->resume();
 }
 
 void
 Datasette::pressStop()
 {
     debug("Datasette::pressStop\n");
+    
+    c64->suspend();
+    _pressStop();
+    c64->resume();
+}
+
+void
+Datasette::_pressStop()
+{
     setMotor(false);
     playKey = false;
 }
@@ -252,31 +276,71 @@ Datasette::setMotor(bool value)
     if (motor == value)
         return;
     
+    // The datasette's time slot in the current cycle has not been reached yet
+    if (playKey) {
+        if (motor) advanceTo(c64->cycle - 1); else syncCycle = c64->cycle - 1;
+    }
+
     motor = value;
+    scheduleNextEvent();
+}
+
+void
+Datasette::advanceTo(uint64_t cycle)
+{
+    if (cycle > syncCycle) {
+        nextRisingEdge -= (int64_t)(cycle - syncCycle);
+        nextFallingEdge -= (int64_t)(cycle - syncCycle);
+        syncCycle = cycle;
+    }
+}
+
+void
+Datasette::scheduleNextEvent()
+{
+    if (!hasTape() || !playKey || !motor) {
+        c64->cancelEvent(EVENT_DATASETTE);
+        return;
+    }
+    
+    if (nextRisingEdge > 0) {
+        c64->scheduleEvent(EVENT_DATASETTE, syncCycle + nextRisingEdge);
+    } else if (nextFallingEdge > 0 && head < size) {
+        c64->scheduleEvent(EVENT_DATASETTE, syncCycle + nextFallingEdge);
+    } else {
+        c64->scheduleEvent(EVENT_DATASETTE, syncCycle + 1);
+    }
+}
+
+void
+Datasette::execute()
+{
+    if (playKey && motor) {
+        _execute();
+    } else {
+        c64->cancelEvent(EVENT_DATASETTE);
+    }
 }
 
 void
 Datasette::_execute()
 {
-    if (!hasTape() || !playKey || !motor)
+    if (!hasTape()) {
+        c64->cancelEvent(EVENT_DATASETTE);
         return;
+    }
     
-    nextRisingEdge--;
-    nextFallingEdge--;
+    advanceTo(c64->cycle);
     
     if (nextRisingEdge == 0) {
         _executeRising();
-        return;
-    }
-
-    if (nextFallingEdge == 0 && head < size) {
+    } else if (nextFallingEdge == 0 && head < size) {
         _executeFalling();
-        return;
+    } else if (head >= size) {
+        _pressStop();
     }
     
-    if (head >= size) {
-        pressStop();
-    }
+    scheduleNextEvent();
 }
 
 void
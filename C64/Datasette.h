@@ -47,10 +47,13 @@ public:
     size_t stateSize();
     
     //! @brief    Restores the current state from a buffer
-    void loadFromBuffer(uint8_t **buffer);
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
     
     //! @brief    Saves the current state into a buffer
-    void saveToBuffer(uint8_t **buffer);
+    void saveToBuffer(uint8_t **buffer, SnapshotFormat format);
+
+    //! @brief    Hashes the state including the tape data
+    uint64_t hashState(uint64_t seed);
 
     //! @brief    Dumps the current state
     void dumpState();
@@ -115,6 +118,12 @@ private:
      */
     int64_t nextFallingEdge;
     
+    /*! @brief    Last cycle that is accounted for in nextRisingEdge and nextFallingEdge
+     *  @details  The datasette is executed by the event scheduler. It only wakes up when
+     *            an edge is due and makes up for all skipped cycles by using this value.
+     */
+    uint64_t syncCycle;
+    
     /*! @brief    Indicates whether the play key is pressed 
      */
     bool playKey;
@@ -196,10 +205,12 @@ public:
     bool getPlayKey() { return playKey; }
 
     /*! @brief    Press play on tape 
+     *  @details  The emulator is suspended while the first pulse is scheduled.
      */
     void pressPlay(); 
 
     /*! @brief    Press stop key 
+     *  @details  The emulator is suspended while the datasette is stopped.
      */
     void pressStop();
 
@@ -211,14 +222,25 @@ public:
      */
     void setMotor(bool value);
 
-    /*! @brief  Executes the virtual datasette
+    /*! @brief    Executes the virtual datasette
+     *  @details  This function is invoked by the event scheduler in all cycles the
+     *            datasette has registered for.
      */
-    void execute() { if (playKey && motor) _execute(); }
+    void execute();
 
 private:
 
     //! @brief    Internal execution function
     void _execute();
+    
+    //! @brief    Releases the play key (called with the emulator suspended or from within)
+    void _pressStop();
+    
+    //! @brief    Makes up for all skipped cycles up to the specified cycle
+    void advanceTo(uint64_t cycle);
+    
+    //! @brief    Registers the cycle of the next edge on the data line at the event scheduler
+    void scheduleNextEvent();
 
     //! @brief    Simulates the falling edge of a pulse
     void _executeFalling();
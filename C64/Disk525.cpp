@@ -42,37 +42,63 @@ Disk525::Disk525()
     for (unsigned i = 0; i < 16; i++)
         invgcr[gcr[i]] = i;
 
+    source = NULL;
+    memset(pending, 0, sizeof(pending));
     clearDisk();
 }
 
 Disk525::~Disk525()
 {
+    delete source;
+}
+
+void
+Disk525::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
+{
+    // The snapshot contains fully encoded disk data
+    discardSource();
+    VirtualComponent::loadFromBuffer(buffer, format);
+}
+
+void
+Disk525::saveToBuffer(uint8_t **buffer, SnapshotFormat format)
+{
+    encodePendingHalftracks();
+    VirtualComponent::saveToBuffer(buffer, format);
+}
+
+uint64_t
+Disk525::hashState(uint64_t seed)
+{
+    encodePendingHalftracks();
+    return VirtualComponent::hashState(seed);
 }
 
 void
 Disk525::dumpState()
 {
-    unsigned noOfOneBits, alignedSyncs, unalignedSyncs;
-    uint8_t bit;
+    unsigned offset, alignedSyncs, unalignedSyncs;
     
     msg("5,25\" floppy disk\n");
     msg("-----------------\n\n");
 
+    encodePendingHalftracks();
+
     for (unsigned track = 1; track <= 42; track++) {
         assert(isTrackNumber(track));
-        noOfOneBits = alignedSyncs = unalignedSyncs = 0;
-        for (unsigned offset = 0; offset < length.track[track][0]; offset++) {
-            if ((bit = readBit(data.track[track], offset))) {
-                noOfOneBits++;
+        alignedSyncs = unalignedSyncs = 0;
+        unsigned len = length.track[track][0];
+        for (int pos = findSyncMark(data.track[track], 0, len); pos >= 0;
+             pos = findSyncMark(data.track[track], offset, len)) {
+            
+            // Search the end of the SYNC mark
+            for (offset = pos + 10; offset < len && readBit(data.track[track], offset); offset++);
+            if (offset == len) break;
+            
+            if (offset % 8 == 0) {
+                alignedSyncs++;
             } else {
-                if (noOfOneBits >= 10) { // SYNC FOUND
-                    if (offset % 8 == 0) {
-                        alignedSyncs++;
-                    } else {
-                        unalignedSyncs++;
-                    }
-                }
-                noOfOneBits = 0;
+                unalignedSyncs++;
             }
         }
         
@@ -86,21 +112,20 @@ Disk525::dumpState()
 void
 Disk525::debugSyncMarks(uint8_t *data, unsigned lengthInBits) {
     
-    unsigned r, noOfOneBits, alignedSyncs = 0, unalignedSyncs = 0;
+    unsigned r, alignedSyncs = 0, unalignedSyncs = 0;
 
-    for (r = noOfOneBits = 0; r < lengthInBits; r++) {
-        if (readBit(data, r)) {
-            noOfOneBits++;
+    for (int pos = findSyncMark(data, 0, lengthInBits); pos >= 0;
+         pos = findSyncMark(data, r, lengthInBits)) {
+        
+        // Search the end of the SYNC mark
+        for (r = pos + 10; r < lengthInBits && readBit(data, r); r++);
+        if (r == lengthInBits) break;
+        
+        if (r % 8 == 0) {
+            alignedSyncs++;
         } else {
-            if (noOfOneBits >= 10) { // SYNC FOUND
-                if (r % 8 == 0) {
-                    alignedSyncs++;
-                } else {
-                    warn("Unaligned SYNC mark found at offset %d\n", r);
-                    unalignedSyncs++;
-                }
-            }
-            noOfOneBits = 0;
+            warn("Unaligned SYNC mark found at offset %d\n", r);
+            unalignedSyncs++;
         }
     }
 
@@ -110,10 +135,38 @@ Disk525::debugSyncMarks(uint8_t *data, unsigned lengthInBits) {
         
 }
 
+int
+Disk525::findSyncMark(const uint8_t *data, unsigned offset, unsigned length)
+{
+    while (offset + 10 <= length) {
+        
+        // Load the next 64 bits (left aligned, padded with 0s at the end of the track)
+        unsigned avail = length - offset < 64 ? length - offset : 64;
+        unsigned hi = avail < 32 ? avail : 32;
+        uint64_t window = (uint64_t)readBits(data, offset, hi) << (64 - hi);
+        if (avail > 32)
+            window |= (uint64_t)readBits(data, offset + 32, avail - 32) << (64 - avail);
+        
+        // Bit i of run is set iff the bits i ... i+9 of the window are all 1
+        uint64_t run = window & (window << 1);
+        run &= run << 2;
+        run &= run << 4;
+        run &= run << 2;
+        
+        if (run)
+            return offset + __builtin_clzll(run);
+        
+        // Advance by the number of positions that have been fully examined
+        if (avail < 64) break;
+        offset += 64 - 9;
+    }
+    return -1;
+}
+
 void
 Disk525::dumpHalftrack(Halftrack ht, unsigned min, unsigned max, unsigned highlight)
 {
-    assert(isHalftrackNumber(ht));
+    encodeHalftrackOnDemand(ht);
     
     uint16_t bytesOnTrack = length.halftrack[ht] / 8;
     
@@ -129,6 +182,7 @@ Disk525::dumpHalftrack(Halftrack ht, unsigned min, unsigned max, unsigned highli
 void
 Disk525::clearDisk()
 {
+    discardSource();
     for (Halftrack ht = 1; ht <= 84; ht++) {
         clearHalftrack(ht);
         length.halftrack[ht] = sizeof(data.halftrack[ht]) * 8;
@@ -147,7 +201,7 @@ Disk525::clearHalftrack(Halftrack ht)
 const char *
 Disk525::dataAbs(Halftrack ht, int start, unsigned n)
 {
-    assert(isHalftrackNumber(ht));
+    encodeHalftrackOnDemand(ht);
     assert(n < sizeof(text));
     
     // We also accept negative values for 'start'
@@ -231,57 +285,94 @@ Disk525::encodeArchive(NIBArchive *a)
     }
 }
 
+// Interleave patterns (no interleave)
+/*
+static const int zone1[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, -1 };
+static const int track18[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, -1 };
+static const int zone2[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, -1 };
+static const int zone3[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, -1 };
+static const int zone4[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, -1 };
+*/
+
+// Interleave patterns (minics real VC1541 sector layout)
+static const int zone1[] = { 0, 10, 20, 9, 19, 8, 18, 7, 17, 6, 16, 5, 15, 4, 14, 3, 13, 2, 12, 1, 11, -1 };
+static const int track18[] = { 0, 3, 6, 9, 12, 15, 18, 2, 5, 8, 11, 14, 17, 1, 4, 7, 10, 13, 16, -1 };
+static const int zone2[] = { 0, 10, 1, 11, 2, 12, 3, 13, 4, 14, 5, 15, 6, 16, 7, 17, 8, 18, 9, -1 };
+static const int zone3[] = { 0, 10, 2, 12, 4, 14, 6, 16, 8, 1, 11, 3, 13, 5, 15, 7, 17, 9, -1 };
+static const int zone4[] = { 0, 10, 3, 13, 6, 16, 9, 2, 12, 5, 15, 8, 1, 11, 4, 14, 7, -1 };
+
+const int *
+Disk525::trackLayout(Track t, uint8_t *tailGapEven, uint8_t *tailGapOdd)
+{
+    assert(isTrackNumber(t));
+    
+    *tailGapEven = 9;
+    
+    // Zone 1: Tracks 1 - 17 (21 sectors, tailgap 9/9 (even/odd sectors))
+    if (t <= 17) { *tailGapOdd = 9; return zone1; }
+    
+    // Zone 2: Tracks 18 - 24 (19 sectors, tailgap 9/19 (even/odd sectors))
+    if (t == 18) { *tailGapOdd = 19; return track18; } // Directory track
+    if (t <= 24) { *tailGapOdd = 19; return zone2; }
+    
+    // Zone 3: Tracks 25 - 30 (18 sectors, tailgap 9/13 (even/odd sectors))
+    if (t <= 30) { *tailGapOdd = 13; return zone3; }
+    
+    // Zone 4: Tracks 31 - 35..42 (17 sectors, tailgap 9/10 (even/odd sectors))
+    *tailGapOdd = 10; return zone4;
+}
+
+unsigned
+Disk525::encodedTrackLength(Track t)
+{
+    uint8_t tailGapEven, tailGapOdd;
+    const int *sectorList = trackLayout(t, &tailGapEven, &tailGapOdd);
+    unsigned result = 0;
+    
+    // Each sector consists of 5 SYNC bytes, 10 GCR bytes (header), 9 gap bytes,
+    // 5 SYNC bytes, 325 GCR bytes (data), and the tail gap (see encodeSector)
+    for (unsigned i = 0; sectorList[i] != -1; i++) {
+        result += (5 + 10 + 9 + 5 + 325 + ((i % 2) ? tailGapOdd : tailGapEven)) * 8;
+    }
+    return result;
+}
+
 void
 Disk525::encodeArchive(D64Archive *a)
 {
-    // Interleave patterns (no interleave)
-    /*
-    int zone1[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, -1 };
-    int track18[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, -1 };
-    int zone2[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, -1 };
-    int zone3[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, -1 };
-    int zone4[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, -1 };
-    */
-    
-    // Interleave patterns (minics real VC1541 sector layout)
-    int zone1[] = { 0, 10, 20, 9, 19, 8, 18, 7, 17, 6, 16, 5, 15, 4, 14, 3, 13, 2, 12, 1, 11, -1 };
-    int track18[] = { 0, 3, 6, 9, 12, 15, 18, 2, 5, 8, 11, 14, 17, 1, 4, 7, 10, 13, 16, -1 };
-    int zone2[] = { 0, 10, 1, 11, 2, 12, 3, 13, 4, 14, 5, 15, 6, 16, 7, 17, 8, 18, 9, -1 };
-    int zone3[] = { 0, 10, 2, 12, 4, 14, 6, 16, 8, 1, 11, 3, 13, 5, 15, 7, 17, 9, -1 };
-    int zone4[] = { 0, 10, 3, 13, 6, 16, 9, 2, 12, 5, 15, 8, 1, 11, 4, 14, 7, -1 };
-
     unsigned track, encodedBits;
     
     assert(a != NULL);
     
     clearDisk();
-    numTracks = a->numberOfTracks();
-    
-    debug(2, "Encoding D64 archive with %d tracks\n", numTracks);
     
-    // Zone 1: Tracks 1 - 17 (21 sectors, tailgap 9/9 (even/odd sectors))
-    for (track = 1; track <= 17; track++) {
-        (void)encodeTrack(a, track, zone1, 9, 9);
+    // Keep a copy of the sector data. The tracks are encoded when they are accessed
+    size_t size = a->writeToBuffer(NULL);
+    uint8_t *buffer = new uint8_t[size];
+    a->writeToBuffer(buffer);
+    source = D64Archive::makeD64ArchiveWithBuffer(buffer, size);
+    delete[] buffer;
+    
+    if (source == NULL) {
+        warn("Cannot copy D64 archive\n");
+        numTracks = 0; // Leave an empty disk behind
+        return;
     }
     
-    // Zone 2: Tracks 18 - 24 (19 sectors, tailgap 9/19 (even/odd sectors))
-    (void)encodeTrack(a, track, track18, 9, 19); // Directory track
-    for (track = 19; track <= 24; track++) {
-        (void)encodeTrack(a, track, zone2, 9, 19);
-    }
+    numTracks = a->numberOfTracks();
     
-    // Zone 3: Tracks 25 - 30 (18 sectors, tailgap 9/13 (even/odd sectors))
-    for (track = 25; track <= 30; track++) {
-        (void)encodeTrack(a, track, zone3, 9, 13);
-    }
+    debug(2, "Encoding D64 archive with %d tracks\n", numTracks);
     
-    // Zone 4: Tracks 31 - 35..42 (17 sectors, tailgap 9/10 (even/odd sectors))
-    for (track = 31; track <= a->numberOfTracks(); track++) {
-        encodedBits = encodeTrack(a, track, zone4, 9, 10);
+    for (track = 1; track <= numTracks; track++) {
+        encodedBits = encodedTrackLength(track);
+        length.track[track][0] = encodedBits;  // Track t
+        length.track[track][1] = encodedBits;  // Half track above
+        pending[2 * track - 1] = true;
     }
     
     // Clear remaining tracks (if any)
     for (track = numTracks + 1; track <= 42; track++) {
+        encodedBits = encodedTrackLength(track);
         length.track[track][0] = encodedBits;  // Track t
         length.track[track][1] = encodedBits;  // Half track above
     }
@@ -291,8 +382,49 @@ Disk525::encodeArchive(D64Archive *a)
     }    
 }
 
+void
+Disk525::encodeHalftrack(Halftrack ht)
+{
+    assert(isHalftrackNumber(ht));
+    assert(pending[ht]);
+    assert(source != NULL);
+    assert(ht % 2 == 1);
+    
+    Track t = (ht + 1) / 2;
+    uint8_t tailGapEven, tailGapOdd;
+    const int *sectorList = trackLayout(t, &tailGapEven, &tailGapOdd);
+    
+    unsigned encodedBits = encodeTrack(source, t, sectorList, tailGapEven, tailGapOdd);
+    assert(encodedBits == length.halftrack[ht]);
+    (void)encodedBits;
+    
+    pending[ht] = false;
+    
+    // Free the source archive when it isn't needed any more
+    for (Halftrack i = 1; i <= 84; i++) {
+        if (pending[i]) return;
+    }
+    discardSource();
+}
+
+void
+Disk525::encodePendingHalftracks()
+{
+    for (Halftrack ht = 1; ht <= 84; ht++) {
+        encodeHalftrackOnDemand(ht);
+    }
+}
+
+void
+Disk525::discardSource()
+{
+    delete source;
+    source = NULL;
+    memset(pending, 0, sizeof(pending));
+}
+
 unsigned
-Disk525::encodeTrack(D64Archive *a, Track t, int *sectorList, uint8_t tailGapEven, uint8_t tailGapOdd)
+Disk525::encodeTrack(D64Archive *a, Track t, const int *sectorList, uint8_t tailGapEven, uint8_t tailGapOdd)
 {
     assert(isTrackNumber(t));
 
@@ -409,7 +541,7 @@ Disk525::decodeDisk(uint8_t *dest, int *error)
 {
     uint8_t tmpbuf1[2 * 7928], tmpbuf2[2 * 7928];
     unsigned tmpbuf1length, tmpbuf2length;
-    unsigned r, w, copies, noOfOneBits, bitsOnTrack = 0, numBytes = 0;
+    unsigned r, w, noOfOneBits, bitsOnTrack = 0, numBytes = 0;
     int startOfFirstSyncMark = -1;
     
     memset(tmpbuf1, 0, sizeof(tmpbuf1));
@@ -417,6 +549,8 @@ Disk525::decodeDisk(uint8_t *dest, int *error)
     
     if (error) *error = 0; // We assume the best
     
+    encodePendingHalftracks();
+    
     // For each full track ...
     for (Track t = 1; t <= numTracks; t++) {
     
@@ -427,14 +561,8 @@ Disk525::decodeDisk(uint8_t *dest, int *error)
         
         // Step 1: Search for first SYNC mark (ten 1s in a row)
         debug(3, "    Searching for first SYNC mark\n", startOfFirstSyncMark);
-        for (r = noOfOneBits = 0; r < bitsOnTrack; r++) {
-            
-            // Count '1' bits
-            if (readBit(data.track[t], r)) { noOfOneBits++; } else { noOfOneBits = 0; }
-            
-            // Check if we have found the beginning of a SYNC mark (ten 1s in a row)
-            if (noOfOneBits == 10) { startOfFirstSyncMark = r - 9; break; }
-        }
+        int pos = findSyncMark(data.track[t], 0, bitsOnTrack);
+        if (pos >= 0) startOfFirstSyncMark = pos;
         
         if (startOfFirstSyncMark < 0) {
             warn("Disk decoding aborted. No SYNC mark found on track %d\n", t);
@@ -446,15 +574,10 @@ Disk525::decodeDisk(uint8_t *dest, int *error)
         // Step 2: Copy track data into first temporary buffer starting at the first SYNC mark
         // Track data is repeates twice, so we can read safely beyond the array bounds later
         debug(3, "    Setting up temporary buffer (alignment offset = %d)\n", startOfFirstSyncMark);
-        for (copies = w = 0; copies < 2; copies++) {
-            for (r = startOfFirstSyncMark; r < bitsOnTrack; r++) {
-                assert((w / 8) < sizeof(tmpbuf1) - 1);
-                writeBit(tmpbuf1, w++, readBit(data.track[t], r));
-            }
-            for (r = 0; r < startOfFirstSyncMark; r++) {
-                assert((w / 8) < sizeof(tmpbuf1) - 1);
-                writeBit(tmpbuf1, w++, readBit(data.track[t], r));
-            }
+        assert((2 * bitsOnTrack) % 8 == 0);
+        for (w = 0; w < 2 * bitsOnTrack; w += 8) {
+            assert((w / 8) < sizeof(tmpbuf1) - 1);
+            tmpbuf1[w / 8] = readByteFromHalftrack(2 * t - 1, startOfFirstSyncMark + w);
         }
         assert(w % 8 == 0);
 
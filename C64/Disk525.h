@@ -91,6 +91,18 @@ public:
     //! @brief    Dump debug information
     void dumpState();
     
+    //! @brief    Method from VirtualComponent
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
+    
+    /*! @brief    Method from VirtualComponent
+     *  @details  Pending halftracks are encoded first, because the snapshot contains the
+     *            GCR encoded disk data.
+     */
+    void saveToBuffer(uint8_t **buffer, SnapshotFormat format);
+    
+    //! @brief    Hashes the state (pending halftracks are encoded first, too)
+    uint64_t hashState(uint64_t seed);
+    
     
 private:
     
@@ -161,6 +173,17 @@ public:
  
 private:
 
+    /*! @brief    Sector data of a D64 archive that hasn't been fully encoded yet
+     *  @details  D64 archives are GCR encoded lazily. When an archive is inserted, only the
+     *            track lengths are computed. The data of a halftrack is encoded when it is
+     *            accessed for the first time. The copy is deleted once all halftracks have
+     *            been encoded or when the disk data gets replaced.
+     */
+    D64Archive *source;
+    
+    //! @brief    Indicates which halftracks still need to be encoded from source
+    bool pending[85];
+
     /*! @brief   Write protection mark
      */
     bool writeProtected;
@@ -202,16 +225,53 @@ public:
      *  @result  0 or 1
      */
     uint8_t readBit(uint8_t *data, unsigned offset) {
-        return (data[offset / 8] & (0x80 >> (offset % 8))) ? 1 : 0; }
+        return (data[offset >> 3] >> (~offset & 7)) & 1; }
 
     /*! @brief   Reads a single bit from disk
+     *  @details The modulo operation is only performed if offset exceeds the track
+     *           length. The drive head position never does.
      *  @param   ht      Number of halftrack to read from
      *  @param   offset  Number of bit to read (first bit has offset 0)
      *  @result	 0 or 1
      */
     uint8_t readBitFromHalftrack(Halftrack ht, unsigned offset) {
         assert(isHalftrackNumber(ht));
-        return readBit(data.halftrack[ht], offset % length.halftrack[ht]);
+        if (offset >= length.halftrack[ht]) offset %= length.halftrack[ht];
+        return readBit(data.halftrack[ht], offset);
+    }
+
+    /*! @brief   Reads up to 32 consecutive bits from disk
+     *  @details Only the bytes covering the requested bits are accessed. The bits are
+     *           collected in a 64 bit word and shifted into place with a single shift.
+     *  @param   data    Pointer to the first data byte of a track
+     *  @param   offset  Position of first bit to read (first bit has offset 0)
+     *  @param   n       Number of bits to read (1 ... 32)
+     *  @result	 Bits in MSB first order, right aligned
+     */
+    uint32_t readBits(const uint8_t *data, unsigned offset, unsigned n) {
+        assert(n >= 1 && n <= 32);
+        const uint8_t *ptr = data + (offset >> 3);
+        unsigned bits = (offset & 7) + n;
+        uint64_t word = 0;
+        for (unsigned i = 0; i < bits; i += 8) word = (word << 8) | *ptr++;
+        return (uint32_t)((word >> ((8 - (bits & 7)) & 7)) & (0xFFFFFFFF >> (32 - n)));
+    }
+
+    /*! @brief   Reads up to 32 consecutive bits from disk
+     *  @details Reading wraps around at the end of the halftrack.
+     *  @param   ht      Number of halftrack to read from
+     *  @param   offset  Position of first bit to read (first bit has offset 0)
+     *  @param   n       Number of bits to read (1 ... 32)
+     *  @result	 Bits in MSB first order, right aligned
+     */
+    uint32_t readBitsFromHalftrack(Halftrack ht, unsigned offset, unsigned n) {
+        assert(isHalftrackNumber(ht));
+        unsigned len = length.halftrack[ht];
+        if (offset >= len) offset %= len;
+        if (offset + n <= len) return readBits(data.halftrack[ht], offset, n);
+        unsigned first = len - offset;
+        return (readBits(data.halftrack[ht], offset, first) << (n - first)) |
+        readBitsFromHalftrack(ht, 0, n - first);
     }
 
     /*! @brief   Reads a single byte from disk
@@ -220,24 +280,31 @@ public:
      *  @result	 0 .. 255
      */
     uint8_t readByte(uint8_t *data, unsigned offset) {
-        uint8_t result = 0;
-        for (uint8_t i = 0, mask = 0x80; i < 8; i++, mask >>= 1)
-            if (readBit(data, offset + i)) result |= mask;
-        return result;
+        unsigned shift = offset & 7;
+        uint8_t *ptr = data + (offset >> 3);
+        return shift ? (uint8_t)((ptr[0] << shift) | (ptr[1] >> (8 - shift))) : ptr[0];
     }
 
     /*! @brief   Reads a single byte from disk
      *  @param   ht      Number of halftrack to read from
      *  @param   offset  Position of first bit to read (first bit has offset 0)
-     *  @result	 returns 0 or 1
+     *  @result	 0 .. 255
      */
     uint8_t readByteFromHalftrack(Halftrack ht, unsigned offset) {
-        uint8_t result = 0;
-        for (uint8_t i = 0, mask = 0x80; i < 8; i++, mask >>= 1)
-            if (readBitFromHalftrack(ht, offset + i)) result |= mask;
-        return result;
+        return (uint8_t)readBitsFromHalftrack(ht, offset, 8);
     }
 
+    /*! @brief   Searches for the next SYNC mark (ten or more 1s in a row)
+     *  @details The track is scanned in 64 bit windows. In each window, all positions
+     *           that start a run of ten 1s are computed at once by ANDing shifted copies
+     *           of the window. The search does not wrap around the end of the track.
+     *  @param   data    Pointer to the first data byte of a track
+     *  @param   offset  Position of first bit to examine
+     *  @param   length  Length of the track in bits
+     *  @result	 Position of the first bit of the SYNC mark or -1 if none is found
+     */
+    int findSyncMark(const uint8_t *data, unsigned offset, unsigned length);
+
     
     //
     //! @functiongroup Writing data to disk
@@ -247,13 +314,13 @@ public:
      *  @param  data   Pointer to the first data byte of a track
      *  @param  offset Number of bit to set to 1 (first bit has offset 0)
      */
-    void setBit(uint8_t *data, unsigned offset) { data[offset / 8] |= (0x80 >> (offset % 8)); }
+    void setBit(uint8_t *data, unsigned offset) { data[offset >> 3] |= (0x80 >> (offset & 7)); }
     
     /*! @brief  Sets a single bit on disk to 0
      *  @param  data   Pointer to the first data byte of a track
      *  @param  offset Number of bit to clear (first bit has offset 0)
      */
-    void clearBit(uint8_t *data, unsigned offset) { data[offset / 8] &= ~(0x80 >> (offset % 8)); }
+    void clearBit(uint8_t *data, unsigned offset) { data[offset >> 3] &= ~(0x80 >> (offset & 7)); }
 
     /*! @brief  Writes a single bit to disk
      *  @param  data   Pointer to the first data byte of a track
@@ -269,7 +336,10 @@ public:
      *  @param  bit    0 for a '0' bit, every other value for a '1' bit
      */
     void writeBitToHalftrack(Halftrack ht, unsigned offset, uint8_t bit) {
-        assert(isHalftrackNumber(ht)); writeBit(data.halftrack[ht], offset % length.halftrack[ht], bit); }
+        assert(isHalftrackNumber(ht));
+        if (offset >= length.halftrack[ht]) offset %= length.halftrack[ht];
+        writeBit(data.halftrack[ht], offset, bit);
+    }
  
     /*! @brief  Writes a single byte to disk
      *  @param  data   Pointer to the first data byte of a track
@@ -277,8 +347,11 @@ public:
      *  @param  byte   Byte to write
      */
     void writeByte(uint8_t *data, unsigned offset, uint8_t byte) {
-        for (uint8_t i = 0, mask = 0x80; i < 8; i++, mask >>= 1)
-            writeBit(data, offset + i, byte & mask);
+        unsigned shift = offset & 7;
+        uint8_t *ptr = data + (offset >> 3);
+        if (shift == 0) { ptr[0] = byte; return; }
+        ptr[0] = (uint8_t)((ptr[0] & (0xFF00 >> shift)) | (byte >> shift));
+        ptr[1] = (uint8_t)((ptr[1] & (0xFF >> shift)) | (byte << (8 - shift)));
     }
 
     /*! @brief  Writes a single byte to disk
@@ -287,6 +360,12 @@ public:
      *  @param  byte   Byte to write
      */
     void writeByteToHalftrack(Halftrack ht, unsigned offset, uint8_t byte) {
+        assert(isHalftrackNumber(ht));
+        if (offset >= length.halftrack[ht]) offset %= length.halftrack[ht];
+        if (offset + 8 <= length.halftrack[ht]) {
+            writeByte(data.halftrack[ht], offset, byte);
+            return;
+        }
         for (uint8_t i = 0, mask = 0x80; i < 8; i++, mask >>= 1)
             writeBitToHalftrack(ht, offset + i, byte & mask);
     }
@@ -303,6 +382,34 @@ public:
      */
     void clearHalftrack(Halftrack ht);
 
+    
+    //
+    //! @functiongroup Encoding halftracks on demand
+    //
+    
+    /*! @brief   Makes sure that the data of a halftrack is available
+     *  @details Needs to be called before a halftrack is accessed for the first time, e.g.,
+     *           whenever the drive head moves to a new halftrack.
+     */
+    void encodeHalftrackOnDemand(Halftrack ht) {
+        assert(isHalftrackNumber(ht)); if (pending[ht]) encodeHalftrack(ht); }
+
+    /*! @brief   Encodes all halftracks that haven't been accessed, yet
+     */
+    void encodePendingHalftracks();
+    
+private:
+    
+    /*! @brief   Encodes a single pending halftrack from the source archive
+     */
+    void encodeHalftrack(Halftrack ht);
+    
+    /*! @brief   Deletes the source archive and marks all halftracks as encoded
+     */
+    void discardSource();
+    
+public:
+
     //
     //! @functiongroup Debugging disk data
     //
@@ -343,7 +450,9 @@ public:
 
     /*! @brief   Converts a D64 archive into a virtual floppy disk
      *  @details The method creates sync marks, GRC encoded header and data blocks,
-     *           checksums and gaps.
+     *           checksums and gaps. Tracks are encoded lazily, i.e., the method only keeps
+     *           a copy of the archive and sets up the track lengths.
+     *  @see     encodeHalftrackOnDemand
      */
     void encodeArchive(D64Archive *a);
 
@@ -356,7 +465,16 @@ private:
      *           tailGapOdd is the number of tail bytes follwowing sectors with odd sector numbers.
      *           Returns the number of bytes written 
      */
-    unsigned encodeTrack(D64Archive *a, Track t, int *sectorList, uint8_t tailGapEven, uint8_t tailGapOdd);
+    unsigned encodeTrack(D64Archive *a, Track t, const int *sectorList, uint8_t tailGapEven, uint8_t tailGapOdd);
+    
+    /*! @brief   Returns the interleave pattern and tail gaps of a track
+     *  @details The interleave pattern is a list of sector numbers terminated by -1.
+     */
+    static const int *trackLayout(Track t, uint8_t *tailGapEven, uint8_t *tailGapOdd);
+    
+    /*! @brief   Returns the number of bits encodeTrack() will write
+     */
+    static unsigned encodedTrackLength(Track t);
     
     /*! @brief   Encode a single sector
      *  @details This function translates the logical byte sequence of a single sector into the native VC1541
@@ -371,6 +489,7 @@ private:
      *  @param   length Number of SYNC bits to write
      */
     void writeSyncBits(uint8_t *dest, unsigned offset, unsigned length) {
+        for (; length >= 8; offset += 8, length -= 8) writeByte(dest, offset, 0xFF);
         for (unsigned i = 0; i < length; i++) writeBit(dest, offset + i, 1); }
     
     /*! @brief   Write interblock gap
@@ -64,7 +64,7 @@ ExpansionPort::stateSize()
 }
 
 void
-ExpansionPort::loadFromBuffer(uint8_t **buffer)
+ExpansionPort::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
     uint8_t *old = *buffer;
     
@@ -82,15 +82,18 @@ ExpansionPort::loadFromBuffer(uint8_t **buffer)
     // Read cartridge data (if any)
     if (cartridgeType != CRT_NONE) {
         cartridge = Cartridge::makeCartridgeWithType(c64, cartridgeType);
-        cartridge->loadFromBuffer(buffer);
+        cartridge->loadFromBuffer(buffer, format);
     }
     
+    // Update the memory page tables (chip memory has been reallocated)
+    c64->mem.updatePeekPokeLookupTables();
+    
     debug(2, "  Expansion port state loaded (%d bytes)\n", *buffer - old);
     assert(*buffer - old == stateSize());
 }
 
 void
-ExpansionPort::saveToBuffer(uint8_t **buffer)
+ExpansionPort::saveToBuffer(uint8_t **buffer, SnapshotFormat format)
 {
     uint8_t *old = *buffer;
     
@@ -100,12 +103,23 @@ ExpansionPort::saveToBuffer(uint8_t **buffer)
     
     // Write cartridge data (if any)
     if (cartridge != NULL)
-        cartridge->saveToBuffer(buffer);
+        cartridge->saveToBuffer(buffer, format);
  
     debug(4, "  Expansion port state saved (%d bytes)\n", *buffer - old);
     assert(*buffer - old == stateSize());
 }
 
+uint64_t
+ExpansionPort::hashState(uint64_t seed)
+{
+    uint8_t lines[4] = { exromLine, gameLine };
+    uint16_t type = cartridge ? cartridge->getCartridgeType() : CRT_NONE;
+    memcpy(lines + 2, &type, sizeof(type));
+    
+    uint64_t hash = hashBlock(seed, lines, sizeof(lines));
+    return cartridge ? cartridge->hashState(hash) : hash;
+}
+
 void
 ExpansionPort::dumpState()
 {
@@ -136,6 +150,12 @@ ExpansionPort::romIsBlendedIn(uint16_t addr)
     return cartridge ? cartridge->romIsBlendedIn(addr) : false;
 }
 
+uint8_t *
+ExpansionPort::romPage(uint8_t page)
+{
+    return cartridge ? cartridge->romPage(page) : NULL;
+}
+
 uint8_t
 ExpansionPort::peek(uint16_t addr)
 {
@@ -76,10 +76,13 @@ public:
     size_t stateSize();
 
     //! @brief    Loads the current state from a buffer
-    void loadFromBuffer(uint8_t **buffer);
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
     
     //! @brief    Save the current state into a buffer
-    void saveToBuffer(uint8_t **buffer);
+    void saveToBuffer(uint8_t **buffer, SnapshotFormat format);
+    
+    //! @brief    Hashes the data written by saveToBuffer
+    uint64_t hashState(uint64_t seed);
     
     //! @brief    Prints debugging information
     void dumpState();	
@@ -92,6 +95,12 @@ public:
      */
     void execute() { if (cartridge) cartridge->execute(); }
     
+    /*! @brief    Returns a direct pointer to the cartridge ROM visible in a memory page
+     *  @details  Used by the C64 memory to set up its page table. NULL is returned if
+     *            the page has to be accessed via peek().
+     */
+    uint8_t *romPage(uint8_t page);
+    
     //! @brief    Peek fallthrough
     uint8_t peek(uint16_t addr);
 
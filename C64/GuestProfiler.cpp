@@ -0,0 +1,264 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "GuestProfiler.h"
+#include <algorithm>
+#include <vector>
+
+GuestProfiler::GuestProfiler()
+{
+    setDescription("GuestProfiler");
+
+    counters = NULL;
+    clear();
+}
+
+GuestProfiler::~GuestProfiler()
+{
+    disable();
+}
+
+bool
+GuestProfiler::enable()
+{
+    if (counters == NULL && (counters = (Counters *)malloc(sizeof(Counters))) == NULL) {
+        warn("Cannot allocate profiler counters\n");
+        return false;
+    }
+    clear();
+    return true;
+}
+
+void
+GuestProfiler::disable()
+{
+    free(counters);
+    counters = NULL;
+}
+
+void
+GuestProfiler::clear()
+{
+    if (counters) {
+        memset(counters, 0, sizeof(Counters));
+        for (unsigned i = 0; i < 65536; i++) {
+            counters->function[i] = noFunction;
+        }
+    }
+    depth = 0;
+    lastPC = 0;
+    lastOpcode = 0;
+    lastValid = false;
+    lastCycle = 0;
+    interruptPending = false;
+    interruptCycle = 0;
+    interruptSequenceCycles = 0;
+    executed = 0;
+}
+
+void
+GuestProfiler::push(uint16_t entry, uint16_t callSite, uint16_t sp, bool interrupt, uint64_t cycle)
+{
+    counters->invocations[entry]++;
+    if (!interrupt) {
+        counters->callee[callSite] = entry;
+        counters->calls[callSite]++;
+    }
+
+    if (depth == maxDepth) {
+        debug(2, "Shadow stack overflow. Call to %04X is not tracked.\n", entry);
+        return;
+    }
+
+    Frame &frame = stack[depth++];
+    frame.entry = entry;
+    frame.callSite = callSite;
+    frame.sp = sp;
+    frame.interrupt = interrupt;
+    frame.start = cycle;
+    frame.startInstructions = executed;
+}
+
+void
+GuestProfiler::unwind(uint8_t sp, uint64_t cycle)
+{
+    while (depth && sp >= stack[depth - 1].sp) {
+
+        Frame &frame = stack[--depth];
+        uint64_t elapsed = cycle - frame.start;
+
+        counters->inclusive[frame.entry] += elapsed;
+        if (!frame.interrupt) {
+            counters->callCycles[frame.callSite] += elapsed;
+            counters->callInstructions[frame.callSite] += executed - frame.startInstructions;
+        }
+    }
+}
+
+static void
+functionName(char *buf, uint32_t entry)
+{
+    if (entry > 0xFFFF) {
+        strcpy(buf, "<toplevel>");
+    } else {
+        sprintf(buf, "sub_%04X", entry);
+    }
+}
+
+bool
+GuestProfiler::saveFlat(const char *path, const char *name)
+{
+    if (!isEnabled())
+        return false;
+
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        warn("Cannot write profile %s\n", path);
+        return false;
+    }
+
+    // Sum up the self cost of each function
+    std::vector<uint64_t> self(65537, 0);
+    uint64_t total = 0;
+    for (unsigned pc = 0; pc < 65536; pc++) {
+        self[counters->function[pc]] += counters->cycles[pc];
+        total += counters->cycles[pc];
+    }
+    double percent = total ? 100.0 / total : 0.0;
+
+    fprintf(f, "Guest profile of %s\n\n", name);
+    fprintf(f, "Instructions           : %llu\n", (unsigned long long)executed);
+    fprintf(f, "Instruction cycles     : %llu\n", (unsigned long long)total);
+    fprintf(f, "Interrupt sequences    : %llu cycles\n", (unsigned long long)interruptSequenceCycles);
+
+    // Functions, sorted by inclusive cycles
+    std::vector<uint32_t> functions;
+    for (uint32_t entry = 0; entry <= 65536; entry++) {
+        if (self[entry] || counters->invocations[entry]) functions.push_back(entry);
+    }
+    std::sort(functions.begin(), functions.end(), [&](uint32_t a, uint32_t b) {
+        uint64_t ia = MAX(counters->inclusive[a], self[a]);
+        uint64_t ib = MAX(counters->inclusive[b], self[b]);
+        return ia != ib ? ia > ib : a < b;
+    });
+
+    fprintf(f, "\n%-12s %12s %14s %7s %14s %7s\n",
+            "Function", "Calls", "Inclusive", "%", "Self", "%");
+    for (uint32_t entry : functions) {
+        char fn[16];
+        functionName(fn, entry);
+        uint64_t inclusive = entry > 0xFFFF ? total : counters->inclusive[entry];
+        fprintf(f, "%-12s %12llu %14llu %7.2f %14llu %7.2f\n", fn,
+                (unsigned long long)counters->invocations[entry],
+                (unsigned long long)inclusive, inclusive * percent,
+                (unsigned long long)self[entry], self[entry] * percent);
+    }
+
+    // Instructions, sorted by cycles
+    std::vector<uint16_t> pcs;
+    for (unsigned pc = 0; pc < 65536; pc++) {
+        if (counters->instructions[pc]) pcs.push_back((uint16_t)pc);
+    }
+    std::sort(pcs.begin(), pcs.end(), [&](uint16_t a, uint16_t b) {
+        uint64_t ca = counters->cycles[a], cb = counters->cycles[b];
+        return ca != cb ? ca > cb : a < b;
+    });
+
+    fprintf(f, "\n%-6s %-12s %12s %14s %7s %8s\n",
+            "Addr", "Function", "Executions", "Cycles", "%", "Cyc/Exe");
+    for (uint16_t pc : pcs) {
+        char fn[16];
+        functionName(fn, counters->function[pc]);
+        fprintf(f, "$%04X  %-12s %12llu %14llu %7.2f %8.2f\n", pc, fn,
+                (unsigned long long)counters->instructions[pc],
+                (unsigned long long)counters->cycles[pc], counters->cycles[pc] * percent,
+                (double)counters->cycles[pc] / counters->instructions[pc]);
+    }
+
+    fclose(f);
+    return true;
+}
+
+bool
+GuestProfiler::saveCallgrind(const char *path, const char *name)
+{
+    if (!isEnabled())
+        return false;
+
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        warn("Cannot write profile %s\n", path);
+        return false;
+    }
+
+    uint64_t total = interruptSequenceCycles;
+    for (unsigned pc = 0; pc < 65536; pc++) {
+        total += counters->cycles[pc];
+    }
+
+    fprintf(f, "# callgrind format\n");
+    fprintf(f, "version: 1\n");
+    fprintf(f, "creator: VirtualC64\n");
+    fprintf(f, "cmd: %s\n", name);
+    fprintf(f, "positions: instr\n");
+    fprintf(f, "events: Cycles Instructions\n");
+    fprintf(f, "summary: %llu %llu\n\n", (unsigned long long)total, (unsigned long long)executed);
+    fprintf(f, "ob=%s\n", name);
+    fprintf(f, "fl=%s\n", name);
+
+    // Group all executed instructions and call sites by function
+    std::vector<uint16_t> pcs;
+    for (unsigned pc = 0; pc < 65536; pc++) {
+        if (counters->instructions[pc]) pcs.push_back((uint16_t)pc);
+    }
+    std::stable_sort(pcs.begin(), pcs.end(), [&](uint16_t a, uint16_t b) {
+        return counters->function[a] < counters->function[b];
+    });
+
+    uint32_t current = UINT32_MAX;
+    for (uint16_t pc : pcs) {
+
+        char fn[16];
+        if (counters->function[pc] != current) {
+            current = counters->function[pc];
+            functionName(fn, current);
+            fprintf(f, "\nfn=%s\n", fn);
+        }
+        fprintf(f, "0x%04X %llu %llu\n", pc,
+                (unsigned long long)counters->cycles[pc],
+                (unsigned long long)counters->instructions[pc]);
+
+        if (counters->calls[pc]) {
+            functionName(fn, counters->callee[pc]);
+            fprintf(f, "cfn=%s\n", fn);
+            fprintf(f, "calls=%llu 0x%04X\n",
+                    (unsigned long long)counters->calls[pc], counters->callee[pc]);
+            fprintf(f, "0x%04X %llu %llu\n", pc,
+                    (unsigned long long)counters->callCycles[pc],
+                    (unsigned long long)counters->callInstructions[pc]);
+        }
+    }
+
+    if (interruptSequenceCycles) {
+        fprintf(f, "\nfn=<interrupt sequence>\n");
+        fprintf(f, "0 %llu 0\n", (unsigned long long)interruptSequenceCycles);
+    }
+
+    fclose(f);
+    return true;
+}
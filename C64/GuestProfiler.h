@@ -0,0 +1,233 @@
+/*!
+ * @header      GuestProfiler.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _GUESTPROFILER_INC
+#define _GUESTPROFILER_INC
+
+#include "VC64Object.h"
+
+/*! @class    GuestProfiler
+ *  @brief    Hot spot profiler for the emulated program
+ *  @details  The CPU reports each opcode fetch and each interrupt. All cycles elapsing
+ *            between two fetches are charged to the first instruction. This includes the
+ *            cycles in which the VIC has stolen the bus. Cycles spent in the IRQ or NMI
+ *            sequence itself are counted separately and added to the inclusive cost of
+ *            the interrupt handler.
+ *
+ *            Calls are tracked on a shadow stack. A frame is pushed when the CPU fetches
+ *            the first instruction of a subroutine (after JSR) or an interrupt handler
+ *            (after BRK, IRQ, or NMI). It is popped as soon as the stack pointer rises to
+ *            the level it had before the call. This catches RTS and RTI as well as code
+ *            that drops return addresses from the stack or resets the stack pointer.
+ *
+ *            All counters are kept in flat arrays indexed by the 16 bit address. Call
+ *            edges are indexed by the address of the JSR instruction. If the target of a
+ *            JSR changes (self-modifying code), the edge is reported with the most recent
+ *            target.
+ */
+class GuestProfiler : public VC64Object {
+
+    //! @brief    Maximum nesting depth of the shadow stack
+    static const unsigned maxDepth = 256;
+
+    //! @brief    Function entry of code that is not executed inside any tracked call
+    static const uint32_t noFunction = 0x10000;
+
+    //! @brief    Counters (allocated when the profiler is enabled)
+    typedef struct {
+
+        //! @brief    Cycles charged to each instruction address
+        uint64_t cycles[65536];
+
+        //! @brief    Number of executions of each instruction address
+        uint64_t instructions[65536];
+
+        //! @brief    Entry address of the function an instruction was executed in
+        uint32_t function[65536];
+
+        //! @brief    Target of the JSR instruction at each address
+        uint16_t callee[65536];
+
+        //! @brief    Number of calls from the JSR instruction at each address
+        uint64_t calls[65536];
+
+        //! @brief    Inclusive cycles of the calls from the JSR instruction at each address
+        uint64_t callCycles[65536];
+
+        //! @brief    Inclusive instructions of the calls from the JSR instruction at each address
+        uint64_t callInstructions[65536];
+
+        //! @brief    Number of invocations of the function starting at each address
+        uint64_t invocations[65536 + 1];
+
+        //! @brief    Inclusive cycles of the function starting at each address
+        uint64_t inclusive[65536 + 1];
+
+    } Counters;
+
+    //! @brief    Shadow stack frame
+    typedef struct {
+
+        //! @brief    First instruction of the called function
+        uint16_t entry;
+
+        //! @brief    Address of the JSR instruction
+        uint16_t callSite;
+
+        //! @brief    Stack pointer before the call
+        uint16_t sp;
+
+        //! @brief    Indicates an interrupt handler
+        bool interrupt;
+
+        //! @brief    Cycle in which the call began
+        uint64_t start;
+
+        //! @brief    Number of executed instructions when the call began
+        uint64_t startInstructions;
+
+    } Frame;
+
+    //! @brief    Counters (NULL if profiling is disabled)
+    Counters *counters;
+
+    //! @brief    Shadow stack
+    Frame stack[maxDepth];
+
+    //! @brief    Number of frames on the shadow stack
+    unsigned depth;
+
+    //! @brief    Address and opcode of the most recently fetched instruction
+    uint16_t lastPC;
+    uint8_t lastOpcode;
+
+    //! @brief    Indicates if lastPC is valid
+    bool lastValid;
+
+    //! @brief    Cycle of the most recent fetch or interrupt
+    uint64_t lastCycle;
+
+    //! @brief    Set by interrupt() until the handler's first instruction is fetched
+    bool interruptPending;
+
+    //! @brief    Cycle in which the pending interrupt sequence has started
+    uint64_t interruptCycle;
+
+    //! @brief    Cycles spent in interrupt sequences
+    uint64_t interruptSequenceCycles;
+
+    //! @brief    Total number of executed instructions
+    uint64_t executed;
+
+public:
+
+    //! @brief    Constructor
+    GuestProfiler();
+
+    //! @brief    Destructor
+    ~GuestProfiler();
+
+    //! @brief    Returns true iff the profiler is collecting data
+    bool isEnabled() { return counters != NULL; }
+
+    //! @brief    Starts profiling (all previously collected data is discarded)
+    bool enable();
+
+    //! @brief    Stops profiling and frees the counters
+    void disable();
+
+    //! @brief    Discards all collected data
+    void clear();
+
+    //! @brief    Returns the number of cycles charged to an instruction
+    uint64_t getCycles(uint16_t addr) { return counters ? counters->cycles[addr] : 0; }
+
+    //! @brief    Returns the number of times an instruction has been executed
+    uint64_t getInstructions(uint16_t addr) { return counters ? counters->instructions[addr] : 0; }
+
+    //! @brief    Returns the number of cycles spent inside a function including its callees
+    uint64_t getInclusiveCycles(uint16_t entry) { return counters ? counters->inclusive[entry] : 0; }
+
+    /*! @brief    Called by the CPU when an opcode has been fetched
+     *  @param    sp  Stack pointer before the instruction is executed
+     */
+    void fetch(uint16_t pc, uint8_t opcode, uint8_t sp, uint64_t cycle) {
+
+        enter(pc, sp, cycle);
+        if (interruptPending) {
+            interruptPending = false;
+            push(pc, pc, sp + 3, true, interruptCycle);
+        }
+
+        counters->instructions[pc]++;
+        executed++;
+        counters->function[pc] = depth ? stack[depth - 1].entry : noFunction;
+        lastPC = pc;
+        lastOpcode = opcode;
+        lastValid = true;
+    }
+
+    /*! @brief    Called by the CPU when it starts an IRQ or NMI sequence
+     *  @param    pc  Address of the instruction that is going to be executed after RTI
+     */
+    void interrupt(uint16_t pc, uint8_t sp, uint64_t cycle) {
+
+        enter(pc, sp, cycle);
+        lastValid = false;
+        interruptPending = true;
+        interruptCycle = cycle;
+    }
+
+    //! @brief    Writes a plain text report sorted by cycles
+    bool saveFlat(const char *path, const char *name);
+
+    //! @brief    Writes the collected data in callgrind format (KCachegrind, QCachegrind)
+    bool saveCallgrind(const char *path, const char *name);
+
+private:
+
+    //! @brief    Charges the elapsed cycles and updates the shadow stack
+    void enter(uint16_t pc, uint8_t sp, uint64_t cycle) {
+
+        if (lastValid) {
+            counters->cycles[lastPC] += cycle - lastCycle;
+        } else if (interruptPending) {
+            interruptSequenceCycles += cycle - lastCycle;
+        }
+        lastCycle = cycle;
+
+        if (depth && sp >= stack[depth - 1].sp) unwind(sp, cycle);
+
+        if (lastValid && lastOpcode == 0x20 /* JSR */) {
+            push(pc, lastPC, sp + 2, false, cycle);
+        } else if (lastValid && lastOpcode == 0x00 /* BRK */) {
+            push(pc, lastPC, sp + 3, true, cycle);
+        }
+        lastValid = false;
+    }
+
+    //! @brief    Pushes a frame onto the shadow stack
+    void push(uint16_t entry, uint16_t callSite, uint16_t sp, bool interrupt, uint64_t cycle);
+
+    //! @brief    Pops all frames that have been left
+    void unwind(uint8_t sp, uint64_t cycle);
+};
+
+#endif
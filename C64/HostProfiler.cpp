@@ -0,0 +1,159 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "C64.h"
+
+HostProfiler::HostProfiler(C64 *c64)
+{
+    setDescription("HostProfiler");
+    debug(3, "  Creating host profiler at address %p...\n", this);
+
+    this->c64 = c64;
+    reset();
+}
+
+bool
+HostProfiler::isEnabled()
+{
+#ifdef VC64_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+HostProfiler::reset()
+{
+    current = PROF_OTHER;
+    memset(ticks, 0, sizeof(ticks));
+    frames = 0;
+    frameTicks = frameTicksMax = 0;
+    frameTicksMin = UINT64_MAX;
+    previousFrameTicks = 0;
+    frameJitter = frameJitterMax = 0;
+    syncs = 0;
+    syncJitter = syncJitterMax = 0;
+
+    calibrationTick = tick();
+    calibrationNanos = nanos();
+    lastTick = frameStart = calibrationTick;
+}
+
+HostProfilerInfo
+HostProfiler::getInfo()
+{
+    HostProfilerInfo info;
+
+    // Determine the length of a tick by comparing with the system clock
+    uint64_t elapsedTicks = tick() - calibrationTick;
+    uint64_t elapsedNanos = nanos() - calibrationNanos;
+    double nanosPerTick = elapsedTicks ? (double)elapsedNanos / elapsedTicks : 1.0;
+    #define NS(x) ((uint64_t)((x) * nanosPerTick))
+
+    info.enabled = isEnabled();
+    info.frames = frames;
+    info.totalTime = 0;
+    for (unsigned i = 0; i < PROF_COMPONENTS; i++) {
+        info.componentTime[i] = NS(ticks[i]);
+        info.totalTime += info.componentTime[i];
+    }
+    info.frameTimeAvg = frames ? NS(frameTicks / frames) : 0;
+    info.frameTimeMin = frames ? NS(frameTicksMin) : 0;
+    info.frameTimeMax = NS(frameTicksMax);
+    info.frameJitterAvg = frames > 1 ? NS(frameJitter / (frames - 1)) : 0;
+    info.frameJitterMax = NS(frameJitterMax);
+    info.syncJitterAvg = syncs ? syncJitter / syncs : 0;
+    info.syncJitterMax = syncJitterMax;
+
+    #undef NS
+    return info;
+}
+
+void
+HostProfiler::dumpState()
+{
+    static const char *names[PROF_COMPONENTS] = {
+        "VIC", "PixelEngine", "CPU", "VC1541", "VIAs", "CIAs",
+        "SID", "Datasette", "Snapshots", "Other" };
+
+    HostProfilerInfo info = getInfo();
+
+    msg("HostProfiler:\n");
+    msg("-------------\n");
+    if (!info.enabled) {
+        msg("  Not available (build with VC64_PROFILE)\n\n");
+        return;
+    }
+    for (unsigned i = 0; i < PROF_COMPONENTS; i++) {
+        msg("%14s : %8.2f ms (%5.1f %%)\n", names[i],
+            info.componentTime[i] / 1000000.0,
+            info.totalTime ? 100.0 * info.componentTime[i] / info.totalTime : 0.0);
+    }
+    msg("        Frames : %llu\n", (unsigned long long)info.frames);
+    msg("    Frame time : %.3f ms (min %.3f ms, max %.3f ms)\n",
+        info.frameTimeAvg / 1000000.0, info.frameTimeMin / 1000000.0, info.frameTimeMax / 1000000.0);
+    msg("  Frame jitter : %.3f ms (max %.3f ms)\n",
+        info.frameJitterAvg / 1000000.0, info.frameJitterMax / 1000000.0);
+    msg("   Sync jitter : %.3f ms (max %.3f ms)\n",
+        info.syncJitterAvg / 1000000.0, info.syncJitterMax / 1000000.0);
+    msg("\n");
+}
+
+void
+HostProfiler::beginFrame()
+{
+    lastTick = frameStart = tick();
+}
+
+void
+HostProfiler::endFrame()
+{
+    uint64_t now = tick();
+    ticks[current] += now - lastTick;
+    lastTick = now;
+
+    uint64_t duration = now - frameStart;
+    frameTicks += duration;
+    frameTicksMin = MIN(frameTicksMin, duration);
+    frameTicksMax = MAX(frameTicksMax, duration);
+
+    if (frames > 0) {
+        uint64_t variation =
+        duration > previousFrameTicks ? duration - previousFrameTicks : previousFrameTicks - duration;
+        frameJitter += variation;
+        frameJitterMax = MAX(frameJitterMax, variation);
+    }
+    previousFrameTicks = duration;
+    frames++;
+
+    // Inform the GUI once per second
+    if (frames % c64->vic.getFramesPerSecond() == 0) {
+        c64->putMessage(MSG_PROFILE);
+    }
+    frameStart = now;
+}
+
+void
+HostProfiler::recordSyncJitter(int64_t jitter)
+{
+    uint64_t value = jitter > 0 ? (uint64_t)jitter : 0;
+    syncs++;
+    syncJitter += value;
+    syncJitterMax = MAX(syncJitterMax, value);
+}
@@ -0,0 +1,169 @@
+/*!
+ * @header      HostProfiler.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _HOSTPROFILER_INC
+#define _HOSTPROFILER_INC
+
+#include "VC64Object.h"
+#include "HostProfiler_types.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Forward declarations
+class C64;
+
+/*! @brief    Instrumentation hooks
+ *  @details  The hooks are only compiled in if VC64_PROFILE is defined. Otherwise, they
+ *            expand to nothing and the emulator runs at full speed.
+ *            PROFILE_SWITCH charges all host time from now on to the specified component.
+ *            PROFILE_SCOPE does the same for the rest of the enclosing block and switches
+ *            back to the previous component when the block is left.
+ */
+#ifdef VC64_PROFILE
+#define PROFILE_SWITCH(profiler, component) (profiler).switchTo(component)
+#define PROFILE_SCOPE(profiler, component) HostProfiler::Scope profileScope(&(profiler), component)
+#else
+#define PROFILE_SWITCH(profiler, component)
+#define PROFILE_SCOPE(profiler, component)
+#endif
+
+/*! @class    HostProfiler
+ *  @brief    Measures where host time goes inside the run loop
+ *  @details  At any time, exactly one component is active. All host time elapsing until
+ *            the next switch is charged to this component. On x86 hosts, time is measured
+ *            with the time stamp counter which is much cheaper to read than the system
+ *            clock. The tick counts are converted to nanoseconds in getInfo().
+ *
+ *            In addition, the profiler measures the host time spent on each frame and
+ *            how much it varies from frame to frame. The time spent sleeping in
+ *            C64::synchronizeTiming() is not part of any measurement.
+ */
+class HostProfiler : public VC64Object {
+
+public:
+
+    //! @brief    Switches to another component until the enclosing block is left
+    class Scope {
+
+        HostProfiler *profiler;
+        ProfiledComponent previous;
+
+    public:
+
+        Scope(HostProfiler *p, ProfiledComponent c) : profiler(p) {
+            previous = profiler->switchTo(c);
+        }
+        ~Scope() { profiler->switchTo(previous); }
+    };
+
+private:
+
+    //! @brief    Reference to the virtual C64 (used for posting messages)
+    C64 *c64;
+
+    //! @brief    Component the elapsed time is charged to
+    ProfiledComponent current;
+
+    //! @brief    Tick count at the time of the most recent switch
+    uint64_t lastTick;
+
+    //! @brief    Accumulated ticks per component
+    uint64_t ticks[PROF_COMPONENTS];
+
+    //! @brief    Tick count at the beginning of the current frame
+    uint64_t frameStart;
+
+    //! @brief    Number of measured frames
+    uint64_t frames;
+
+    //! @brief    Accumulated, minimal, and maximal frame time in ticks
+    uint64_t frameTicks, frameTicksMin, frameTicksMax;
+
+    //! @brief    Duration of the previous frame in ticks
+    uint64_t previousFrameTicks;
+
+    //! @brief    Accumulated and maximal frame to frame variation in ticks
+    uint64_t frameJitter, frameJitterMax;
+
+    //! @brief    Number of synchronizations with the real time clock
+    uint64_t syncs;
+
+    //! @brief    Accumulated and maximal overshoot of sleepUntil() in nanoseconds
+    uint64_t syncJitter, syncJitterMax;
+
+    //! @brief    Reference values for converting ticks to nanoseconds
+    uint64_t calibrationTick, calibrationNanos;
+
+public:
+
+    //! @brief    Constructor
+    HostProfiler(C64 *c64);
+
+    //! @brief    Returns true iff the emulator has been built with VC64_PROFILE
+    static bool isEnabled();
+
+    //! @brief    Discards all measured data
+    void reset();
+
+    //! @brief    Returns the measured data
+    HostProfilerInfo getInfo();
+
+    //! @brief    Prints the measured data
+    void dumpState();
+
+    //! @brief    Reads the host's cycle counter
+    static uint64_t tick() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return nanos();
+#endif
+    }
+
+    /*! @brief    Charges the elapsed time to the active component and activates another
+     *  @return   The previously active component
+     */
+    ProfiledComponent switchTo(ProfiledComponent component) {
+        uint64_t now = tick();
+        ProfiledComponent result = current;
+        ticks[current] += now - lastTick;
+        lastTick = now;
+        current = component;
+        return result;
+    }
+
+    /*! @brief    Starts a new frame measurement
+     *  @details  Called when the emulator starts running and after each synchronization
+     *            with the real time clock. The time in between is not measured.
+     */
+    void beginFrame();
+
+    /*! @brief    Finishes the current frame measurement
+     *  @details  Once per second, MSG_PROFILE is posted.
+     */
+    void endFrame();
+
+    //! @brief    Records the overshoot of a synchronization with the real time clock
+    void recordSyncJitter(int64_t jitter);
+};
+
+#endif
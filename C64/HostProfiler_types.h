@@ -0,0 +1,51 @@
+//
+//  HostProfiler_types.h
+//  V64
+//
+//  Created by Dirk Hoffmann
+//
+
+#ifndef HOSTPROFILER_TYPES_H
+#define HOSTPROFILER_TYPES_H
+
+#include <stdint.h>
+
+/*! @brief    Components distinguished by the host time profiler
+ *  @details  PROF_DATASETTE includes the computation of the next wake up cycle which
+ *            is done in the same pass. PROF_OTHER covers everything that is not listed
+ *            explicitly, e.g., the bookkeeping in C64::endOfFrame() and the IEC bus.
+ */
+typedef enum {
+    PROF_VIC,
+    PROF_PIXEL_ENGINE,
+    PROF_CPU,
+    PROF_VC1541,
+    PROF_VIA,
+    PROF_CIA,
+    PROF_SID,
+    PROF_DATASETTE,
+    PROF_SNAPSHOT,
+    PROF_OTHER,
+    PROF_COMPONENTS
+} ProfiledComponent;
+
+/*! @brief    Host time profiler info
+ *  @details  Used by HostProfiler::getInfo() to collect the measured data. All times
+ *            are given in nanoseconds. Frame times exclude the time spent sleeping in
+ *            C64::synchronizeTiming().
+ */
+typedef struct {
+    bool enabled;
+    uint64_t frames;
+    uint64_t componentTime[PROF_COMPONENTS];
+    uint64_t totalTime;
+    uint64_t frameTimeAvg;
+    uint64_t frameTimeMin;
+    uint64_t frameTimeMax;
+    uint64_t frameJitterAvg;
+    uint64_t frameJitterMax;
+    uint64_t syncJitterAvg;
+    uint64_t syncJitterMax;
+} HostProfilerInfo;
+
+#endif
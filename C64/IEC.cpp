@@ -192,11 +192,10 @@ bool IEC::_updateIecLines()
     bool deviceClock = (deviceBits & 0x08) ? 1 : 0;
     bool deviceData = (deviceBits & 0x02) ? 1 : 0;
 
-    // Get bus signals from c64 side
-    uint8_t ciaBits = c64->cia2.PA;
-    bool ciaAtn = (ciaBits & 0x08) ? 1 : 0;
-    bool ciaClock = (ciaBits & 0x10) ? 1 : 0;
-    bool ciaData = (ciaBits & 0x20) ? 1 : 0;
+    // Get bus signals from c64 side (pins configured as inputs are pulled up)
+    bool ciaAtn = ciaAtnIsOutput ? !ciaAtnPin : 1;
+    bool ciaClock = ciaClockIsOutput ? !ciaClockPin : 1;
+    bool ciaData = ciaDataIsOutput ? !ciaDataPin : 1;
     
     // Compute bus signals (inverted and "wired AND")
     atnLine = !ciaAtn;
@@ -260,12 +259,27 @@ void IEC::updateCiaPins(uint8_t cia_data, uint8_t cia_direction)
 {
 	// 0 is dominant on the bus. A single 0-source brings the signal down
 	
-	ciaAtnIsOutput = (cia_direction & 0x08) ? 1 : 0;
-	ciaClockIsOutput = (cia_direction & 0x10) ? 1 : 0;
-	ciaDataIsOutput = (cia_direction & 0x20) ? 1 : 0;
-	ciaAtnPin = (cia_data & 0x08) ? 0 : 1; // Pin and line are connected via an inverter
-	ciaClockPin = (cia_data & 0x10) ? 0 : 1; // Pin and line are connected via an inverter
-	ciaDataPin = (cia_data & 0x20) ? 0 : 1; // Pin and line are connected via an inverter
+    bool atnIsOutput = (cia_direction & 0x08) ? 1 : 0;
+    bool clockIsOutput = (cia_direction & 0x10) ? 1 : 0;
+    bool dataIsOutput = (cia_direction & 0x20) ? 1 : 0;
+    bool atnPin = (cia_data & 0x08) ? 0 : 1; // Pin and line are connected via an inverter
+    bool clockPin = (cia_data & 0x10) ? 0 : 1; // Pin and line are connected via an inverter
+    bool dataPin = (cia_data & 0x20) ? 0 : 1; // Pin and line are connected via an inverter
+    
+    // A sleeping drive needs to catch up before it can see the new values
+    if (c64->floppy.isSleeping() &&
+        (atnIsOutput != ciaAtnIsOutput || clockIsOutput != ciaClockIsOutput ||
+         dataIsOutput != ciaDataIsOutput || atnPin != ciaAtnPin ||
+         clockPin != ciaClockPin || dataPin != ciaDataPin)) {
+        c64->floppy.wakeUp();
+    }
+    
+    ciaAtnIsOutput = atnIsOutput;
+    ciaClockIsOutput = clockIsOutput;
+    ciaDataIsOutput = dataIsOutput;
+    ciaAtnPin = atnPin;
+    ciaClockPin = clockPin;
+    ciaDataPin = dataPin;
 		
 	updateIecLines(); 
 }
@@ -0,0 +1,167 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "InstructionTrace.h"
+
+static_assert(sizeof(TraceRecord) == 24, "Trace records must be 24 bytes in size");
+static_assert(sizeof(InstructionTrace::FileHeader) == 16, "Trace file header must be 16 bytes in size");
+
+InstructionTrace::InstructionTrace()
+{
+    setDescription("InstructionTrace");
+
+    ring = NULL;
+    capacity = 0;
+    count = 0;
+    flushed = 0;
+    file = NULL;
+    model = MOS_6510;
+}
+
+InstructionTrace::~InstructionTrace()
+{
+    disable();
+}
+
+bool
+InstructionTrace::enable(CPUChipModel cpuModel, size_t records)
+{
+    disable();
+
+    // Round up to the next power of 2
+    size_t size = 1;
+    while (size < records) size <<= 1;
+
+    if ((ring = (TraceRecord *)malloc(size * sizeof(TraceRecord))) == NULL) {
+        warn("Cannot allocate %ld trace records\n", size);
+        return false;
+    }
+    capacity = size;
+    count = 0;
+    flushed = 0;
+    model = cpuModel;
+    return true;
+}
+
+void
+InstructionTrace::disable()
+{
+    closeFile();
+    free(ring);
+    ring = NULL;
+    capacity = 0;
+    count = 0;
+    flushed = 0;
+}
+
+bool
+InstructionTrace::openFile(const char *path, CPUChipModel cpuModel)
+{
+    closeFile();
+
+    if (!isEnabled() && !enable(cpuModel))
+        return false;
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL || !writeHeader(f, model)) {
+        warn("Cannot write trace file %s\n", path);
+        if (f) fclose(f);
+        return false;
+    }
+
+    file = f;
+    flushed = count - numRecords();
+    return true;
+}
+
+void
+InstructionTrace::closeFile()
+{
+    if (file == NULL)
+        return;
+
+    flush();
+    fclose(file);
+    file = NULL;
+}
+
+bool
+InstructionTrace::save(const char *path)
+{
+    if (!isEnabled())
+        return false;
+
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        warn("Cannot write trace file %s\n", path);
+        return false;
+    }
+
+    bool result = writeHeader(f, model);
+    for (size_t i = 0; result && i < numRecords(); i++) {
+        result = fwrite(&getRecord(i), sizeof(TraceRecord), 1, f) == 1;
+    }
+    fclose(f);
+    return result;
+}
+
+bool
+InstructionTrace::readHeader(FILE *f, FileHeader *header)
+{
+    if (fread(header, sizeof(FileHeader), 1, f) != 1)
+        return false;
+
+    return
+    memcmp(header->magic, "VC64TRC", 8) == 0 &&
+    header->version == fileVersion &&
+    header->recordSize == sizeof(TraceRecord);
+}
+
+bool
+InstructionTrace::writeHeader(FILE *f, CPUChipModel cpuModel)
+{
+    FileHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "VC64TRC", 8);
+    header.version = fileVersion;
+    header.recordSize = sizeof(TraceRecord);
+    header.cpuModel = (uint8_t)cpuModel;
+
+    return fwrite(&header, sizeof(header), 1, f) == 1;
+}
+
+void
+InstructionTrace::flush()
+{
+    assert(file != NULL);
+    assert(count - flushed <= capacity);
+
+    // The pending records occupy at most two contiguous areas of the ring buffer
+    while (flushed < count) {
+        size_t start = flushed & (capacity - 1);
+        size_t n = MIN((size_t)(count - flushed), capacity - start);
+        if (fwrite(&ring[start], sizeof(TraceRecord), n, file) != n) {
+            warn("Cannot write trace file. Streaming stopped.\n");
+            fclose(file);
+            file = NULL;
+            return;
+        }
+        flushed += n;
+    }
+}
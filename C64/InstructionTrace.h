@@ -0,0 +1,143 @@
+/*!
+ * @header      InstructionTrace.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _INSTRUCTIONTRACE_INC
+#define _INSTRUCTIONTRACE_INC
+
+#include "VC64Object.h"
+
+/*! @class    InstructionTrace
+ *  @brief    Binary trace of the executed instructions of a single CPU
+ *  @details  In contrast to the text based trace(), recording an instruction only copies
+ *            a fixed size TraceRecord into a ring buffer. Formatting is deferred to the
+ *            time the trace is examined (see CPU::disassemble(const TraceRecord &, bool)).
+ *
+ *            By default, the ring buffer keeps the most recent records only. If a trace
+ *            file is opened, the buffer is written to the file whenever it runs full and
+ *            no record is lost.
+ *
+ *            A trace file starts with a 16 byte header (magic "VC64TRC", format version,
+ *            record size, and the CPU model) followed by the records in host byte order.
+ */
+class InstructionTrace : public VC64Object {
+
+public:
+
+    //! @brief    Default number of records in the ring buffer (must be a power of 2)
+    static const size_t defaultCapacity = 1 << 20;
+
+    //! @brief    Version of the trace file format
+    static const uint16_t fileVersion = 1;
+
+    //! @brief    Header of a trace file
+    typedef struct {
+        char magic[8];
+        uint16_t version;
+        uint16_t recordSize;
+        uint8_t cpuModel;
+        uint8_t reserved[3];
+    } FileHeader;
+
+private:
+
+    //! @brief    Ring buffer (NULL if tracing is disabled)
+    TraceRecord *ring;
+
+    //! @brief    Number of records in the ring buffer (a power of 2)
+    size_t capacity;
+
+    //! @brief    Number of records written since tracing has been enabled
+    uint64_t count;
+
+    //! @brief    Number of records written to the trace file
+    uint64_t flushed;
+
+    //! @brief    Trace file (NULL if the trace is kept in memory only)
+    FILE *file;
+
+    //! @brief    CPU model stored in the file header
+    CPUChipModel model;
+
+public:
+
+    //! @brief    Constructor
+    InstructionTrace();
+
+    //! @brief    Destructor
+    ~InstructionTrace();
+
+    //! @brief    Returns true iff instructions are recorded
+    bool isEnabled() { return ring != NULL; }
+
+    /*! @brief    Starts recording into the ring buffer
+     *  @param    records  Size of the ring buffer (rounded up to a power of 2)
+     */
+    bool enable(CPUChipModel cpuModel, size_t records = defaultCapacity);
+
+    //! @brief    Stops recording, closes the trace file, and frees the ring buffer
+    void disable();
+
+    /*! @brief    Starts streaming into a trace file
+     *  @details  Enables recording if necessary. Records that are already in the ring
+     *            buffer are written to the file first.
+     */
+    bool openFile(const char *path, CPUChipModel cpuModel);
+
+    //! @brief    Writes all pending records and closes the trace file
+    void closeFile();
+
+    //! @brief    Writes the contents of the ring buffer into a trace file
+    bool save(const char *path);
+
+    //! @brief    Returns the number of records written since tracing has been enabled
+    uint64_t numRecorded() { return count; }
+
+    //! @brief    Returns the number of records available in the ring buffer
+    size_t numRecords() { return count < capacity ? (size_t)count : capacity; }
+
+    //! @brief    Returns a record from the ring buffer (0 = oldest available)
+    const TraceRecord &getRecord(size_t nr) {
+        assert(nr < numRecords());
+        return ring[(count - numRecords() + nr) & (capacity - 1)];
+    }
+
+    /*! @brief    Returns the slot for the next record
+     *  @details  The caller is expected to fill in all fields.
+     */
+    TraceRecord *nextRecord() {
+        if (file && count - flushed == capacity) flush();
+        return &ring[count++ & (capacity - 1)];
+    }
+
+    /*! @brief    Reads the header of a trace file
+     *  @return   false, if the file is not a trace file of a supported version
+     */
+    static bool readHeader(FILE *f, FileHeader *header);
+
+private:
+
+    //! @brief    Writes the file header
+    bool writeHeader(FILE *f, CPUChipModel cpuModel);
+
+    //! @brief    Writes all records that are not yet in the trace file
+    void flush();
+};
+
+#endif
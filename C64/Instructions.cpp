@@ -453,12 +453,42 @@ void CPU::registerInstructions()
 	registerIllegalInstructions();	
 }
 
+/* Dispatching microinstructions
+ *
+ * By default, the next microinstruction is selected by a switch statement. If
+ * VC64_THREADED_DISPATCH is defined, the switch is bypassed and the CPU jumps
+ * directly to the requested microinstruction via a jump table of label
+ * addresses (computed goto). Both variants execute the very same code for each
+ * microinstruction. The jump table saves the range check of the switch
+ * statement and gives the compiler a dedicated indirect branch per call site.
+ */
+#ifdef VC64_THREADED_DISPATCH
+
+#ifndef __GNUC__
+#error "VC64_THREADED_DISPATCH requires a compiler supporting labels as values"
+#endif
+
+#define CASE(x) label_##x
+#define CASE_ADDRESS(x) &&label_##x,
+
+#else
+
+#define CASE(x) case x
+
+#endif
+
 bool
 CPU::executeOneCycle()
 {
+#ifdef VC64_THREADED_DISPATCH
+    static void *const jumpTable[] = { MICRO_INSTRUCTIONS(CASE_ADDRESS) };
+    assert(next < sizeof(jumpTable) / sizeof(jumpTable[0]));
+    goto *jumpTable[next];
+#endif
+
     switch (next) {
             
-        case fetch:
+        CASE(fetch):
             
             /* DEBUG */
             /*
@@ -473,25 +503,35 @@ CPU::executeOneCycle()
             if (doNmi) {
                 
                 if (tracingEnabled()) trace("NMI (source = %02X)\n", nmiLine);
+                if (binaryTrace.isEnabled()) recordInstruction(TRACE_NMI);
+                if (guestProfiler.isEnabled()) guestProfiler.interrupt(PC, SP, c64->getCycles());
                 clear8_delayed(edgeDetector);
                 next = nmi_2;
                 doNmi = false;
                 doIrq = false; // NMI wins
-                return true;
+                return !haltOnWatchpoint();
                 
             } else if (doIrq) {
                 
                 if (tracingEnabled()) trace("IRQ (source = %02X)\n", irqLine);
+                if (binaryTrace.isEnabled()) recordInstruction(TRACE_IRQ);
+                if (guestProfiler.isEnabled()) guestProfiler.interrupt(PC, SP, c64->getCycles());
                 next = irq_2;
                 doIrq = false;
-                return true;
+                return !haltOnWatchpoint();
             }
             
             // Execute fetch phase
             FETCH_OPCODE
             next = actionFunc[opcode];
             
-            // Disassemble command if requested
+            // Record or disassemble command if requested
+            if (binaryTrace.isEnabled()) {
+                recordInstruction(TRACE_INSTRUCTION);
+            }
+            if (guestProfiler.isEnabled()) {
+                guestProfiler.fetch(PC_at_cycle_0, opcode, SP, c64->getCycles());
+            }
             if (tracingEnabled()) {
                 DisassembledInstruction instr = disassemble(true /* hex output */);
                 trace("%s: %s %s %s   %s %s %s %s %s %s\n",
@@ -508,24 +548,39 @@ CPU::executeOneCycle()
                     // Soft breakpoints get deleted when reached
                     breakpoint[PC_at_cycle_0] &= ~SOFT_BREAKPOINT;
                     setErrorState(CPU_SOFT_BREAKPOINT_REACHED);
-                } else {
+                    debug(1, "Breakpoint reached\n");
+                    return false;
+                }
+                if (breakpoint[PC_at_cycle_0] & HARD_BREAKPOINT) {
                     setErrorState(CPU_HARD_BREAKPOINT_REACHED);
+                    debug(1, "Breakpoint reached\n");
+                    return false;
+                }
+                if ((breakpoint[PC_at_cycle_0] & WATCHPOINT) &&
+                    c64->mem.checkWatchpoints(PC_at_cycle_0, opcode, WATCH_EXECUTE)) {
+                    setErrorState(CPU_WATCHPOINT_REACHED);
+                    debug(1, "Watchpoint reached\n");
+                    return false;
+                }
+                if (breakpoint[PC_at_cycle_0] & ROM_TRAP) {
+                    // If the virtual drive emulates the routine, it sets up the return address
+                    (void)c64->virtualDrive.trap(PC_at_cycle_0);
                 }
-                debug(1, "Breakpoint reached\n");
-                return false;
             }
-            return true;
+            
+            // Halt if a read or write watchpoint has triggered in the previous instruction
+            return !haltOnWatchpoint();
             
         // -------------------------------------------------------------------------------
         // Illegal instructions
         // -------------------------------------------------------------------------------
             
-        case JAM:
+        CASE(JAM):
             
             setErrorState(CPU_ILLEGAL_INSTRUCTION);
             CONTINUE
 
-        case JAM_2:
+        CASE(JAM_2):
             POLL_INT
             DONE
 
@@ -533,22 +588,22 @@ CPU::executeOneCycle()
         // IRQ handling
         // -------------------------------------------------------------------------------
 
-        case irq:
+        CASE(irq):
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case irq_2:
+        CASE(irq_2):
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case irq_3:
+        CASE(irq_3):
             
             mem->poke(0x100+(SP--), HI_BYTE(PC));
             CONTINUE
             
-        case irq_4:
+        CASE(irq_4):
             
             mem->poke(0x100+(SP--), LO_BYTE(PC));
             
@@ -564,18 +619,18 @@ CPU::executeOneCycle()
             }
             CONTINUE
             
-        case irq_5:
+        CASE(irq_5):
             
             mem->poke(0x100+(SP--), getPWithClearedB());
             setI(1);
             CONTINUE
             
-        case irq_6:
+        CASE(irq_6):
             
             data = mem->peek(0xFFFE);
             CONTINUE
             
-        case irq_7:
+        CASE(irq_7):
             
             setPCL(data);
             setPCH(mem->peek(0xFFFF));
@@ -585,38 +640,38 @@ CPU::executeOneCycle()
         // NMI handling
         // -------------------------------------------------------------------------------
             
-        case nmi:
+        CASE(nmi):
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case nmi_2:
+        CASE(nmi_2):
 
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case nmi_3:
+        CASE(nmi_3):
             
             mem->poke(0x100+(SP--), HI_BYTE(PC));
             CONTINUE
             
-        case nmi_4:
+        CASE(nmi_4):
             
             mem->poke(0x100+(SP--), LO_BYTE(PC));
             CONTINUE
             
-        case nmi_5:
+        CASE(nmi_5):
             
             mem->poke(0x100+(SP--), getPWithClearedB());
             setI(1);
             CONTINUE
             
-        case nmi_6:
+        CASE(nmi_6):
             
             data = mem->peek(0xFFFA);
             CONTINUE
             
-        case nmi_7:
+        CASE(nmi_7):
             
             setPCL(data);
             setPCH(mem->peek(0xFFFB));
@@ -632,7 +687,7 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case ADC_imm:
+        CASE(ADC_imm):
 
             READ_IMMEDIATE
             adc(data);
@@ -640,12 +695,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ADC_zpg:
+        CASE(ADC_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ADC_zpg_2:
+        CASE(ADC_zpg_2):
             
             READ_FROM_ZERO_PAGE
             adc(data);
@@ -653,18 +708,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ADC_zpg_x:
+        CASE(ADC_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ADC_zpg_x_2:
+        CASE(ADC_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case ADC_zpg_x_3:
+        CASE(ADC_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             adc(data);
@@ -672,17 +727,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ADC_abs:
+        CASE(ADC_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ADC_abs_2:
+        CASE(ADC_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case ADC_abs_3:
+        CASE(ADC_abs_3):
             
             READ_FROM_ADDRESS
             adc(data);
@@ -690,18 +745,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ADC_abs_x:
+        CASE(ADC_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ADC_abs_x_2:
+        CASE(ADC_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ADC_abs_x_3:
+        CASE(ADC_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -713,7 +768,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ADC_abs_x_4:
+        CASE(ADC_abs_x_4):
             
             READ_FROM_ADDRESS
             adc(data);
@@ -721,18 +776,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ADC_abs_y:
+        CASE(ADC_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ADC_abs_y_2:
+        CASE(ADC_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case ADC_abs_y_3:
+        CASE(ADC_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -744,7 +799,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ADC_abs_y_4:
+        CASE(ADC_abs_y_4):
             
             READ_FROM_ADDRESS
             adc(data);
@@ -752,28 +807,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ADC_ind_x:
+        CASE(ADC_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ADC_ind_x_2:
+        CASE(ADC_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ADC_ind_x_3:
+        CASE(ADC_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ADC_ind_x_4:
+        CASE(ADC_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ADC_ind_x_5:
+        CASE(ADC_ind_x_5):
             
             READ_FROM_ADDRESS
             adc(data);
@@ -781,23 +836,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ADC_ind_y:
+        CASE(ADC_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ADC_ind_y_2:
+        CASE(ADC_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ADC_ind_y_3:
+        CASE(ADC_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y;
             CONTINUE
             
-        case ADC_ind_y_4:
+        CASE(ADC_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -809,7 +864,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ADC_ind_y_5:
+        CASE(ADC_ind_y_5):
             
             READ_FROM_ADDRESS
             adc(data);
@@ -825,7 +880,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case AND_imm:
+        CASE(AND_imm):
             
             READ_IMMEDIATE
             loadA(A & data);
@@ -833,29 +888,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case AND_abs:
+        CASE(AND_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case AND_abs_2:
+        CASE(AND_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case AND_abs_3:
+        CASE(AND_abs_3):
             READ_FROM_ADDRESS
             loadA(A & data);
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case AND_zpg:
+        CASE(AND_zpg):
 
             FETCH_ADDR_LO
             CONTINUE
 
-        case AND_zpg_2:
+        CASE(AND_zpg_2):
 
             READ_FROM_ZERO_PAGE
             loadA(A & data);
@@ -863,18 +918,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case AND_zpg_x:
+        CASE(AND_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case AND_zpg_x_2:
+        CASE(AND_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case AND_zpg_x_3:
+        CASE(AND_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             loadA(A & data);
@@ -882,18 +937,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case AND_abs_x:
+        CASE(AND_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case AND_abs_x_2:
+        CASE(AND_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case AND_abs_x_3:
+        CASE(AND_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -905,7 +960,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case AND_abs_x_4:
+        CASE(AND_abs_x_4):
             
             READ_FROM_ADDRESS
             loadA(A & data);
@@ -913,18 +968,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case AND_abs_y:
+        CASE(AND_abs_y):
             
             FETCH_ADDR_LO;
             CONTINUE
             
-        case AND_abs_y_2:
+        CASE(AND_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case AND_abs_y_3:
+        CASE(AND_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -936,7 +991,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case AND_abs_y_4:
+        CASE(AND_abs_y_4):
         
             READ_FROM_ADDRESS
             loadA(A & data);
@@ -944,28 +999,28 @@ CPU::executeOneCycle()
             DONE
         
         // -------------------------------------------------------------------------------
-        case AND_ind_x:
+        CASE(AND_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case AND_ind_x_2:
+        CASE(AND_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case AND_ind_x_3:
+        CASE(AND_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case AND_ind_x_4:
+        CASE(AND_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case AND_ind_x_5:
+        CASE(AND_ind_x_5):
             
             READ_FROM_ADDRESS
             loadA(A & data);
@@ -973,23 +1028,23 @@ CPU::executeOneCycle()
             DONE
             
         // -------------------------------------------------------------------------------
-        case AND_ind_y:
+        CASE(AND_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case AND_ind_y_2:
+        CASE(AND_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case AND_ind_y_3:
+        CASE(AND_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case AND_ind_y_4:
+        CASE(AND_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1001,7 +1056,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case AND_ind_y_5:
+        CASE(AND_ind_y_5):
             
             READ_FROM_ADDRESS
             loadA(A & data);
@@ -1020,7 +1075,7 @@ CPU::executeOneCycle()
         #define DO_ASL setC(data & 128); data = data << 1;
 
         // -------------------------------------------------------------------------------
-        case ASL_acc:
+        CASE(ASL_acc):
             
             IDLE_READ_IMPLIED
             setC(A & 128); loadA(A << 1);
@@ -1028,154 +1083,154 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ASL_zpg:
+        CASE(ASL_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ASL_zpg_2:
+        CASE(ASL_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ASL_zpg_3:
+        CASE(ASL_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_ASL
             CONTINUE
             
-        case ASL_zpg_4:
+        CASE(ASL_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ASL_zpg_x:
+        CASE(ASL_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ASL_zpg_x_2:
+        CASE(ASL_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case ASL_zpg_x_3:
+        CASE(ASL_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ASL_zpg_x_4:
+        CASE(ASL_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_ASL
             CONTINUE
             
-        case ASL_zpg_x_5:
+        CASE(ASL_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
         // -------------------------------------------------------------------------------
-        case ASL_abs:
+        CASE(ASL_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ASL_abs_2:
+        CASE(ASL_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case ASL_abs_3:
+        CASE(ASL_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ASL_abs_4:
+        CASE(ASL_abs_4):
             
             WRITE_TO_ADDRESS
             DO_ASL
             CONTINUE
             
-        case ASL_abs_5:
+        CASE(ASL_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ASL_abs_x:
+        CASE(ASL_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ASL_abs_x_2:
+        CASE(ASL_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ASL_abs_x_3:
+        CASE(ASL_abs_x_3):
             
             READ_FROM_ADDRESS;
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case ASL_abs_x_4:
+        CASE(ASL_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ASL_abs_x_5:
+        CASE(ASL_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_ASL
             CONTINUE
             
-        case ASL_abs_x_6:
+        CASE(ASL_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ASL_ind_x:
+        CASE(ASL_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ASL_ind_x_2:
+        CASE(ASL_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ASL_ind_x_3:
+        CASE(ASL_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ASL_ind_x_4:
+        CASE(ASL_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ASL_ind_x_5:
+        CASE(ASL_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ASL_ind_x_6:
+        CASE(ASL_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_ASL
             CONTINUE
             
-        case ASL_ind_x_7:
+        CASE(ASL_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -1192,20 +1247,20 @@ CPU::executeOneCycle()
 
         // void CPU::branch(int8_t offset) { PC += offset; }
             
-        case branch_3_underflow:
+        CASE(branch_3_underflow):
             
             IDLE_READ_FROM(PC + 0x100)
             POLL_INT_AGAIN
             DONE
             
-        case branch_3_overflow:
+        CASE(branch_3_overflow):
             
             IDLE_READ_FROM(PC - 0x100)
             POLL_INT_AGAIN
             DONE
 
         // ------------------------------------------------------------------------------
-        case BCC_rel:
+        CASE(BCC_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1216,7 +1271,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BCC_rel_2:
+        CASE(BCC_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1238,7 +1293,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case BCS_rel:
+        CASE(BCS_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1249,7 +1304,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BCS_rel_2:
+        CASE(BCS_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1271,7 +1326,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
             
-        case BEQ_rel:
+        CASE(BEQ_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1282,7 +1337,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BEQ_rel_2:
+        CASE(BEQ_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1304,12 +1359,12 @@ CPU::executeOneCycle()
         //              / / - - - /
         // -------------------------------------------------------------------------------
 
-        case BIT_zpg:
+        CASE(BIT_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case BIT_zpg_2:
+        CASE(BIT_zpg_2):
             
             READ_FROM_ZERO_PAGE
             setN(data & 128);
@@ -1319,17 +1374,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case BIT_abs:
+        CASE(BIT_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case BIT_abs_2:
+        CASE(BIT_abs_2):
             
             FETCH_ADDR_HI;
             CONTINUE
             
-        case BIT_abs_3:
+        CASE(BIT_abs_3):
             
             READ_FROM_ADDRESS
             setN(data & 128);
@@ -1347,7 +1402,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case BMI_rel:
+        CASE(BMI_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1358,7 +1413,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BMI_rel_2:
+        CASE(BMI_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1380,7 +1435,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
             
-        case BNE_rel:
+        CASE(BNE_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1391,7 +1446,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BNE_rel_2:
+        CASE(BNE_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1413,7 +1468,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case BPL_rel:
+        CASE(BPL_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1424,7 +1479,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BPL_rel_2:
+        CASE(BPL_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1446,18 +1501,18 @@ CPU::executeOneCycle()
         //              - - - 1 - -    1
         // -------------------------------------------------------------------------------
             
-        case BRK:
+        CASE(BRK):
             
             IDLE_READ_IMMEDIATE
             CONTINUE
             
-        case BRK_2:
+        CASE(BRK_2):
             
             setB(1);
             PUSH_PCH
             CONTINUE
             
-        case BRK_3:
+        CASE(BRK_3):
         
             PUSH_PCL
             
@@ -1475,17 +1530,17 @@ CPU::executeOneCycle()
                 CONTINUE
             }
             
-        case BRK_4:
+        CASE(BRK_4):
             
             PUSH_P
             CONTINUE
             
-        case BRK_5:
+        CASE(BRK_5):
             
             data = mem->peek(0xFFFE);
             CONTINUE
             
-        case BRK_6:
+        CASE(BRK_6):
             
             setPCL(data);
             setPCH(mem->peek(0xFFFF));
@@ -1496,17 +1551,17 @@ CPU::executeOneCycle()
                            // only IRQs can be triggered right after a BRK command, but not NMIs.
             DONE
             
-        case BRK_nmi_4:
+        CASE(BRK_nmi_4):
             
             PUSH_P
             CONTINUE
             
-        case BRK_nmi_5:
+        CASE(BRK_nmi_5):
             
             data = mem->peek(0xFFFA);
             CONTINUE
             
-        case BRK_nmi_6:
+        CASE(BRK_nmi_6):
             
             setPCL(data);
             setPCH(mem->peek(0xFFFB));
@@ -1523,7 +1578,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case BVC_rel:
+        CASE(BVC_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1534,7 +1589,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BVC_rel_2:
+        CASE(BVC_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1556,7 +1611,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case BVS_rel:
+        CASE(BVS_rel):
             
             READ_IMMEDIATE
             POLL_INT
@@ -1567,7 +1622,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case BVS_rel_2:
+        CASE(BVS_rel_2):
         {
             IDLE_READ_IMPLIED
             uint8_t pc_hi = HI_BYTE(PC);
@@ -1589,7 +1644,7 @@ CPU::executeOneCycle()
         //              - - 0 - - -
         // -------------------------------------------------------------------------------
 
-        case CLC:
+        CASE(CLC):
             
             IDLE_READ_IMPLIED
             setC(0);
@@ -1605,7 +1660,7 @@ CPU::executeOneCycle()
         //              - - - - 0 -
         // -------------------------------------------------------------------------------
 
-        case CLD:
+        CASE(CLD):
             
             IDLE_READ_IMPLIED
             setD(0);
@@ -1621,7 +1676,7 @@ CPU::executeOneCycle()
         //              - - - 0 - -
         // -------------------------------------------------------------------------------
 
-        case CLI:
+        CASE(CLI):
             
             IDLE_READ_IMPLIED
             POLL_INT
@@ -1637,7 +1692,7 @@ CPU::executeOneCycle()
         //              - - - - - 0
         // -------------------------------------------------------------------------------
 
-        case CLV:
+        CASE(CLV):
             
             IDLE_READ_IMPLIED
             setV(0);
@@ -1654,7 +1709,7 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case CMP_imm:
+        CASE(CMP_imm):
             
             READ_IMMEDIATE
             cmp(A, data);
@@ -1662,17 +1717,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CMP_abs:
+        CASE(CMP_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CMP_abs_2:
+        CASE(CMP_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case CMP_abs_3:
+        CASE(CMP_abs_3):
             
             READ_FROM_ADDRESS
             cmp(A, data);
@@ -1680,12 +1735,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CMP_zpg:
+        CASE(CMP_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CMP_zpg_2:
+        CASE(CMP_zpg_2):
             
             READ_FROM_ZERO_PAGE
             cmp(A, data);
@@ -1693,18 +1748,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CMP_zpg_x:
+        CASE(CMP_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CMP_zpg_x_2:
+        CASE(CMP_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case CMP_zpg_x_3:
+        CASE(CMP_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             cmp(A, data);
@@ -1712,18 +1767,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CMP_abs_x:
+        CASE(CMP_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CMP_abs_x_2:
+        CASE(CMP_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case CMP_abs_x_3:
+        CASE(CMP_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1735,7 +1790,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case CMP_abs_x_4:
+        CASE(CMP_abs_x_4):
             
             READ_FROM_ADDRESS
             cmp(A, data);
@@ -1743,18 +1798,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CMP_abs_y:
+        CASE(CMP_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CMP_abs_y_2:
+        CASE(CMP_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case CMP_abs_y_3:
+        CASE(CMP_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1766,7 +1821,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case CMP_abs_y_4:
+        CASE(CMP_abs_y_4):
             
             READ_FROM_ADDRESS
             cmp(A, data);
@@ -1774,28 +1829,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CMP_ind_x:
+        CASE(CMP_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case CMP_ind_x_2:
+        CASE(CMP_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case CMP_ind_x_3:
+        CASE(CMP_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case CMP_ind_x_4:
+        CASE(CMP_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case CMP_ind_x_5:
+        CASE(CMP_ind_x_5):
             
             READ_FROM_ADDRESS
             cmp(A, data);
@@ -1803,23 +1858,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CMP_ind_y:
+        CASE(CMP_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case CMP_ind_y_2:
+        CASE(CMP_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case CMP_ind_y_3:
+        CASE(CMP_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case CMP_ind_y_4:
+        CASE(CMP_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -1831,7 +1886,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case CMP_ind_y_5:
+        CASE(CMP_ind_y_5):
             
             READ_FROM_ADDRESS
             cmp(A, data);
@@ -1847,7 +1902,7 @@ CPU::executeOneCycle()
         //              / / / - - -
         // -------------------------------------------------------------------------------
 
-        case CPX_imm:
+        CASE(CPX_imm):
             
             READ_IMMEDIATE
             cmp(X, data);
@@ -1855,12 +1910,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CPX_zpg:
+        CASE(CPX_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CPX_zpg_2:
+        CASE(CPX_zpg_2):
             
             READ_FROM_ZERO_PAGE
             cmp(X, data);
@@ -1868,15 +1923,15 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CPX_abs:
+        CASE(CPX_abs):
             FETCH_ADDR_LO
             CONTINUE
             
-        case CPX_abs_2:
+        CASE(CPX_abs_2):
             FETCH_ADDR_HI
             CONTINUE
             
-        case CPX_abs_3:
+        CASE(CPX_abs_3):
             READ_FROM_ADDRESS
             cmp(X, data);
             POLL_INT
@@ -1891,7 +1946,7 @@ CPU::executeOneCycle()
         //              / / / - - -
         // -------------------------------------------------------------------------------
 
-        case CPY_imm:
+        CASE(CPY_imm):
             
             READ_IMMEDIATE
             cmp(Y, data);
@@ -1899,12 +1954,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CPY_zpg:
+        CASE(CPY_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CPY_zpg_2:
+        CASE(CPY_zpg_2):
             
             READ_FROM_ZERO_PAGE
             cmp(Y, data);
@@ -1912,17 +1967,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case CPY_abs:
+        CASE(CPY_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case CPY_abs_2:
+        CASE(CPY_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case CPY_abs_3:
+        CASE(CPY_abs_3):
             
             READ_FROM_ADDRESS
             cmp(Y, data);
@@ -1941,154 +1996,154 @@ CPU::executeOneCycle()
         #define DO_DEC data--;
 
         // -------------------------------------------------------------------------------
-        case DEC_zpg:
+        CASE(DEC_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DEC_zpg_2:
+        CASE(DEC_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case DEC_zpg_3:
+        CASE(DEC_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_DEC
             CONTINUE
             
-        case DEC_zpg_4:
+        CASE(DEC_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case DEC_zpg_x:
+        CASE(DEC_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DEC_zpg_x_2:
+        CASE(DEC_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case DEC_zpg_x_3:
+        CASE(DEC_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case DEC_zpg_x_4:
+        CASE(DEC_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_DEC
             CONTINUE
             
-        case DEC_zpg_x_5:
+        CASE(DEC_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case DEC_abs:
+        CASE(DEC_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DEC_abs_2:
+        CASE(DEC_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case DEC_abs_3:
+        CASE(DEC_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DEC_abs_4:
+        CASE(DEC_abs_4):
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DEC_abs_5:
+        CASE(DEC_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case DEC_abs_x:
+        CASE(DEC_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DEC_abs_x_2:
+        CASE(DEC_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case DEC_abs_x_3:
+        CASE(DEC_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case DEC_abs_x_4:
+        CASE(DEC_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DEC_abs_x_5:
+        CASE(DEC_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DEC_abs_x_6:
+        CASE(DEC_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case DEC_ind_x:
+        CASE(DEC_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case DEC_ind_x_2:
+        CASE(DEC_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case DEC_ind_x_3:
+        CASE(DEC_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case DEC_ind_x_4:
+        CASE(DEC_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case DEC_ind_x_5:
+        CASE(DEC_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DEC_ind_x_6:
+        CASE(DEC_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DEC_ind_x_7:
+        CASE(DEC_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -2103,7 +2158,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case DEX:
+        CASE(DEX):
             
             IDLE_READ_IMPLIED
             loadX(getX()-1);
@@ -2119,7 +2174,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case DEY:
+        CASE(DEY):
             
             IDLE_READ_IMPLIED
             loadY(getY()-1);
@@ -2135,7 +2190,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case EOR_imm:
+        CASE(EOR_imm):
             
             READ_IMMEDIATE
             loadA(A ^ data);
@@ -2143,17 +2198,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case EOR_abs:
+        CASE(EOR_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case EOR_abs_2:
+        CASE(EOR_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case EOR_abs_3:
+        CASE(EOR_abs_3):
             
             READ_FROM_ADDRESS
             loadA(A ^ data);
@@ -2161,12 +2216,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case EOR_zpg:
+        CASE(EOR_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case EOR_zpg_2:
+        CASE(EOR_zpg_2):
             
             READ_FROM_ZERO_PAGE
             loadA(A ^ data);
@@ -2174,18 +2229,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case EOR_zpg_x:
+        CASE(EOR_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case EOR_zpg_x_2:
+        CASE(EOR_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case EOR_zpg_x_3:
+        CASE(EOR_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             loadA(A ^ data);
@@ -2193,18 +2248,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case EOR_abs_x:
+        CASE(EOR_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case EOR_abs_x_2:
+        CASE(EOR_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case EOR_abs_x_3:
+        CASE(EOR_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2216,7 +2271,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case EOR_abs_x_4:
+        CASE(EOR_abs_x_4):
             
             READ_FROM_ADDRESS
             loadA(A ^ data);
@@ -2224,18 +2279,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case EOR_abs_y:
+        CASE(EOR_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case EOR_abs_y_2:
+        CASE(EOR_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case EOR_abs_y_3:
+        CASE(EOR_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2247,7 +2302,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case EOR_abs_y_4:
+        CASE(EOR_abs_y_4):
             
             READ_FROM_ADDRESS
             loadA(A ^ data);
@@ -2255,28 +2310,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case EOR_ind_x:
+        CASE(EOR_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case EOR_ind_x_2:
+        CASE(EOR_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case EOR_ind_x_3:
+        CASE(EOR_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case EOR_ind_x_4:
+        CASE(EOR_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case EOR_ind_x_5:
+        CASE(EOR_ind_x_5):
             
             READ_FROM_ADDRESS
             loadA(A ^ data);
@@ -2284,23 +2339,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case EOR_ind_y:
+        CASE(EOR_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case EOR_ind_y_2:
+        CASE(EOR_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case EOR_ind_y_3:
+        CASE(EOR_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case EOR_ind_y_4:
+        CASE(EOR_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2312,7 +2367,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case EOR_ind_y_5:
+        CASE(EOR_ind_y_5):
             
             READ_FROM_ADDRESS
             loadA(A ^ data);
@@ -2331,154 +2386,154 @@ CPU::executeOneCycle()
         #define DO_INC data++;
 
         // -------------------------------------------------------------------------------
-        case INC_zpg:
+        CASE(INC_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case INC_zpg_2:
+        CASE(INC_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case INC_zpg_3:
+        CASE(INC_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_INC
             CONTINUE
             
-        case INC_zpg_4:
+        CASE(INC_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case INC_zpg_x:
+        CASE(INC_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case INC_zpg_x_2:
+        CASE(INC_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case INC_zpg_x_3:
+        CASE(INC_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case INC_zpg_x_4:
+        CASE(INC_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_INC
             CONTINUE
             
-        case INC_zpg_x_5:
+        CASE(INC_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case INC_abs:
+        CASE(INC_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case INC_abs_2:
+        CASE(INC_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case INC_abs_3:
+        CASE(INC_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case INC_abs_4:
+        CASE(INC_abs_4):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case INC_abs_5:
+        CASE(INC_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case INC_abs_x:
+        CASE(INC_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case INC_abs_x_2:
+        CASE(INC_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case INC_abs_x_3:
+        CASE(INC_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case INC_abs_x_4:
+        CASE(INC_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case INC_abs_x_5:
+        CASE(INC_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case INC_abs_x_6:
+        CASE(INC_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case INC_ind_x:
+        CASE(INC_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case INC_ind_x_2:
+        CASE(INC_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case INC_ind_x_3:
+        CASE(INC_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case INC_ind_x_4:
+        CASE(INC_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case INC_ind_x_5:
+        CASE(INC_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case INC_ind_x_6:
+        CASE(INC_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case INC_ind_x_7:
+        CASE(INC_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -2493,7 +2548,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case INX:
+        CASE(INX):
             
             IDLE_READ_IMPLIED
             loadX(getX()+1);
@@ -2509,7 +2564,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case INY:
+        CASE(INY):
             
             IDLE_READ_IMPLIED
             loadY(getY()+1);
@@ -2525,12 +2580,12 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case JMP_abs:
+        CASE(JMP_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JMP_abs_2:
+        CASE(JMP_abs_2):
             
             FETCH_ADDR_HI
             setPC(LO_HI(addr_lo, addr_hi));
@@ -2538,22 +2593,22 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case JMP_abs_indirect:
+        CASE(JMP_abs_indirect):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JMP_abs_ind_2:
+        CASE(JMP_abs_ind_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case JMP_abs_ind_3:
+        CASE(JMP_abs_ind_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case JMP_abs_ind_4:
+        CASE(JMP_abs_ind_4):
             
             setPCL(data);
             setPCH(mem->peek(addr_lo+1, addr_hi));
@@ -2569,26 +2624,26 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
             
-        case JSR:
+        CASE(JSR):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case JSR_2:
+        CASE(JSR_2):
             
             CONTINUE
             
-        case JSR_3:
+        CASE(JSR_3):
             
             PUSH_PCH
             CONTINUE
             
-        case JSR_4:
+        CASE(JSR_4):
             
             PUSH_PCL
             CONTINUE
             
-        case JSR_5:
+        CASE(JSR_5):
             
             FETCH_ADDR_HI
             setPC(LO_HI(addr_lo, addr_hi));
@@ -2605,7 +2660,7 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case LDA_imm:
+        CASE(LDA_imm):
             
             READ_IMMEDIATE
             loadA(data);
@@ -2613,12 +2668,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDA_zpg:
+        CASE(LDA_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDA_zpg_2:
+        CASE(LDA_zpg_2):
             
             READ_FROM_ZERO_PAGE
             loadA(data);
@@ -2626,18 +2681,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDA_zpg_x:
+        CASE(LDA_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDA_zpg_x_2:
+        CASE(LDA_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case LDA_zpg_x_3:
+        CASE(LDA_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             loadA(data);
@@ -2645,17 +2700,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDA_abs:
+        CASE(LDA_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDA_abs_2:
+        CASE(LDA_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case LDA_abs_3:
+        CASE(LDA_abs_3):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -2663,18 +2718,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDA_abs_x:
+        CASE(LDA_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDA_abs_x_2:
+        CASE(LDA_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case LDA_abs_x_3:
+        CASE(LDA_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2686,7 +2741,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDA_abs_x_4:
+        CASE(LDA_abs_x_4):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -2694,18 +2749,18 @@ CPU::executeOneCycle()
             DONE
             
         // -------------------------------------------------------------------------------
-        case LDA_abs_y:
+        CASE(LDA_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDA_abs_y_2:
+        CASE(LDA_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case LDA_abs_y_3:
+        CASE(LDA_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2717,7 +2772,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDA_abs_y_4:
+        CASE(LDA_abs_y_4):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -2725,28 +2780,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDA_ind_x:
+        CASE(LDA_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LDA_ind_x_2:
+        CASE(LDA_ind_x_2):
 
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case LDA_ind_x_3:
+        CASE(LDA_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LDA_ind_x_4:
+        CASE(LDA_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case LDA_ind_x_5:
+        CASE(LDA_ind_x_5):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -2754,23 +2809,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDA_ind_y:
+        CASE(LDA_ind_y):
 
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LDA_ind_y_2:
+        CASE(LDA_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LDA_ind_y_3:
+        CASE(LDA_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case LDA_ind_y_4:
+        CASE(LDA_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2782,7 +2837,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDA_ind_y_5:
+        CASE(LDA_ind_y_5):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -2799,7 +2854,7 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case LDX_imm:
+        CASE(LDX_imm):
             
             READ_IMMEDIATE
             loadX(data);
@@ -2807,12 +2862,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDX_zpg:
+        CASE(LDX_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDX_zpg_2:
+        CASE(LDX_zpg_2):
             
             READ_FROM_ZERO_PAGE
             loadX(data);
@@ -2820,18 +2875,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDX_zpg_y:
+        CASE(LDX_zpg_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDX_zpg_y_2:
+        CASE(LDX_zpg_y_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_Y
             CONTINUE
             
-        case LDX_zpg_y_3:
+        CASE(LDX_zpg_y_3):
             
             READ_FROM_ZERO_PAGE
             loadX(data);
@@ -2839,17 +2894,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDX_abs:
+        CASE(LDX_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDX_abs_2:
+        CASE(LDX_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case LDX_abs_3:
+        CASE(LDX_abs_3):
             
             READ_FROM_ADDRESS
             loadX(data);
@@ -2857,18 +2912,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDX_abs_y:
+        CASE(LDX_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDX_abs_y_2:
+        CASE(LDX_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case LDX_abs_y_3:
+        CASE(LDX_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2880,7 +2935,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDX_abs_y_4:
+        CASE(LDX_abs_y_4):
             
             READ_FROM_ADDRESS
             loadX(data);
@@ -2888,28 +2943,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDX_ind_x:
+        CASE(LDX_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LDX_ind_x_2:
+        CASE(LDX_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case LDX_ind_x_3:
+        CASE(LDX_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LDX_ind_x_4:
+        CASE(LDX_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case LDX_ind_x_5:
+        CASE(LDX_ind_x_5):
             
             READ_FROM_ADDRESS
             loadX(data);
@@ -2917,23 +2972,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDX_ind_y:
+        CASE(LDX_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LDX_ind_y_2:
+        CASE(LDX_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LDX_ind_y_3:
+        CASE(LDX_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case LDX_ind_y_4:
+        CASE(LDX_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -2945,7 +3000,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDX_ind_y_5:
+        CASE(LDX_ind_y_5):
             
             READ_FROM_ADDRESS
             loadX(data);
@@ -2962,7 +3017,7 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case LDY_imm:
+        CASE(LDY_imm):
             
             READ_IMMEDIATE
             loadY(data);
@@ -2970,12 +3025,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDY_zpg:
+        CASE(LDY_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDY_zpg_2:
+        CASE(LDY_zpg_2):
             
             READ_FROM_ZERO_PAGE
             loadY(data);
@@ -2983,18 +3038,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDY_zpg_x:
+        CASE(LDY_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDY_zpg_x_2:
+        CASE(LDY_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case LDY_zpg_x_3:
+        CASE(LDY_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             loadY(data);
@@ -3002,17 +3057,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDY_abs:
+        CASE(LDY_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LDY_abs_2:
+        CASE(LDY_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case LDY_abs_3:
+        CASE(LDY_abs_3):
             
             READ_FROM_ADDRESS;
             loadY(data);
@@ -3020,18 +3075,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDY_abs_x:
+        CASE(LDY_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
 
-        case LDY_abs_x_2:
+        CASE(LDY_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case LDY_abs_x_3:
+        CASE(LDY_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3043,7 +3098,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDY_abs_x_4:
+        CASE(LDY_abs_x_4):
             
             READ_FROM_ADDRESS
             loadY(data);
@@ -3051,28 +3106,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDY_ind_x:
+        CASE(LDY_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LDY_ind_x_2:
+        CASE(LDY_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case LDY_ind_x_3:
+        CASE(LDY_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LDY_ind_x_4:
+        CASE(LDY_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case LDY_ind_x_5:
+        CASE(LDY_ind_x_5):
             
             READ_FROM_ADDRESS
             loadY(data);
@@ -3080,23 +3135,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LDY_ind_y:
+        CASE(LDY_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LDY_ind_y_2:
+        CASE(LDY_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LDY_ind_y_3:
+        CASE(LDY_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case LDY_ind_y_4:
+        CASE(LDY_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3108,7 +3163,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LDY_ind_y_5:
+        CASE(LDY_ind_y_5):
             
             READ_FROM_ADDRESS
             loadY(data);
@@ -3127,7 +3182,7 @@ CPU::executeOneCycle()
         #define DO_LSR setC(data & 1); data = data >> 1;
 
         // -------------------------------------------------------------------------------
-        case LSR_acc:
+        CASE(LSR_acc):
             
             IDLE_READ_IMPLIED
             setC(A & 1); loadA(A >> 1);
@@ -3135,98 +3190,98 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LSR_zpg:
+        CASE(LSR_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LSR_zpg_2:
+        CASE(LSR_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case LSR_zpg_3:
+        CASE(LSR_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_LSR
             CONTINUE
             
-        case LSR_zpg_4:
+        CASE(LSR_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
         // -------------------------------------------------------------------------------
-        case LSR_zpg_x:
+        CASE(LSR_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LSR_zpg_x_2:
+        CASE(LSR_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case LSR_zpg_x_3:
+        CASE(LSR_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case LSR_zpg_x_4:
+        CASE(LSR_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_LSR
             CONTINUE
             
-        case LSR_zpg_x_5:
+        CASE(LSR_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
             
         // -------------------------------------------------------------------------------
-        case LSR_abs:
+        CASE(LSR_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LSR_abs_2:
+        CASE(LSR_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case LSR_abs_3:
+        CASE(LSR_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case LSR_abs_4:
+        CASE(LSR_abs_4):
             
             WRITE_TO_ADDRESS
             DO_LSR
             CONTINUE
             
-        case LSR_abs_5:
+        CASE(LSR_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
             
         // -------------------------------------------------------------------------------
-        case LSR_abs_x:
+        CASE(LSR_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LSR_abs_x_2:
+        CASE(LSR_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case LSR_abs_x_3:
+        CASE(LSR_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3234,36 +3289,36 @@ CPU::executeOneCycle()
             }
             CONTINUE
             
-        case LSR_abs_x_4:
+        CASE(LSR_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case LSR_abs_x_5:
+        CASE(LSR_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_LSR
             CONTINUE
             
-        case LSR_abs_x_6:
+        CASE(LSR_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case LSR_abs_y:
+        CASE(LSR_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LSR_abs_y_2:
+        CASE(LSR_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case LSR_abs_y_3:
+        CASE(LSR_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3271,80 +3326,80 @@ CPU::executeOneCycle()
             }
             CONTINUE
             
-        case LSR_abs_y_4:
+        CASE(LSR_abs_y_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case LSR_abs_y_5:
+        CASE(LSR_abs_y_5):
             
             WRITE_TO_ADDRESS
             DO_LSR
             CONTINUE
             
-        case LSR_abs_y_6:
+        CASE(LSR_abs_y_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
             // -------------------------------------------------------------------------------
-        case LSR_ind_x:
+        CASE(LSR_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LSR_ind_x_2:
+        CASE(LSR_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case LSR_ind_x_3:
+        CASE(LSR_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LSR_ind_x_4:
+        CASE(LSR_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case LSR_ind_x_5:
+        CASE(LSR_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case LSR_ind_x_6:
+        CASE(LSR_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_LSR
             CONTINUE
             
-        case LSR_ind_x_7:
+        CASE(LSR_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case LSR_ind_y:
+        CASE(LSR_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LSR_ind_y_2:
+        CASE(LSR_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LSR_ind_y_3:
+        CASE(LSR_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case LSR_ind_y_4:
+        CASE(LSR_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3352,18 +3407,18 @@ CPU::executeOneCycle()
             }
             CONTINUE
             
-        case LSR_ind_y_5:
+        CASE(LSR_ind_y_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case LSR_ind_y_6:
+        CASE(LSR_ind_y_6):
             
             WRITE_TO_ADDRESS
             DO_LSR
             CONTINUE
             
-        case LSR_ind_y_7:
+        CASE(LSR_ind_y_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -3378,79 +3433,79 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case NOP:
+        CASE(NOP):
             
             IDLE_READ_IMPLIED
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case NOP_imm:
+        CASE(NOP_imm):
             
             IDLE_READ_IMMEDIATE
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case NOP_zpg:
+        CASE(NOP_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case NOP_zpg_2:
+        CASE(NOP_zpg_2):
             
             READ_FROM_ZERO_PAGE
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case NOP_zpg_x:
+        CASE(NOP_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case NOP_zpg_x_2:
+        CASE(NOP_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case NOP_zpg_x_3:
+        CASE(NOP_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case NOP_abs:
+        CASE(NOP_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case NOP_abs_2:
+        CASE(NOP_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case NOP_abs_3:
+        CASE(NOP_abs_3):
             
             READ_FROM_ADDRESS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case NOP_abs_x:
+        CASE(NOP_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case NOP_abs_x_2:
+        CASE(NOP_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case NOP_abs_x_3:
+        CASE(NOP_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3461,7 +3516,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case NOP_abs_x_4:
+        CASE(NOP_abs_x_4):
             
             READ_FROM_ADDRESS
             POLL_INT
@@ -3476,7 +3531,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case ORA_imm:
+        CASE(ORA_imm):
             
             READ_IMMEDIATE
             loadA(A | data);
@@ -3484,29 +3539,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ORA_abs:
+        CASE(ORA_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ORA_abs_2:
+        CASE(ORA_abs_2):
             FETCH_ADDR_HI
             // POLL_INT
             CONTINUE
             
-        case ORA_abs_3:
+        CASE(ORA_abs_3):
             READ_FROM_ADDRESS
             loadA(A | data);
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ORA_zpg:
+        CASE(ORA_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ORA_zpg_2:
+        CASE(ORA_zpg_2):
             
             READ_FROM_ZERO_PAGE
             loadA(A | data);
@@ -3514,18 +3569,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ORA_zpg_x:
+        CASE(ORA_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ORA_zpg_x_2:
+        CASE(ORA_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case ORA_zpg_x_3:
+        CASE(ORA_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             loadA(A | data);
@@ -3533,18 +3588,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ORA_abs_x:
+        CASE(ORA_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ORA_abs_x_2:
+        CASE(ORA_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ORA_abs_x_3:
+        CASE(ORA_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3556,7 +3611,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ORA_abs_x_4:
+        CASE(ORA_abs_x_4):
             
             READ_FROM_ADDRESS
             loadA(A | data);
@@ -3564,18 +3619,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ORA_abs_y:
+        CASE(ORA_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ORA_abs_y_2:
+        CASE(ORA_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case ORA_abs_y_3:
+        CASE(ORA_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3587,7 +3642,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ORA_abs_y_4:
+        CASE(ORA_abs_y_4):
             
             READ_FROM_ADDRESS
             loadA(A | data);
@@ -3595,28 +3650,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ORA_ind_x:
+        CASE(ORA_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ORA_ind_x_2:
+        CASE(ORA_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ORA_ind_x_3:
+        CASE(ORA_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE;
             
-        case ORA_ind_x_4:
+        CASE(ORA_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ORA_ind_x_5:
+        CASE(ORA_ind_x_5):
             
             READ_FROM_ADDRESS
             loadA(A | data);
@@ -3624,23 +3679,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ORA_ind_y:
+        CASE(ORA_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ORA_ind_y_2:
+        CASE(ORA_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ORA_ind_y_3:
+        CASE(ORA_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case ORA_ind_y_4:
+        CASE(ORA_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -3652,7 +3707,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case ORA_ind_y_5:
+        CASE(ORA_ind_y_5):
             
             READ_FROM_ADDRESS
             loadA(A | data);
@@ -3668,12 +3723,12 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case PHA:
+        CASE(PHA):
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case PHA_2:
+        CASE(PHA_2):
             
             PUSH_A
             POLL_INT
@@ -3688,12 +3743,12 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
             
-        case PHP:
+        CASE(PHP):
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case PHP_2:
+        CASE(PHP_2):
             
             PUSH_P
             POLL_INT
@@ -3708,17 +3763,17 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case PLA:
+        CASE(PLA):
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case PLA_2:
+        CASE(PLA_2):
             
             SP++;
             CONTINUE
             
-        case PLA_3:
+        CASE(PLA_3):
             
             PULL_A
             POLL_INT
@@ -3733,17 +3788,17 @@ CPU::executeOneCycle()
         //              / / / / / /
         // -------------------------------------------------------------------------------
 
-        case PLP:
+        CASE(PLP):
             
             IDLE_READ_IMPLIED
             CONTINUE
             
-        case PLP_2:
+        CASE(PLP_2):
             
             SP++;
             CONTINUE
             
-        case PLP_3:
+        CASE(PLP_3):
             
             POLL_INT // Interrupts are polled before P is pulled
             PULL_P
@@ -3763,7 +3818,7 @@ CPU::executeOneCycle()
         #define DO_ROL if (getC()) { setC(data & 128); data = (data << 1) + 1; } else { setC(data & 128); data = (data << 1); }
 
         // -------------------------------------------------------------------------------
-        case ROL_acc:
+        CASE(ROL_acc):
             
             IDLE_READ_IMPLIED
             if (getC()) {
@@ -3777,154 +3832,154 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROL_zpg:
+        CASE(ROL_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROL_zpg_2:
+        CASE(ROL_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ROL_zpg_3:
+        CASE(ROL_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case ROL_zpg_4:
+        CASE(ROL_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROL_zpg_x:
+        CASE(ROL_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROL_zpg_x_2:
+        CASE(ROL_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case ROL_zpg_x_3:
+        CASE(ROL_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ROL_zpg_x_4:
+        CASE(ROL_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case ROL_zpg_x_5:
+        CASE(ROL_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROL_abs:
+        CASE(ROL_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROL_abs_2:
+        CASE(ROL_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case ROL_abs_3:
+        CASE(ROL_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ROL_abs_4:
+        CASE(ROL_abs_4):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case ROL_abs_5:
+        CASE(ROL_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROL_abs_x:
+        CASE(ROL_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROL_abs_x_2:
+        CASE(ROL_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ROL_abs_x_3:
+        CASE(ROL_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case ROL_abs_x_4:
+        CASE(ROL_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ROL_abs_x_5:
+        CASE(ROL_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case ROL_abs_x_6:
+        CASE(ROL_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROL_ind_x:
+        CASE(ROL_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ROL_ind_x_2:
+        CASE(ROL_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ROL_ind_x_3:
+        CASE(ROL_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ROL_ind_x_4:
+        CASE(ROL_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ROL_ind_x_5:
+        CASE(ROL_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ROL_ind_x_6:
+        CASE(ROL_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case ROL_ind_x_7:
+        CASE(ROL_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -3944,7 +3999,7 @@ CPU::executeOneCycle()
         #define DO_ROR if (getC()) { setC(data & 1); data = (data >> 1) + 128; } else { setC(data & 1); data = (data >> 1); }
 
         // -------------------------------------------------------------------------------
-        case ROR_acc:
+        CASE(ROR_acc):
             
             IDLE_READ_IMPLIED
             if (getC()) {
@@ -3958,98 +4013,98 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROR_zpg:
+        CASE(ROR_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROR_zpg_2:
+        CASE(ROR_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ROR_zpg_3:
+        CASE(ROR_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case ROR_zpg_4:
+        CASE(ROR_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROR_zpg_x:
+        CASE(ROR_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROR_zpg_x_2:
+        CASE(ROR_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case ROR_zpg_x_3:
+        CASE(ROR_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ROR_zpg_x_4:
+        CASE(ROR_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case ROR_zpg_x_5:
+        CASE(ROR_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROR_abs:
+        CASE(ROR_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROR_abs_2:
+        CASE(ROR_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case ROR_abs_3:
+        CASE(ROR_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ROR_abs_4:
+        CASE(ROR_abs_4):
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case ROR_abs_5:
+        CASE(ROR_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROR_abs_x:
+        CASE(ROR_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ROR_abs_x_2:
+        CASE(ROR_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ROR_abs_x_3:
+        CASE(ROR_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -4057,57 +4112,57 @@ CPU::executeOneCycle()
             }
             CONTINUE
             
-        case ROR_abs_x_4:
+        CASE(ROR_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ROR_abs_x_5:
+        CASE(ROR_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case ROR_abs_x_6:
+        CASE(ROR_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case ROR_ind_x:
+        CASE(ROR_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ROR_ind_x_2:
+        CASE(ROR_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ROR_ind_x_3:
+        CASE(ROR_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ROR_ind_x_4:
+        CASE(ROR_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ROR_ind_x_5:
+        CASE(ROR_ind_x_5):
             
             READ_FROM_ADDRESS;
             CONTINUE
             
-        case ROR_ind_x_6:
+        CASE(ROR_ind_x_6):
             
             WRITE_TO_ADDRESS;
             DO_ROR;
             CONTINUE
             
-        case ROR_ind_x_7:
+        CASE(ROR_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             POLL_INT
@@ -4122,29 +4177,29 @@ CPU::executeOneCycle()
         //              / / / / / /
         // -------------------------------------------------------------------------------
 
-        case RTI:
+        CASE(RTI):
             
             IDLE_READ_IMMEDIATE;
             CONTINUE
             
-        case RTI_2:
+        CASE(RTI_2):
             
             SP++;
             CONTINUE
             
-        case RTI_3:
+        CASE(RTI_3):
             
             PULL_P
             SP++;
             CONTINUE
             
-        case RTI_4:
+        CASE(RTI_4):
             
             PULL_PCL
             SP++;
             CONTINUE
             
-        case RTI_5:
+        CASE(RTI_5):
             
             PULL_PCH
             POLL_INT
@@ -4159,28 +4214,28 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
             
-        case RTS:
+        CASE(RTS):
             
             IDLE_READ_IMMEDIATE
             CONTINUE
             
-        case RTS_2:
+        CASE(RTS_2):
             
             IDLE_READ_IMMEDIATE_SP
             CONTINUE
             
-        case RTS_3:
+        CASE(RTS_3):
             
             PULL_PCL
             SP++;
             CONTINUE
             
-        case RTS_4:
+        CASE(RTS_4):
             
             PULL_PCH
             CONTINUE
             
-        case RTS_5:
+        CASE(RTS_5):
             
             IDLE_READ_IMMEDIATE
             POLL_INT
@@ -4196,7 +4251,7 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case SBC_imm:
+        CASE(SBC_imm):
             
             READ_IMMEDIATE
             sbc(data);
@@ -4204,12 +4259,12 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SBC_zpg:
+        CASE(SBC_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SBC_zpg_2:
+        CASE(SBC_zpg_2):
             
             READ_FROM_ZERO_PAGE
             sbc(data);
@@ -4217,18 +4272,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SBC_zpg_x:
+        CASE(SBC_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SBC_zpg_x_2:
+        CASE(SBC_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case SBC_zpg_x_3:
+        CASE(SBC_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             sbc(data);
@@ -4236,17 +4291,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SBC_abs:
+        CASE(SBC_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SBC_abs_2:
+        CASE(SBC_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case SBC_abs_3:
+        CASE(SBC_abs_3):
             
             READ_FROM_ADDRESS;
             sbc(data);
@@ -4254,18 +4309,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SBC_abs_x:
+        CASE(SBC_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SBC_abs_x_2:
+        CASE(SBC_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case SBC_abs_x_3:
+        CASE(SBC_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -4277,7 +4332,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case SBC_abs_x_4:
+        CASE(SBC_abs_x_4):
             
             READ_FROM_ADDRESS
             sbc(data);
@@ -4285,18 +4340,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SBC_abs_y:
+        CASE(SBC_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SBC_abs_y_2:
+        CASE(SBC_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case SBC_abs_y_3:
+        CASE(SBC_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -4308,7 +4363,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case SBC_abs_y_4:
+        CASE(SBC_abs_y_4):
             
             READ_FROM_ADDRESS
             sbc(data);
@@ -4316,28 +4371,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SBC_ind_x:
+        CASE(SBC_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SBC_ind_x_2:
+        CASE(SBC_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case SBC_ind_x_3:
+        CASE(SBC_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SBC_ind_x_4:
+        CASE(SBC_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case SBC_ind_x_5:
+        CASE(SBC_ind_x_5):
             
             READ_FROM_ADDRESS
             sbc(data);
@@ -4345,23 +4400,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SBC_ind_y:
+        CASE(SBC_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SBC_ind_y_2:
+        CASE(SBC_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SBC_ind_y_3:
+        CASE(SBC_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case SBC_ind_y_4:
+        CASE(SBC_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -4373,7 +4428,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case SBC_ind_y_5:
+        CASE(SBC_ind_y_5):
             
             READ_FROM_ADDRESS
             sbc(data);
@@ -4389,7 +4444,7 @@ CPU::executeOneCycle()
         //              - - 1 - - -
         // -------------------------------------------------------------------------------
 
-        case SEC:
+        CASE(SEC):
             
             IDLE_READ_IMPLIED
             setC(1);
@@ -4405,7 +4460,7 @@ CPU::executeOneCycle()
         //              - - - - 1 -
         // -------------------------------------------------------------------------------
 
-        case SED:
+        CASE(SED):
             
             IDLE_READ_IMPLIED
             setD(1);
@@ -4421,7 +4476,7 @@ CPU::executeOneCycle()
         //              - - - 1 - -
         // -------------------------------------------------------------------------------
 
-        case SEI:
+        CASE(SEI):
             
             IDLE_READ_IMPLIED
             POLL_INT
@@ -4437,12 +4492,12 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case STA_zpg:
+        CASE(STA_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STA_zpg_2:
+        CASE(STA_zpg_2):
             
             data = A;
             WRITE_TO_ZERO_PAGE
@@ -4450,18 +4505,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STA_zpg_x:
+        CASE(STA_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STA_zpg_x_2:
+        CASE(STA_zpg_x_2):
             
             IDLE_READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case STA_zpg_x_3:
+        CASE(STA_zpg_x_3):
             
             data = A;
             WRITE_TO_ZERO_PAGE
@@ -4469,17 +4524,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STA_abs:
+        CASE(STA_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STA_abs_2:
+        CASE(STA_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case STA_abs_3:
+        CASE(STA_abs_3):
             
             data = A;
             WRITE_TO_ADDRESS
@@ -4487,24 +4542,24 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STA_abs_x:
+        CASE(STA_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STA_abs_x_2:
+        CASE(STA_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case STA_abs_x_3:
+        CASE(STA_abs_x_3):
             
             IDLE_READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case STA_abs_x_4:
+        CASE(STA_abs_x_4):
             
             data = A;
             WRITE_TO_ADDRESS
@@ -4512,25 +4567,25 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STA_abs_y:
+        CASE(STA_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STA_abs_y_2:
+        CASE(STA_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case STA_abs_y_3:
+        CASE(STA_abs_y_3):
             
             IDLE_READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED)
                 FIX_ADDR_HI
                 CONTINUE
                 
-                case STA_abs_y_4:
+                CASE(STA_abs_y_4):
                 
                 data = A;
             WRITE_TO_ADDRESS
@@ -4538,28 +4593,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STA_ind_x:
+        CASE(STA_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case STA_ind_x_2:
+        CASE(STA_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case STA_ind_x_3:
+        CASE(STA_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case STA_ind_x_4:
+        CASE(STA_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case STA_ind_x_5:
+        CASE(STA_ind_x_5):
             
             data = A;
             WRITE_TO_ADDRESS
@@ -4567,29 +4622,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STA_ind_y:
+        CASE(STA_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case STA_ind_y_2:
+        CASE(STA_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case STA_ind_y_3:
+        CASE(STA_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case STA_ind_y_4:
+        CASE(STA_ind_y_4):
             
             IDLE_READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case STA_ind_y_5:
+        CASE(STA_ind_y_5):
             
             data = A;
             WRITE_TO_ADDRESS
@@ -4605,12 +4660,12 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case STX_zpg:
+        CASE(STX_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STX_zpg_2:
+        CASE(STX_zpg_2):
             
             data = X;
             WRITE_TO_ZERO_PAGE
@@ -4618,18 +4673,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STX_zpg_y:
+        CASE(STX_zpg_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STX_zpg_y_2:
+        CASE(STX_zpg_y_2):
             
             IDLE_READ_FROM_ZERO_PAGE
             ADD_INDEX_Y
             CONTINUE
             
-        case STX_zpg_y_3:
+        CASE(STX_zpg_y_3):
             
             data = X;
             WRITE_TO_ZERO_PAGE
@@ -4637,17 +4692,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STX_abs:
+        CASE(STX_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STX_abs_2:
+        CASE(STX_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case STX_abs_3:
+        CASE(STX_abs_3):
             
             data = X;
             WRITE_TO_ADDRESS
@@ -4663,12 +4718,12 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case STY_zpg:
+        CASE(STY_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STY_zpg_2:
+        CASE(STY_zpg_2):
             
             data = Y;
             WRITE_TO_ZERO_PAGE
@@ -4676,18 +4731,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STY_zpg_x:
+        CASE(STY_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STY_zpg_x_2:
+        CASE(STY_zpg_x_2):
             
             IDLE_READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case STY_zpg_x_3:
+        CASE(STY_zpg_x_3):
             
             data = Y;
             WRITE_TO_ZERO_PAGE
@@ -4695,17 +4750,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case STY_abs:
+        CASE(STY_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case STY_abs_2:
+        CASE(STY_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case STY_abs_3:
+        CASE(STY_abs_3):
             
             data = Y;
             WRITE_TO_ADDRESS
@@ -4721,7 +4776,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case TAX:
+        CASE(TAX):
             
             IDLE_READ_IMPLIED
             loadX(A);
@@ -4737,7 +4792,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case TAY:
+        CASE(TAY):
             
             IDLE_READ_IMPLIED
             loadY(A);
@@ -4753,7 +4808,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case TSX:
+        CASE(TSX):
             
             IDLE_READ_IMPLIED
             loadX(SP);
@@ -4769,7 +4824,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case TXA:
+        CASE(TXA):
             
             IDLE_READ_IMPLIED
             loadA(X);
@@ -4785,7 +4840,7 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case TXS:
+        CASE(TXS):
             
             IDLE_READ_IMPLIED
             SP = X;
@@ -4801,7 +4856,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case TYA:
+        CASE(TYA):
             
             IDLE_READ_IMPLIED
             loadA(Y);
@@ -4822,7 +4877,7 @@ CPU::executeOneCycle()
         //              / / / - - -
         // -------------------------------------------------------------------------------
 
-        case ALR_imm:
+        CASE(ALR_imm):
             
             READ_IMMEDIATE
             A = A & data;
@@ -4840,7 +4895,7 @@ CPU::executeOneCycle()
         //              / / / - - -
         // -------------------------------------------------------------------------------
 
-        case ANC_imm:
+        CASE(ANC_imm):
             
             READ_IMMEDIATE
             loadA(A & data);
@@ -4857,7 +4912,7 @@ CPU::executeOneCycle()
         //              / / / - - /
         // -------------------------------------------------------------------------------
 
-        case ARR_imm:
+        CASE(ARR_imm):
         {
             READ_IMMEDIATE
             
@@ -4899,7 +4954,7 @@ CPU::executeOneCycle()
         //              / / / - - -
         // -------------------------------------------------------------------------------
 
-        case AXS_imm:
+        CASE(AXS_imm):
         {
             READ_IMMEDIATE
             
@@ -4921,23 +4976,23 @@ CPU::executeOneCycle()
         //              / / / - - -
         // -------------------------------------------------------------------------------
             
-        case DCP_zpg:
+        CASE(DCP_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DCP_zpg_2:
+        CASE(DCP_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case DCP_zpg_3:
+        CASE(DCP_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_DEC
             CONTINUE
             
-        case DCP_zpg_4:
+        CASE(DCP_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             cmp(A, data);
@@ -4945,29 +5000,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case DCP_zpg_x:
+        CASE(DCP_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DCP_zpg_x_2:
+        CASE(DCP_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case DCP_zpg_x_3:
+        CASE(DCP_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case DCP_zpg_x_4:
+        CASE(DCP_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_DEC
             CONTINUE
             
-        case DCP_zpg_x_5:
+        CASE(DCP_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             cmp(A, data);
@@ -4975,28 +5030,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case DCP_abs:
+        CASE(DCP_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DCP_abs_2:
+        CASE(DCP_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case DCP_abs_3:
+        CASE(DCP_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DCP_abs_4:
+        CASE(DCP_abs_4):
             
             WRITE_TO_ADDRESS
             DO_DEC;
             CONTINUE
             
-        case DCP_abs_5:
+        CASE(DCP_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             cmp(A, data);
@@ -5004,35 +5059,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case DCP_abs_x:
+        CASE(DCP_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DCP_abs_x_2:
+        CASE(DCP_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case DCP_abs_x_3:
+        CASE(DCP_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case DCP_abs_x_4:
+        CASE(DCP_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DCP_abs_x_5:
+        CASE(DCP_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DCP_abs_x_6:
+        CASE(DCP_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             cmp(A, data);
@@ -5040,35 +5095,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case DCP_abs_y:
+        CASE(DCP_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case DCP_abs_y_2:
+        CASE(DCP_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case DCP_abs_y_3:
+        CASE(DCP_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case DCP_abs_y_4:
+        CASE(DCP_abs_y_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DCP_abs_y_5:
+        CASE(DCP_abs_y_5):
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DCP_abs_y_6:
+        CASE(DCP_abs_y_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             cmp(A, data);
@@ -5076,39 +5131,39 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case DCP_ind_x:
+        CASE(DCP_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case DCP_ind_x_2:
+        CASE(DCP_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case DCP_ind_x_3:
+        CASE(DCP_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case DCP_ind_x_4:
+        CASE(DCP_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case DCP_ind_x_5:
+        CASE(DCP_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DCP_ind_x_6:
+        CASE(DCP_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DCP_ind_x_7:
+        CASE(DCP_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             cmp(A, data);
@@ -5116,40 +5171,40 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case DCP_ind_y:
+        CASE(DCP_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case DCP_ind_y_2:
+        CASE(DCP_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case DCP_ind_y_3:
+        CASE(DCP_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case DCP_ind_y_4:
+        CASE(DCP_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case DCP_ind_y_5:
+        CASE(DCP_ind_y_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case DCP_ind_y_6:
+        CASE(DCP_ind_y_6):
             
             WRITE_TO_ADDRESS
             DO_DEC
             CONTINUE
             
-        case DCP_ind_y_7:
+        CASE(DCP_ind_y_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             cmp(A, data);
@@ -5165,23 +5220,23 @@ CPU::executeOneCycle()
         //              / / / - - /
         // -------------------------------------------------------------------------------
 
-        case ISC_zpg:
+        CASE(ISC_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ISC_zpg_2:
+        CASE(ISC_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ISC_zpg_3:
+        CASE(ISC_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_INC
             CONTINUE
             
-        case ISC_zpg_4:
+        CASE(ISC_zpg_4):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             sbc(data);
@@ -5189,29 +5244,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ISC_zpg_x:
+        CASE(ISC_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ISC_zpg_x_2:
+        CASE(ISC_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case ISC_zpg_x_3:
+        CASE(ISC_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case ISC_zpg_x_4:
+        CASE(ISC_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_INC
             CONTINUE
             
-        case ISC_zpg_x_5:
+        CASE(ISC_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE_AND_SET_FLAGS
             sbc(data);
@@ -5219,28 +5274,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ISC_abs:
+        CASE(ISC_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ISC_abs_2:
+        CASE(ISC_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case ISC_abs_3:
+        CASE(ISC_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ISC_abs_4:
+        CASE(ISC_abs_4):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case ISC_abs_5:
+        CASE(ISC_abs_5):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             sbc(data);
@@ -5248,35 +5303,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ISC_abs_x:
+        CASE(ISC_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ISC_abs_x_2:
+        CASE(ISC_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case ISC_abs_x_3:
+        CASE(ISC_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case ISC_abs_x_4:
+        CASE(ISC_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ISC_abs_x_5:
+        CASE(ISC_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case ISC_abs_x_6:
+        CASE(ISC_abs_x_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             sbc(data);
@@ -5284,35 +5339,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ISC_abs_y:
+        CASE(ISC_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case ISC_abs_y_2:
+        CASE(ISC_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case ISC_abs_y_3:
+        CASE(ISC_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case ISC_abs_y_4:
+        CASE(ISC_abs_y_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ISC_abs_y_5:
+        CASE(ISC_abs_y_5):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case ISC_abs_y_6:
+        CASE(ISC_abs_y_6):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             sbc(data);
@@ -5320,39 +5375,39 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ISC_ind_x:
+        CASE(ISC_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ISC_ind_x_2:
+        CASE(ISC_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case ISC_ind_x_3:
+        CASE(ISC_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ISC_ind_x_4:
+        CASE(ISC_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case ISC_ind_x_5:
+        CASE(ISC_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ISC_ind_x_6:
+        CASE(ISC_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case ISC_ind_x_7:
+        CASE(ISC_ind_x_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             sbc(data);
@@ -5360,40 +5415,40 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case ISC_ind_y:
+        CASE(ISC_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case ISC_ind_y_2:
+        CASE(ISC_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case ISC_ind_y_3:
+        CASE(ISC_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case ISC_ind_y_4:
+        CASE(ISC_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case ISC_ind_y_5:
+        CASE(ISC_ind_y_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case ISC_ind_y_6:
+        CASE(ISC_ind_y_6):
             
             WRITE_TO_ADDRESS
             DO_INC
             CONTINUE
             
-        case ISC_ind_y_7:
+        CASE(ISC_ind_y_7):
             
             WRITE_TO_ADDRESS_AND_SET_FLAGS
             sbc(data);
@@ -5409,18 +5464,18 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case LAS_abs_y:
+        CASE(LAS_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LAS_abs_y_2:
+        CASE(LAS_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case LAS_abs_y_3:
+        CASE(LAS_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -5435,7 +5490,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LAS_abs_y_4:
+        CASE(LAS_abs_y_4):
             
             READ_FROM_ADDRESS
             data &= SP;
@@ -5454,12 +5509,12 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case LAX_zpg:
+        CASE(LAX_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LAX_zpg_2:
+        CASE(LAX_zpg_2):
             
             READ_FROM_ZERO_PAGE
             loadA(data);
@@ -5468,18 +5523,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LAX_zpg_y:
+        CASE(LAX_zpg_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LAX_zpg_y_2:
+        CASE(LAX_zpg_y_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_Y
             CONTINUE
             
-        case LAX_zpg_y_3:
+        CASE(LAX_zpg_y_3):
             
             READ_FROM_ZERO_PAGE
             loadA(data);
@@ -5488,17 +5543,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LAX_abs:
+        CASE(LAX_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LAX_abs_2:
+        CASE(LAX_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case LAX_abs_3:
+        CASE(LAX_abs_3):
             
             READ_FROM_ADDRESS;
             loadA(data);
@@ -5507,18 +5562,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LAX_abs_y:
+        CASE(LAX_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case LAX_abs_y_2:
+        CASE(LAX_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case LAX_abs_y_3:
+        CASE(LAX_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -5531,7 +5586,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LAX_abs_y_4:
+        CASE(LAX_abs_y_4):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -5540,28 +5595,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LAX_ind_x:
+        CASE(LAX_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LAX_ind_x_2:
+        CASE(LAX_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case LAX_ind_x_3:
+        CASE(LAX_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LAX_ind_x_4:
+        CASE(LAX_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case LAX_ind_x_5:
+        CASE(LAX_ind_x_5):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -5570,23 +5625,23 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case LAX_ind_y:
+        CASE(LAX_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case LAX_ind_y_2:
+        CASE(LAX_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case LAX_ind_y_3:
+        CASE(LAX_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case LAX_ind_y_4:
+        CASE(LAX_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) {
@@ -5599,7 +5654,7 @@ CPU::executeOneCycle()
                 DONE
             }
             
-        case LAX_ind_y_5:
+        CASE(LAX_ind_y_5):
             
             READ_FROM_ADDRESS
             loadA(data);
@@ -5617,23 +5672,23 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case RLA_zpg:
+        CASE(RLA_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RLA_zpg_2:
+        CASE(RLA_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case RLA_zpg_3:
+        CASE(RLA_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case RLA_zpg_4:
+        CASE(RLA_zpg_4):
             
             WRITE_TO_ZERO_PAGE
             loadA(A & data);
@@ -5641,29 +5696,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RLA_zpg_x:
+        CASE(RLA_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RLA_zpg_x_2:
+        CASE(RLA_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case RLA_zpg_x_3:
+        CASE(RLA_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case RLA_zpg_x_4:
+        CASE(RLA_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_ROL
             CONTINUE
             
-        case RLA_zpg_x_5:
+        CASE(RLA_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE
             loadA(A & data);
@@ -5671,28 +5726,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RLA_abs:
+        CASE(RLA_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RLA_abs_2:
+        CASE(RLA_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case RLA_abs_3:
+        CASE(RLA_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RLA_abs_4:
+        CASE(RLA_abs_4):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case RLA_abs_5:
+        CASE(RLA_abs_5):
             
             WRITE_TO_ADDRESS
             loadA(A & data);
@@ -5700,35 +5755,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RLA_abs_x:
+        CASE(RLA_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RLA_abs_x_2:
+        CASE(RLA_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case RLA_abs_x_3:
+        CASE(RLA_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case RLA_abs_x_4:
+        CASE(RLA_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RLA_abs_x_5:
+        CASE(RLA_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case RLA_abs_x_6:
+        CASE(RLA_abs_x_6):
             
             WRITE_TO_ADDRESS
             loadA(A & data);
@@ -5736,35 +5791,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RLA_abs_y:
+        CASE(RLA_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RLA_abs_y_2:
+        CASE(RLA_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case RLA_abs_y_3:
+        CASE(RLA_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case RLA_abs_y_4:
+        CASE(RLA_abs_y_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RLA_abs_y_5:
+        CASE(RLA_abs_y_5):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case RLA_abs_y_6:
+        CASE(RLA_abs_y_6):
             
             WRITE_TO_ADDRESS
             loadA(A & data);
@@ -5772,39 +5827,39 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RLA_ind_x:
+        CASE(RLA_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case RLA_ind_x_2:
+        CASE(RLA_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case RLA_ind_x_3:
+        CASE(RLA_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case RLA_ind_x_4:
+        CASE(RLA_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case RLA_ind_x_5:
+        CASE(RLA_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RLA_ind_x_6:
+        CASE(RLA_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case RLA_ind_x_7:
+        CASE(RLA_ind_x_7):
             
             WRITE_TO_ADDRESS
             loadA(A & data);
@@ -5812,40 +5867,40 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RLA_ind_y:
+        CASE(RLA_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case RLA_ind_y_2:
+        CASE(RLA_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case RLA_ind_y_3:
+        CASE(RLA_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case RLA_ind_y_4:
+        CASE(RLA_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case RLA_ind_y_5:
+        CASE(RLA_ind_y_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RLA_ind_y_6:
+        CASE(RLA_ind_y_6):
             
             WRITE_TO_ADDRESS
             DO_ROL
             CONTINUE
             
-        case RLA_ind_y_7:
+        CASE(RLA_ind_y_7):
             
             WRITE_TO_ADDRESS
             loadA(A & data);
@@ -5862,23 +5917,23 @@ CPU::executeOneCycle()
         // -------------------------------------------------------------------------------
 
         // -------------------------------------------------------------------------------
-        case RRA_zpg:
+        CASE(RRA_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RRA_zpg_2:
+        CASE(RRA_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case RRA_zpg_3:
+        CASE(RRA_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case RRA_zpg_4:
+        CASE(RRA_zpg_4):
             
             WRITE_TO_ZERO_PAGE
             adc(data);
@@ -5886,29 +5941,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RRA_zpg_x:
+        CASE(RRA_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RRA_zpg_x_2:
+        CASE(RRA_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case RRA_zpg_x_3:
+        CASE(RRA_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case RRA_zpg_x_4:
+        CASE(RRA_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_ROR
             CONTINUE
             
-        case RRA_zpg_x_5:
+        CASE(RRA_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE
             adc(data);
@@ -5916,28 +5971,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RRA_abs:
+        CASE(RRA_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RRA_abs_2:
+        CASE(RRA_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case RRA_abs_3:
+        CASE(RRA_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RRA_abs_4:
+        CASE(RRA_abs_4):
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case RRA_abs_5:
+        CASE(RRA_abs_5):
             
             WRITE_TO_ADDRESS
             adc(data);
@@ -5945,35 +6000,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RRA_abs_x:
+        CASE(RRA_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RRA_abs_x_2:
+        CASE(RRA_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case RRA_abs_x_3:
+        CASE(RRA_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case RRA_abs_x_4:
+        CASE(RRA_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RRA_abs_x_5:
+        CASE(RRA_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case RRA_abs_x_6:
+        CASE(RRA_abs_x_6):
             
             WRITE_TO_ADDRESS
             adc(data);
@@ -5981,35 +6036,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RRA_abs_y:
+        CASE(RRA_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case RRA_abs_y_2:
+        CASE(RRA_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case RRA_abs_y_3:
+        CASE(RRA_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case RRA_abs_y_4:
+        CASE(RRA_abs_y_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RRA_abs_y_5:
+        CASE(RRA_abs_y_5):
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case RRA_abs_y_6:
+        CASE(RRA_abs_y_6):
             
             WRITE_TO_ADDRESS
             adc(data);
@@ -6017,39 +6072,39 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RRA_ind_x:
+        CASE(RRA_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case RRA_ind_x_2:
+        CASE(RRA_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case RRA_ind_x_3:
+        CASE(RRA_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case RRA_ind_x_4:
+        CASE(RRA_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case RRA_ind_x_5:
+        CASE(RRA_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RRA_ind_x_6:
+        CASE(RRA_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case RRA_ind_x_7:
+        CASE(RRA_ind_x_7):
             
             WRITE_TO_ADDRESS
             adc(data);
@@ -6057,40 +6112,40 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case RRA_ind_y:
+        CASE(RRA_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case RRA_ind_y_2:
+        CASE(RRA_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case RRA_ind_y_3:
+        CASE(RRA_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case RRA_ind_y_4:
+        CASE(RRA_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case RRA_ind_y_5:
+        CASE(RRA_ind_y_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case RRA_ind_y_6:
+        CASE(RRA_ind_y_6):
             
             WRITE_TO_ADDRESS
             DO_ROR
             CONTINUE
             
-        case RRA_ind_y_7:
+        CASE(RRA_ind_y_7):
             
             WRITE_TO_ADDRESS
             adc(data);
@@ -6106,12 +6161,12 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case SAX_zpg:
+        CASE(SAX_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SAX_zpg_2:
+        CASE(SAX_zpg_2):
             
             data = A & X;
             WRITE_TO_ZERO_PAGE
@@ -6119,18 +6174,18 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SAX_zpg_y:
+        CASE(SAX_zpg_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SAX_zpg_y_2:
+        CASE(SAX_zpg_y_2):
             
             IDLE_READ_FROM_ZERO_PAGE
             ADD_INDEX_Y
             CONTINUE
             
-        case SAX_zpg_y_3:
+        CASE(SAX_zpg_y_3):
             
             data = A & X;
             WRITE_TO_ZERO_PAGE
@@ -6138,17 +6193,17 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SAX_abs:
+        CASE(SAX_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SAX_abs_2:
+        CASE(SAX_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case SAX_abs_3:
+        CASE(SAX_abs_3):
             
             data = A & X;
             WRITE_TO_ADDRESS
@@ -6156,28 +6211,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SAX_ind_x:
+        CASE(SAX_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SAX_ind_x_2:
+        CASE(SAX_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case SAX_ind_x_3:
+        CASE(SAX_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SAX_ind_x_4:
+        CASE(SAX_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case SAX_ind_x_5:
+        CASE(SAX_ind_x_5):
             
             data = A & X;
             WRITE_TO_ADDRESS
@@ -6193,18 +6248,18 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case SHA_abs_y:
+        CASE(SHA_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SHA_abs_y_2:
+        CASE(SHA_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case SHA_abs_y_3:
+        CASE(SHA_abs_y_3):
             
             IDLE_READ_FROM_ADDRESS
             
@@ -6227,30 +6282,30 @@ CPU::executeOneCycle()
             
             CONTINUE
             
-        case SHA_abs_y_4:
+        CASE(SHA_abs_y_4):
             
             WRITE_TO_ADDRESS
             POLL_INT
             DONE
 
         // -------------------------------------------------------------------------------
-        case SHA_ind_y:
+        CASE(SHA_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SHA_ind_y_2:
+        CASE(SHA_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SHA_ind_y_3:
+        CASE(SHA_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case SHA_ind_y_4:
+        CASE(SHA_ind_y_4):
             
             IDLE_READ_FROM_ADDRESS
             
@@ -6273,7 +6328,7 @@ CPU::executeOneCycle()
 
             CONTINUE
             
-        case SHA_ind_y_5:
+        CASE(SHA_ind_y_5):
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -6288,18 +6343,18 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case SHX_abs_y:
+        CASE(SHX_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SHX_abs_y_2:
+        CASE(SHX_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
          
-        case SHX_abs_y_3:
+        CASE(SHX_abs_y_3):
             
             IDLE_READ_FROM_ADDRESS
             
@@ -6322,7 +6377,7 @@ CPU::executeOneCycle()
             
             CONTINUE
            
-        case SHX_abs_y_4:
+        CASE(SHX_abs_y_4):
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -6337,18 +6392,18 @@ CPU::executeOneCycle()
         //              - - - - - -
         // -------------------------------------------------------------------------------
 
-        case SHY_abs_x:
+        CASE(SHY_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SHY_abs_x_2:
+        CASE(SHY_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case SHY_abs_x_3:
+        CASE(SHY_abs_x_3):
             
             IDLE_READ_FROM_ADDRESS
             
@@ -6371,7 +6426,7 @@ CPU::executeOneCycle()
 
             CONTINUE
             
-        case SHY_abs_x_4:
+        CASE(SHY_abs_x_4):
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -6389,23 +6444,23 @@ CPU::executeOneCycle()
         #define DO_SLO setC(data & 128); data <<= 1;
 
         // -------------------------------------------------------------------------------
-        case SLO_zpg:
+        CASE(SLO_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SLO_zpg_2:
+        CASE(SLO_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case SLO_zpg_3:
+        CASE(SLO_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_SLO
             CONTINUE
             
-        case SLO_zpg_4:
+        CASE(SLO_zpg_4):
             
             WRITE_TO_ZERO_PAGE
             loadA(A | data);
@@ -6413,29 +6468,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SLO_zpg_x:
+        CASE(SLO_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SLO_zpg_x_2:
+        CASE(SLO_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case SLO_zpg_x_3:
+        CASE(SLO_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case SLO_zpg_x_4:
+        CASE(SLO_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_SLO
             CONTINUE
             
-        case SLO_zpg_x_5:
+        CASE(SLO_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE
             loadA(A | data);
@@ -6443,27 +6498,27 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SLO_abs:
+        CASE(SLO_abs):
             FETCH_ADDR_LO
             CONTINUE
             
-        case SLO_abs_2:
+        CASE(SLO_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case SLO_abs_3:
+        CASE(SLO_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SLO_abs_4:
+        CASE(SLO_abs_4):
             
             WRITE_TO_ADDRESS
             DO_SLO
             CONTINUE
             
-        case SLO_abs_5:
+        CASE(SLO_abs_5):
             
             WRITE_TO_ADDRESS
             loadA(A | data);
@@ -6471,35 +6526,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SLO_abs_x:
+        CASE(SLO_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SLO_abs_x_2:
+        CASE(SLO_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case SLO_abs_x_3:
+        CASE(SLO_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case SLO_abs_x_4:
+        CASE(SLO_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SLO_abs_x_5:
+        CASE(SLO_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_SLO
             CONTINUE
             
-        case SLO_abs_x_6:
+        CASE(SLO_abs_x_6):
             
             WRITE_TO_ADDRESS
             loadA(A | data);
@@ -6507,35 +6562,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SLO_abs_y:
+        CASE(SLO_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SLO_abs_y_2:
+        CASE(SLO_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case SLO_abs_y_3:
+        CASE(SLO_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case SLO_abs_y_4:
+        CASE(SLO_abs_y_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SLO_abs_y_5:
+        CASE(SLO_abs_y_5):
             
             WRITE_TO_ADDRESS
             DO_SLO
             CONTINUE
             
-        case SLO_abs_y_6:
+        CASE(SLO_abs_y_6):
             
             WRITE_TO_ADDRESS
             loadA(A | data);
@@ -6543,39 +6598,39 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SLO_ind_x:
+        CASE(SLO_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SLO_ind_x_2:
+        CASE(SLO_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case SLO_ind_x_3:
+        CASE(SLO_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SLO_ind_x_4:
+        CASE(SLO_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case SLO_ind_x_5:
+        CASE(SLO_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SLO_ind_x_6:
+        CASE(SLO_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_SLO
             CONTINUE
             
-        case SLO_ind_x_7:
+        CASE(SLO_ind_x_7):
             
             WRITE_TO_ADDRESS
             loadA(A | data);
@@ -6583,40 +6638,40 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SLO_ind_y:
+        CASE(SLO_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SLO_ind_y_2:
+        CASE(SLO_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SLO_ind_y_3:
+        CASE(SLO_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case SLO_ind_y_4:
+        CASE(SLO_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case SLO_ind_y_5:
+        CASE(SLO_ind_y_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SLO_ind_y_6:
+        CASE(SLO_ind_y_6):
             
             WRITE_TO_ADDRESS
             DO_SLO
             CONTINUE
             
-        case SLO_ind_y_7:
+        CASE(SLO_ind_y_7):
             WRITE_TO_ADDRESS
             loadA(A | data);
             POLL_INT
@@ -6634,23 +6689,23 @@ CPU::executeOneCycle()
         #define DO_SRE setC(data & 1); data >>= 1;
 
         // -------------------------------------------------------------------------------
-        case SRE_zpg:
+        CASE(SRE_zpg):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SRE_zpg_2:
+        CASE(SRE_zpg_2):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case SRE_zpg_3:
+        CASE(SRE_zpg_3):
             
             WRITE_TO_ZERO_PAGE
             DO_SRE
             CONTINUE
             
-        case SRE_zpg_4:
+        CASE(SRE_zpg_4):
             
             WRITE_TO_ZERO_PAGE
             loadA(A ^ data);
@@ -6658,29 +6713,29 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SRE_zpg_x:
+        CASE(SRE_zpg_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SRE_zpg_x_2:
+        CASE(SRE_zpg_x_2):
             
             READ_FROM_ZERO_PAGE
             ADD_INDEX_X
             CONTINUE
             
-        case SRE_zpg_x_3:
+        CASE(SRE_zpg_x_3):
             
             READ_FROM_ZERO_PAGE
             CONTINUE
             
-        case SRE_zpg_x_4:
+        CASE(SRE_zpg_x_4):
             
             WRITE_TO_ZERO_PAGE
             DO_SRE
             CONTINUE
             
-        case SRE_zpg_x_5:
+        CASE(SRE_zpg_x_5):
             
             WRITE_TO_ZERO_PAGE
             loadA(A ^ data);
@@ -6688,28 +6743,28 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SRE_abs:
+        CASE(SRE_abs):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SRE_abs_2:
+        CASE(SRE_abs_2):
             
             FETCH_ADDR_HI
             CONTINUE
             
-        case SRE_abs_3:
+        CASE(SRE_abs_3):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SRE_abs_4:
+        CASE(SRE_abs_4):
             
             WRITE_TO_ADDRESS
             DO_SRE
             CONTINUE
             
-        case SRE_abs_5:
+        CASE(SRE_abs_5):
             
             WRITE_TO_ADDRESS
             loadA(A ^ data);
@@ -6717,35 +6772,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SRE_abs_x:
+        CASE(SRE_abs_x):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SRE_abs_x_2:
+        CASE(SRE_abs_x_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_X
             CONTINUE
             
-        case SRE_abs_x_3:
+        CASE(SRE_abs_x_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case SRE_abs_x_4:
+        CASE(SRE_abs_x_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SRE_abs_x_5:
+        CASE(SRE_abs_x_5):
             
             WRITE_TO_ADDRESS
             DO_SRE
             CONTINUE
             
-        case SRE_abs_x_6:
+        CASE(SRE_abs_x_6):
             
             WRITE_TO_ADDRESS
             loadA(A ^ data);
@@ -6753,35 +6808,35 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SRE_abs_y:
+        CASE(SRE_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case SRE_abs_y_2:
+        CASE(SRE_abs_y_2):
             
             FETCH_ADDR_HI
             ADD_INDEX_Y
             CONTINUE
             
-        case SRE_abs_y_3:
+        CASE(SRE_abs_y_3):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case SRE_abs_y_4:
+        CASE(SRE_abs_y_4):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SRE_abs_y_5:
+        CASE(SRE_abs_y_5):
             
             WRITE_TO_ADDRESS
             DO_SRE
             CONTINUE
             
-        case SRE_abs_y_6:
+        CASE(SRE_abs_y_6):
             
             WRITE_TO_ADDRESS
             loadA(A ^ data);
@@ -6789,39 +6844,39 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SRE_ind_x:
+        CASE(SRE_ind_x):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SRE_ind_x_2:
+        CASE(SRE_ind_x_2):
             
             IDLE_READ_FROM_ADDRESS_INDIRECT
             ADD_INDEX_X_INDIRECT
             CONTINUE
             
-        case SRE_ind_x_3:
+        CASE(SRE_ind_x_3):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SRE_ind_x_4:
+        CASE(SRE_ind_x_4):
             
             FETCH_ADDR_HI_INDIRECT
             CONTINUE
             
-        case SRE_ind_x_5:
+        CASE(SRE_ind_x_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SRE_ind_x_6:
+        CASE(SRE_ind_x_6):
             
             WRITE_TO_ADDRESS
             DO_SRE
             CONTINUE
             
-        case SRE_ind_x_7:
+        CASE(SRE_ind_x_7):
             
             WRITE_TO_ADDRESS
             loadA(A ^ data);
@@ -6829,40 +6884,40 @@ CPU::executeOneCycle()
             DONE
 
         // -------------------------------------------------------------------------------
-        case SRE_ind_y:
+        CASE(SRE_ind_y):
             
             FETCH_POINTER_ADDR
             CONTINUE
             
-        case SRE_ind_y_2:
+        CASE(SRE_ind_y_2):
             
             FETCH_ADDR_LO_INDIRECT
             CONTINUE
             
-        case SRE_ind_y_3:
+        CASE(SRE_ind_y_3):
             
             FETCH_ADDR_HI_INDIRECT
             ADD_INDEX_Y
             CONTINUE
             
-        case SRE_ind_y_4:
+        CASE(SRE_ind_y_4):
             
             READ_FROM_ADDRESS
             if (PAGE_BOUNDARY_CROSSED) { FIX_ADDR_HI }
             CONTINUE
             
-        case SRE_ind_y_5:
+        CASE(SRE_ind_y_5):
             
             READ_FROM_ADDRESS
             CONTINUE
             
-        case SRE_ind_y_6:
+        CASE(SRE_ind_y_6):
             
             WRITE_TO_ADDRESS
             DO_SRE
             CONTINUE
             
-        case SRE_ind_y_7:
+        CASE(SRE_ind_y_7):
             
             WRITE_TO_ADDRESS
             loadA(A ^ data);
@@ -6879,18 +6934,18 @@ CPU::executeOneCycle()
         //
         // -------------------------------------------------------------------------------
 
-        case TAS_abs_y:
+        CASE(TAS_abs_y):
             
             FETCH_ADDR_LO
             CONTINUE
             
-        case TAS_abs_y_2:
+        CASE(TAS_abs_y_2):
             
             FETCH_ADDR_HI;
             ADD_INDEX_Y;
             CONTINUE
             
-        case TAS_abs_y_3:
+        CASE(TAS_abs_y_3):
             
             IDLE_READ_FROM_ADDRESS
             
@@ -6915,7 +6970,7 @@ CPU::executeOneCycle()
 
             CONTINUE
             
-        case TAS_abs_y_4:
+        CASE(TAS_abs_y_4):
             
             WRITE_TO_ADDRESS
             POLL_INT
@@ -6930,7 +6985,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case ANE_imm:
+        CASE(ANE_imm):
             
             READ_IMMEDIATE
             loadA(X & data & (A | 0xEE));
@@ -6946,7 +7001,7 @@ CPU::executeOneCycle()
         //              / / - - - -
         // -------------------------------------------------------------------------------
 
-        case LXA_imm:
+        CASE(LXA_imm):
             
             READ_IMMEDIATE
             X = data & (A | 0xEE);
@@ -16,300 +16,308 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+/*! @brief    List of all microinstructions
+ *  @details  The list is expanded into the MicroInstruction enumeration below. It is
+ *             also used to build the jump table of the threaded dispatch engine in
+ *             CPU::executeOneCycle() which needs one label per microinstruction.
+ */
+#define MICRO_INSTRUCTIONS(m) \
+    m(fetch) \
+    \
+    m(JAM) m(JAM_2) \
+    \
+    m(irq) m(irq_2) m(irq_3) m(irq_4) m(irq_5) m(irq_6) m(irq_7) \
+    m(nmi) m(nmi_2) m(nmi_3) m(nmi_4) m(nmi_5) m(nmi_6) m(nmi_7) \
+    \
+    m(ADC_imm) \
+    m(ADC_zpg)   m(ADC_zpg_2) \
+    m(ADC_zpg_x) m(ADC_zpg_x_2) m(ADC_zpg_x_3) \
+    m(ADC_abs)   m(ADC_abs_2)   m(ADC_abs_3) \
+    m(ADC_abs_x) m(ADC_abs_x_2) m(ADC_abs_x_3) m(ADC_abs_x_4) \
+    m(ADC_abs_y) m(ADC_abs_y_2) m(ADC_abs_y_3) m(ADC_abs_y_4) \
+    m(ADC_ind_x) m(ADC_ind_x_2) m(ADC_ind_x_3) m(ADC_ind_x_4) m(ADC_ind_x_5) \
+    m(ADC_ind_y) m(ADC_ind_y_2) m(ADC_ind_y_3) m(ADC_ind_y_4) m(ADC_ind_y_5) \
+    \
+    m(AND_imm) \
+    m(AND_zpg)   m(AND_zpg_2) \
+    m(AND_zpg_x) m(AND_zpg_x_2) m(AND_zpg_x_3) \
+    m(AND_abs)   m(AND_abs_2)   m(AND_abs_3) \
+    m(AND_abs_x) m(AND_abs_x_2) m(AND_abs_x_3) m(AND_abs_x_4) \
+    m(AND_abs_y) m(AND_abs_y_2) m(AND_abs_y_3) m(AND_abs_y_4) \
+    m(AND_ind_x) m(AND_ind_x_2) m(AND_ind_x_3) m(AND_ind_x_4) m(AND_ind_x_5) \
+    m(AND_ind_y) m(AND_ind_y_2) m(AND_ind_y_3) m(AND_ind_y_4) m(AND_ind_y_5) \
+    \
+    m(ASL_acc) \
+    m(ASL_zpg)   m(ASL_zpg_2)   m(ASL_zpg_3)   m(ASL_zpg_4) \
+    m(ASL_zpg_x) m(ASL_zpg_x_2) m(ASL_zpg_x_3) m(ASL_zpg_x_4) m(ASL_zpg_x_5) \
+    m(ASL_abs)   m(ASL_abs_2)   m(ASL_abs_3)   m(ASL_abs_4)   m(ASL_abs_5) \
+    m(ASL_abs_x) m(ASL_abs_x_2) m(ASL_abs_x_3) m(ASL_abs_x_4) m(ASL_abs_x_5) m(ASL_abs_x_6) \
+    m(ASL_ind_x) m(ASL_ind_x_2) m(ASL_ind_x_3) m(ASL_ind_x_4) m(ASL_ind_x_5) m(ASL_ind_x_6) m(ASL_ind_x_7) \
+    \
+    m(branch_3_underflow) m(branch_3_overflow) \
+    m(BCC_rel) m(BCC_rel_2) \
+    m(BCS_rel) m(BCS_rel_2) \
+    m(BEQ_rel) m(BEQ_rel_2) \
+    \
+    m(BIT_zpg) m(BIT_zpg_2) \
+    m(BIT_abs) m(BIT_abs_2) m(BIT_abs_3) \
+    \
+    m(BMI_rel) m(BMI_rel_2) \
+    m(BNE_rel) m(BNE_rel_2) \
+    m(BPL_rel) m(BPL_rel_2) \
+    \
+    m(BRK) m(BRK_2) m(BRK_3) m(BRK_4) m(BRK_5) m(BRK_6) \
+    m(BRK_nmi_4) m(BRK_nmi_5) m(BRK_nmi_6) \
+    \
+    m(BVC_rel) m(BVC_rel_2) \
+    m(BVS_rel) m(BVS_rel_2) \
+    m(CLC) \
+    m(CLD) \
+    m(CLI) \
+    m(CLV) \
+    \
+    m(CMP_imm) \
+    m(CMP_zpg)   m(CMP_zpg_2) \
+    m(CMP_zpg_x) m(CMP_zpg_x_2) m(CMP_zpg_x_3) \
+    m(CMP_abs)   m(CMP_abs_2)   m(CMP_abs_3) \
+    m(CMP_abs_x) m(CMP_abs_x_2) m(CMP_abs_x_3) m(CMP_abs_x_4) \
+    m(CMP_abs_y) m(CMP_abs_y_2) m(CMP_abs_y_3) m(CMP_abs_y_4) \
+    m(CMP_ind_x) m(CMP_ind_x_2) m(CMP_ind_x_3) m(CMP_ind_x_4) m(CMP_ind_x_5) \
+    m(CMP_ind_y) m(CMP_ind_y_2) m(CMP_ind_y_3) m(CMP_ind_y_4) m(CMP_ind_y_5) \
+    \
+    m(CPX_imm) \
+    m(CPX_zpg) m(CPX_zpg_2) \
+    m(CPX_abs) m(CPX_abs_2) m(CPX_abs_3) \
+    \
+    m(CPY_imm) \
+    m(CPY_zpg) m(CPY_zpg_2) \
+    m(CPY_abs) m(CPY_abs_2) m(CPY_abs_3) \
+    \
+    m(DEC_zpg)   m(DEC_zpg_2)   m(DEC_zpg_3)   m(DEC_zpg_4) \
+    m(DEC_zpg_x) m(DEC_zpg_x_2) m(DEC_zpg_x_3) m(DEC_zpg_x_4) m(DEC_zpg_x_5) \
+    m(DEC_abs)   m(DEC_abs_2)   m(DEC_abs_3)   m(DEC_abs_4)   m(DEC_abs_5) \
+    m(DEC_abs_x) m(DEC_abs_x_2) m(DEC_abs_x_3) m(DEC_abs_x_4) m(DEC_abs_x_5) m(DEC_abs_x_6) \
+    m(DEC_ind_x) m(DEC_ind_x_2) m(DEC_ind_x_3) m(DEC_ind_x_4) m(DEC_ind_x_5) m(DEC_ind_x_6) m(DEC_ind_x_7) \
+    \
+    m(DEX) \
+    m(DEY) \
+    \
+    m(EOR_imm) \
+    m(EOR_zpg)   m(EOR_zpg_2) \
+    m(EOR_zpg_x) m(EOR_zpg_x_2) m(EOR_zpg_x_3) \
+    m(EOR_abs)   m(EOR_abs_2)   m(EOR_abs_3) \
+    m(EOR_abs_x) m(EOR_abs_x_2) m(EOR_abs_x_3) m(EOR_abs_x_4) \
+    m(EOR_abs_y) m(EOR_abs_y_2) m(EOR_abs_y_3) m(EOR_abs_y_4) \
+    m(EOR_ind_x) m(EOR_ind_x_2) m(EOR_ind_x_3) m(EOR_ind_x_4) m(EOR_ind_x_5) \
+    m(EOR_ind_y) m(EOR_ind_y_2) m(EOR_ind_y_3) m(EOR_ind_y_4) m(EOR_ind_y_5) \
+    \
+    m(INC_zpg)   m(INC_zpg_2)   m(INC_zpg_3)   m(INC_zpg_4) \
+    m(INC_zpg_x) m(INC_zpg_x_2) m(INC_zpg_x_3) m(INC_zpg_x_4) m(INC_zpg_x_5) \
+    m(INC_abs)   m(INC_abs_2)   m(INC_abs_3)   m(INC_abs_4)   m(INC_abs_5) \
+    m(INC_abs_x) m(INC_abs_x_2) m(INC_abs_x_3) m(INC_abs_x_4) m(INC_abs_x_5) m(INC_abs_x_6) \
+    m(INC_ind_x) m(INC_ind_x_2) m(INC_ind_x_3) m(INC_ind_x_4) m(INC_ind_x_5) m(INC_ind_x_6) m(INC_ind_x_7) \
+    \
+    m(INX) \
+    m(INY) \
+    \
+    m(JMP_abs) m(JMP_abs_2) \
+    m(JMP_abs_indirect) m(JMP_abs_ind_2) m(JMP_abs_ind_3) m(JMP_abs_ind_4) \
+    \
+    m(JSR) m(JSR_2) m(JSR_3) m(JSR_4) m(JSR_5) \
+    \
+    m(LDA_imm) \
+    m(LDA_zpg)   m(LDA_zpg_2) \
+    m(LDA_zpg_x) m(LDA_zpg_x_2) m(LDA_zpg_x_3) \
+    m(LDA_abs)   m(LDA_abs_2)   m(LDA_abs_3) \
+    m(LDA_abs_x) m(LDA_abs_x_2) m(LDA_abs_x_3) m(LDA_abs_x_4) \
+    m(LDA_abs_y) m(LDA_abs_y_2) m(LDA_abs_y_3) m(LDA_abs_y_4) \
+    m(LDA_ind_x) m(LDA_ind_x_2) m(LDA_ind_x_3) m(LDA_ind_x_4) m(LDA_ind_x_5) \
+    m(LDA_ind_y) m(LDA_ind_y_2) m(LDA_ind_y_3) m(LDA_ind_y_4) m(LDA_ind_y_5) \
+    \
+    m(LDX_imm) \
+    m(LDX_zpg)   m(LDX_zpg_2) \
+    m(LDX_zpg_y) m(LDX_zpg_y_2) m(LDX_zpg_y_3) \
+    m(LDX_abs)   m(LDX_abs_2)   m(LDX_abs_3) \
+    m(LDX_abs_y) m(LDX_abs_y_2) m(LDX_abs_y_3) m(LDX_abs_y_4) \
+    m(LDX_ind_x) m(LDX_ind_x_2) m(LDX_ind_x_3) m(LDX_ind_x_4) m(LDX_ind_x_5) \
+    m(LDX_ind_y) m(LDX_ind_y_2) m(LDX_ind_y_3) m(LDX_ind_y_4) m(LDX_ind_y_5) \
+    \
+    m(LDY_imm) \
+    m(LDY_zpg)   m(LDY_zpg_2) \
+    m(LDY_zpg_x) m(LDY_zpg_x_2) m(LDY_zpg_x_3) \
+    m(LDY_abs)   m(LDY_abs_2)   m(LDY_abs_3) \
+    m(LDY_abs_x) m(LDY_abs_x_2) m(LDY_abs_x_3) m(LDY_abs_x_4) \
+    m(LDY_ind_x) m(LDY_ind_x_2) m(LDY_ind_x_3) m(LDY_ind_x_4) m(LDY_ind_x_5) \
+    m(LDY_ind_y) m(LDY_ind_y_2) m(LDY_ind_y_3) m(LDY_ind_y_4) m(LDY_ind_y_5) \
+    \
+    m(LSR_acc) \
+    m(LSR_zpg)   m(LSR_zpg_2)   m(LSR_zpg_3)   m(LSR_zpg_4) \
+    m(LSR_zpg_x) m(LSR_zpg_x_2) m(LSR_zpg_x_3) m(LSR_zpg_x_4) m(LSR_zpg_x_5) \
+    m(LSR_abs)   m(LSR_abs_2)   m(LSR_abs_3)   m(LSR_abs_4)   m(LSR_abs_5) \
+    m(LSR_abs_x) m(LSR_abs_x_2) m(LSR_abs_x_3) m(LSR_abs_x_4) m(LSR_abs_x_5) m(LSR_abs_x_6) \
+    m(LSR_abs_y) m(LSR_abs_y_2) m(LSR_abs_y_3) m(LSR_abs_y_4) m(LSR_abs_y_5) m(LSR_abs_y_6) \
+    m(LSR_ind_x) m(LSR_ind_x_2) m(LSR_ind_x_3) m(LSR_ind_x_4) m(LSR_ind_x_5) m(LSR_ind_x_6) m(LSR_ind_x_7) \
+    m(LSR_ind_y) m(LSR_ind_y_2) m(LSR_ind_y_3) m(LSR_ind_y_4) m(LSR_ind_y_5) m(LSR_ind_y_6) m(LSR_ind_y_7) \
+    \
+    m(NOP) \
+    m(NOP_imm) \
+    m(NOP_zpg)   m(NOP_zpg_2) \
+    m(NOP_zpg_x) m(NOP_zpg_x_2) m(NOP_zpg_x_3) \
+    m(NOP_abs)   m(NOP_abs_2)   m(NOP_abs_3) \
+    m(NOP_abs_x) m(NOP_abs_x_2) m(NOP_abs_x_3) m(NOP_abs_x_4) \
+    \
+    m(ORA_imm) \
+    m(ORA_zpg)   m(ORA_zpg_2) \
+    m(ORA_zpg_x) m(ORA_zpg_x_2) m(ORA_zpg_x_3) \
+    m(ORA_abs)   m(ORA_abs_2)   m(ORA_abs_3) \
+    m(ORA_abs_x) m(ORA_abs_x_2) m(ORA_abs_x_3) m(ORA_abs_x_4) \
+    m(ORA_abs_y) m(ORA_abs_y_2) m(ORA_abs_y_3) m(ORA_abs_y_4) \
+    m(ORA_ind_x) m(ORA_ind_x_2) m(ORA_ind_x_3) m(ORA_ind_x_4) m(ORA_ind_x_5) \
+    m(ORA_ind_y) m(ORA_ind_y_2) m(ORA_ind_y_3) m(ORA_ind_y_4) m(ORA_ind_y_5) \
+    \
+    m(PHA) m(PHA_2) \
+    m(PHP) m(PHP_2) \
+    m(PLA) m(PLA_2) m(PLA_3) \
+    m(PLP) m(PLP_2) m(PLP_3) \
+    \
+    m(ROL_acc) \
+    m(ROL_zpg)   m(ROL_zpg_2)   m(ROL_zpg_3)   m(ROL_zpg_4) \
+    m(ROL_zpg_x) m(ROL_zpg_x_2) m(ROL_zpg_x_3) m(ROL_zpg_x_4) m(ROL_zpg_x_5) \
+    m(ROL_abs)   m(ROL_abs_2)   m(ROL_abs_3)   m(ROL_abs_4)   m(ROL_abs_5) \
+    m(ROL_abs_x) m(ROL_abs_x_2) m(ROL_abs_x_3) m(ROL_abs_x_4) m(ROL_abs_x_5) m(ROL_abs_x_6) \
+    m(ROL_ind_x) m(ROL_ind_x_2) m(ROL_ind_x_3) m(ROL_ind_x_4) m(ROL_ind_x_5) m(ROL_ind_x_6) m(ROL_ind_x_7) \
+    \
+    m(ROR_acc) \
+    m(ROR_zpg)   m(ROR_zpg_2)   m(ROR_zpg_3)   m(ROR_zpg_4) \
+    m(ROR_zpg_x) m(ROR_zpg_x_2) m(ROR_zpg_x_3) m(ROR_zpg_x_4) m(ROR_zpg_x_5) \
+    m(ROR_abs)   m(ROR_abs_2)   m(ROR_abs_3)   m(ROR_abs_4)   m(ROR_abs_5) \
+    m(ROR_abs_x) m(ROR_abs_x_2) m(ROR_abs_x_3) m(ROR_abs_x_4) m(ROR_abs_x_5) m(ROR_abs_x_6) \
+    m(ROR_ind_x) m(ROR_ind_x_2) m(ROR_ind_x_3) m(ROR_ind_x_4) m(ROR_ind_x_5) m(ROR_ind_x_6) m(ROR_ind_x_7) \
+    \
+    m(RTI) m(RTI_2) m(RTI_3) m(RTI_4) m(RTI_5) \
+    m(RTS) m(RTS_2) m(RTS_3) m(RTS_4) m(RTS_5) \
+    \
+    m(SBC_imm) \
+    m(SBC_zpg)   m(SBC_zpg_2) \
+    m(SBC_zpg_x) m(SBC_zpg_x_2) m(SBC_zpg_x_3) \
+    m(SBC_abs)   m(SBC_abs_2)   m(SBC_abs_3) \
+    m(SBC_abs_x) m(SBC_abs_x_2) m(SBC_abs_x_3) m(SBC_abs_x_4) \
+    m(SBC_abs_y) m(SBC_abs_y_2) m(SBC_abs_y_3) m(SBC_abs_y_4) \
+    m(SBC_ind_x) m(SBC_ind_x_2) m(SBC_ind_x_3) m(SBC_ind_x_4) m(SBC_ind_x_5) \
+    m(SBC_ind_y) m(SBC_ind_y_2) m(SBC_ind_y_3) m(SBC_ind_y_4) m(SBC_ind_y_5) \
+    \
+    m(SEC) \
+    m(SED) \
+    m(SEI) \
+    \
+    m(STA_zpg)   m(STA_zpg_2) \
+    m(STA_zpg_x) m(STA_zpg_x_2) m(STA_zpg_x_3) \
+    m(STA_abs)   m(STA_abs_2)   m(STA_abs_3) \
+    m(STA_abs_x) m(STA_abs_x_2) m(STA_abs_x_3) m(STA_abs_x_4) \
+    m(STA_abs_y) m(STA_abs_y_2) m(STA_abs_y_3) m(STA_abs_y_4) \
+    m(STA_ind_x) m(STA_ind_x_2) m(STA_ind_x_3) m(STA_ind_x_4) m(STA_ind_x_5) \
+    m(STA_ind_y) m(STA_ind_y_2) m(STA_ind_y_3) m(STA_ind_y_4) m(STA_ind_y_5) \
+    \
+    m(STX_zpg)   m(STX_zpg_2) \
+    m(STX_zpg_y) m(STX_zpg_y_2) m(STX_zpg_y_3) \
+    m(STX_abs)   m(STX_abs_2)   m(STX_abs_3) \
+    \
+    m(STY_zpg)   m(STY_zpg_2) \
+    m(STY_zpg_x) m(STY_zpg_x_2) m(STY_zpg_x_3) \
+    m(STY_abs)   m(STY_abs_2)   m(STY_abs_3) \
+    \
+    m(TAX) \
+    m(TAY) \
+    m(TSX) \
+    m(TXA) \
+    m(TXS) \
+    m(TYA) \
+    \
+    /* Illegal instructions */ \
+    \
+    m(ALR_imm) \
+    m(ANC_imm) \
+    m(ANE_imm) \
+    m(ARR_imm) \
+    m(AXS_imm) \
+    \
+    m(DCP_zpg)   m(DCP_zpg_2)   m(DCP_zpg_3)   m(DCP_zpg_4) \
+    m(DCP_zpg_x) m(DCP_zpg_x_2) m(DCP_zpg_x_3) m(DCP_zpg_x_4) m(DCP_zpg_x_5) \
+    m(DCP_abs)   m(DCP_abs_2)   m(DCP_abs_3)   m(DCP_abs_4)   m(DCP_abs_5) \
+    m(DCP_abs_x) m(DCP_abs_x_2) m(DCP_abs_x_3) m(DCP_abs_x_4) m(DCP_abs_x_5) m(DCP_abs_x_6) \
+    m(DCP_abs_y) m(DCP_abs_y_2) m(DCP_abs_y_3) m(DCP_abs_y_4) m(DCP_abs_y_5) m(DCP_abs_y_6) \
+    m(DCP_ind_x) m(DCP_ind_x_2) m(DCP_ind_x_3) m(DCP_ind_x_4) m(DCP_ind_x_5) m(DCP_ind_x_6) m(DCP_ind_x_7) \
+    m(DCP_ind_y) m(DCP_ind_y_2) m(DCP_ind_y_3) m(DCP_ind_y_4) m(DCP_ind_y_5) m(DCP_ind_y_6) m(DCP_ind_y_7) \
+    \
+    m(ISC_zpg)   m(ISC_zpg_2)   m(ISC_zpg_3)   m(ISC_zpg_4) \
+    m(ISC_zpg_x) m(ISC_zpg_x_2) m(ISC_zpg_x_3) m(ISC_zpg_x_4) m(ISC_zpg_x_5) \
+    m(ISC_abs)   m(ISC_abs_2)   m(ISC_abs_3)   m(ISC_abs_4)   m(ISC_abs_5) \
+    m(ISC_abs_x) m(ISC_abs_x_2) m(ISC_abs_x_3) m(ISC_abs_x_4) m(ISC_abs_x_5) m(ISC_abs_x_6) \
+    m(ISC_abs_y) m(ISC_abs_y_2) m(ISC_abs_y_3) m(ISC_abs_y_4) m(ISC_abs_y_5) m(ISC_abs_y_6) \
+    m(ISC_ind_x) m(ISC_ind_x_2) m(ISC_ind_x_3) m(ISC_ind_x_4) m(ISC_ind_x_5) m(ISC_ind_x_6) m(ISC_ind_x_7) \
+    m(ISC_ind_y) m(ISC_ind_y_2) m(ISC_ind_y_3) m(ISC_ind_y_4) m(ISC_ind_y_5) m(ISC_ind_y_6) m(ISC_ind_y_7) \
+    \
+    m(LAS_abs_y) m(LAS_abs_y_2) m(LAS_abs_y_3) m(LAS_abs_y_4) \
+    \
+    m(LAX_zpg)   m(LAX_zpg_2) \
+    m(LAX_zpg_y) m(LAX_zpg_y_2) m(LAX_zpg_y_3) \
+    m(LAX_abs)   m(LAX_abs_2)   m(LAX_abs_3) \
+    m(LAX_abs_y) m(LAX_abs_y_2) m(LAX_abs_y_3) m(LAX_abs_y_4) \
+    m(LAX_ind_x) m(LAX_ind_x_2) m(LAX_ind_x_3) m(LAX_ind_x_4) m(LAX_ind_x_5) \
+    m(LAX_ind_y) m(LAX_ind_y_2) m(LAX_ind_y_3) m(LAX_ind_y_4) m(LAX_ind_y_5) \
+    \
+    m(LXA_imm) \
+    \
+    m(RLA_zpg)   m(RLA_zpg_2)   m(RLA_zpg_3)   m(RLA_zpg_4) \
+    m(RLA_zpg_x) m(RLA_zpg_x_2) m(RLA_zpg_x_3) m(RLA_zpg_x_4) m(RLA_zpg_x_5) \
+    m(RLA_abs)   m(RLA_abs_2)   m(RLA_abs_3)   m(RLA_abs_4)   m(RLA_abs_5) \
+    m(RLA_abs_x) m(RLA_abs_x_2) m(RLA_abs_x_3) m(RLA_abs_x_4) m(RLA_abs_x_5) m(RLA_abs_x_6) \
+    m(RLA_abs_y) m(RLA_abs_y_2) m(RLA_abs_y_3) m(RLA_abs_y_4) m(RLA_abs_y_5) m(RLA_abs_y_6) \
+    m(RLA_ind_x) m(RLA_ind_x_2) m(RLA_ind_x_3) m(RLA_ind_x_4) m(RLA_ind_x_5) m(RLA_ind_x_6) m(RLA_ind_x_7) \
+    m(RLA_ind_y) m(RLA_ind_y_2) m(RLA_ind_y_3) m(RLA_ind_y_4) m(RLA_ind_y_5) m(RLA_ind_y_6) m(RLA_ind_y_7) \
+    \
+    m(RRA_zpg)   m(RRA_zpg_2)   m(RRA_zpg_3)   m(RRA_zpg_4) \
+    m(RRA_zpg_x) m(RRA_zpg_x_2) m(RRA_zpg_x_3) m(RRA_zpg_x_4) m(RRA_zpg_x_5) \
+    m(RRA_abs)   m(RRA_abs_2)   m(RRA_abs_3)   m(RRA_abs_4)   m(RRA_abs_5) \
+    m(RRA_abs_x) m(RRA_abs_x_2) m(RRA_abs_x_3) m(RRA_abs_x_4) m(RRA_abs_x_5) m(RRA_abs_x_6) \
+    m(RRA_abs_y) m(RRA_abs_y_2) m(RRA_abs_y_3) m(RRA_abs_y_4) m(RRA_abs_y_5) m(RRA_abs_y_6) \
+    m(RRA_ind_x) m(RRA_ind_x_2) m(RRA_ind_x_3) m(RRA_ind_x_4) m(RRA_ind_x_5) m(RRA_ind_x_6) m(RRA_ind_x_7) \
+    m(RRA_ind_y) m(RRA_ind_y_2) m(RRA_ind_y_3) m(RRA_ind_y_4) m(RRA_ind_y_5) m(RRA_ind_y_6) m(RRA_ind_y_7) \
+    \
+    m(SAX_zpg)   m(SAX_zpg_2) \
+    m(SAX_zpg_y) m(SAX_zpg_y_2) m(SAX_zpg_y_3) \
+    m(SAX_abs)   m(SAX_abs_2)   m(SAX_abs_3) \
+    m(SAX_ind_x) m(SAX_ind_x_2) m(SAX_ind_x_3) m(SAX_ind_x_4) m(SAX_ind_x_5) \
+    \
+    m(SHA_ind_y) m(SHA_ind_y_2) m(SHA_ind_y_3) m(SHA_ind_y_4) m(SHA_ind_y_5) \
+    m(SHA_abs_y) m(SHA_abs_y_2) m(SHA_abs_y_3) m(SHA_abs_y_4) \
+    \
+    m(SHX_abs_y) m(SHX_abs_y_2) m(SHX_abs_y_3) m(SHX_abs_y_4) \
+    m(SHY_abs_x) m(SHY_abs_x_2) m(SHY_abs_x_3) m(SHY_abs_x_4) \
+    \
+    m(SLO_zpg)   m(SLO_zpg_2)   m(SLO_zpg_3)   m(SLO_zpg_4) \
+    m(SLO_zpg_x) m(SLO_zpg_x_2) m(SLO_zpg_x_3) m(SLO_zpg_x_4) m(SLO_zpg_x_5) \
+    m(SLO_abs)   m(SLO_abs_2)   m(SLO_abs_3)   m(SLO_abs_4)   m(SLO_abs_5) \
+    m(SLO_abs_x) m(SLO_abs_x_2) m(SLO_abs_x_3) m(SLO_abs_x_4) m(SLO_abs_x_5) m(SLO_abs_x_6) \
+    m(SLO_abs_y) m(SLO_abs_y_2) m(SLO_abs_y_3) m(SLO_abs_y_4) m(SLO_abs_y_5) m(SLO_abs_y_6) \
+    m(SLO_ind_x) m(SLO_ind_x_2) m(SLO_ind_x_3) m(SLO_ind_x_4) m(SLO_ind_x_5) m(SLO_ind_x_6) m(SLO_ind_x_7) \
+    m(SLO_ind_y) m(SLO_ind_y_2) m(SLO_ind_y_3) m(SLO_ind_y_4) m(SLO_ind_y_5) m(SLO_ind_y_6) m(SLO_ind_y_7) \
+    \
+    m(SRE_zpg)   m(SRE_zpg_2)   m(SRE_zpg_3)   m(SRE_zpg_4) \
+    m(SRE_zpg_x) m(SRE_zpg_x_2) m(SRE_zpg_x_3) m(SRE_zpg_x_4) m(SRE_zpg_x_5) \
+    m(SRE_abs)   m(SRE_abs_2)   m(SRE_abs_3)   m(SRE_abs_4)   m(SRE_abs_5) \
+    m(SRE_abs_x) m(SRE_abs_x_2) m(SRE_abs_x_3) m(SRE_abs_x_4) m(SRE_abs_x_5) m(SRE_abs_x_6) \
+    m(SRE_abs_y) m(SRE_abs_y_2) m(SRE_abs_y_3) m(SRE_abs_y_4) m(SRE_abs_y_5) m(SRE_abs_y_6) \
+    m(SRE_ind_x) m(SRE_ind_x_2) m(SRE_ind_x_3) m(SRE_ind_x_4) m(SRE_ind_x_5) m(SRE_ind_x_6) m(SRE_ind_x_7) \
+    m(SRE_ind_y) m(SRE_ind_y_2) m(SRE_ind_y_3) m(SRE_ind_y_4) m(SRE_ind_y_5) m(SRE_ind_y_6) m(SRE_ind_y_7) \
+    \
+    m(TAS_abs_y) m(TAS_abs_y_2) m(TAS_abs_y_3) m(TAS_abs_y_4)
+
 // Microinstructions
 typedef enum {
-    
-    fetch,
-    
-    JAM, JAM_2,
-    
-    irq, irq_2, irq_3, irq_4, irq_5, irq_6, irq_7,
-    nmi, nmi_2, nmi_3, nmi_4, nmi_5, nmi_6, nmi_7,
-    
-    ADC_imm,
-    ADC_zpg,   ADC_zpg_2,
-    ADC_zpg_x, ADC_zpg_x_2, ADC_zpg_x_3,
-    ADC_abs,   ADC_abs_2,   ADC_abs_3,
-    ADC_abs_x, ADC_abs_x_2, ADC_abs_x_3, ADC_abs_x_4,
-    ADC_abs_y, ADC_abs_y_2, ADC_abs_y_3, ADC_abs_y_4,
-    ADC_ind_x, ADC_ind_x_2, ADC_ind_x_3, ADC_ind_x_4, ADC_ind_x_5,
-    ADC_ind_y, ADC_ind_y_2, ADC_ind_y_3, ADC_ind_y_4, ADC_ind_y_5,
-    
-    AND_imm,
-    AND_zpg,   AND_zpg_2,
-    AND_zpg_x, AND_zpg_x_2, AND_zpg_x_3,
-    AND_abs,   AND_abs_2,   AND_abs_3,
-    AND_abs_x, AND_abs_x_2, AND_abs_x_3, AND_abs_x_4,
-    AND_abs_y, AND_abs_y_2, AND_abs_y_3, AND_abs_y_4,
-    AND_ind_x, AND_ind_x_2, AND_ind_x_3, AND_ind_x_4, AND_ind_x_5,
-    AND_ind_y, AND_ind_y_2, AND_ind_y_3, AND_ind_y_4, AND_ind_y_5,
-    
-    ASL_acc,
-    ASL_zpg,   ASL_zpg_2,   ASL_zpg_3,   ASL_zpg_4,
-    ASL_zpg_x, ASL_zpg_x_2, ASL_zpg_x_3, ASL_zpg_x_4, ASL_zpg_x_5,
-    ASL_abs,   ASL_abs_2,   ASL_abs_3,   ASL_abs_4,   ASL_abs_5,
-    ASL_abs_x, ASL_abs_x_2, ASL_abs_x_3, ASL_abs_x_4, ASL_abs_x_5, ASL_abs_x_6,
-    ASL_ind_x, ASL_ind_x_2, ASL_ind_x_3, ASL_ind_x_4, ASL_ind_x_5, ASL_ind_x_6, ASL_ind_x_7,
-    
-    branch_3_underflow, branch_3_overflow,
-    BCC_rel, BCC_rel_2,
-    BCS_rel, BCS_rel_2,
-    BEQ_rel, BEQ_rel_2,
-    
-    BIT_zpg, BIT_zpg_2,
-    BIT_abs, BIT_abs_2, BIT_abs_3,
-    
-    BMI_rel, BMI_rel_2,
-    BNE_rel, BNE_rel_2,
-    BPL_rel, BPL_rel_2,
-    
-    BRK, BRK_2, BRK_3, BRK_4, BRK_5, BRK_6,
-    BRK_nmi_4, BRK_nmi_5, BRK_nmi_6,
-    
-    BVC_rel, BVC_rel_2,
-    BVS_rel, BVS_rel_2,
-    CLC,
-    CLD,
-    CLI,
-    CLV,
-    
-    CMP_imm,
-    CMP_zpg,   CMP_zpg_2,
-    CMP_zpg_x, CMP_zpg_x_2, CMP_zpg_x_3,
-    CMP_abs,   CMP_abs_2,   CMP_abs_3,
-    CMP_abs_x, CMP_abs_x_2, CMP_abs_x_3, CMP_abs_x_4,
-    CMP_abs_y, CMP_abs_y_2, CMP_abs_y_3, CMP_abs_y_4,
-    CMP_ind_x, CMP_ind_x_2, CMP_ind_x_3, CMP_ind_x_4, CMP_ind_x_5,
-    CMP_ind_y, CMP_ind_y_2, CMP_ind_y_3, CMP_ind_y_4, CMP_ind_y_5,
-    
-    CPX_imm,
-    CPX_zpg, CPX_zpg_2,
-    CPX_abs, CPX_abs_2, CPX_abs_3,
-    
-    CPY_imm,
-    CPY_zpg, CPY_zpg_2,
-    CPY_abs, CPY_abs_2, CPY_abs_3,
-    
-    DEC_zpg,   DEC_zpg_2,   DEC_zpg_3,   DEC_zpg_4,
-    DEC_zpg_x, DEC_zpg_x_2, DEC_zpg_x_3, DEC_zpg_x_4, DEC_zpg_x_5,
-    DEC_abs,   DEC_abs_2,   DEC_abs_3,   DEC_abs_4,   DEC_abs_5,
-    DEC_abs_x, DEC_abs_x_2, DEC_abs_x_3, DEC_abs_x_4, DEC_abs_x_5, DEC_abs_x_6,
-    DEC_ind_x, DEC_ind_x_2, DEC_ind_x_3, DEC_ind_x_4, DEC_ind_x_5, DEC_ind_x_6, DEC_ind_x_7,
-    
-    DEX,
-    DEY,
-    
-    EOR_imm,
-    EOR_zpg,   EOR_zpg_2,
-    EOR_zpg_x, EOR_zpg_x_2, EOR_zpg_x_3,
-    EOR_abs,   EOR_abs_2,   EOR_abs_3,
-    EOR_abs_x, EOR_abs_x_2, EOR_abs_x_3, EOR_abs_x_4,
-    EOR_abs_y, EOR_abs_y_2, EOR_abs_y_3, EOR_abs_y_4,
-    EOR_ind_x, EOR_ind_x_2, EOR_ind_x_3, EOR_ind_x_4, EOR_ind_x_5,
-    EOR_ind_y, EOR_ind_y_2, EOR_ind_y_3, EOR_ind_y_4, EOR_ind_y_5,
-    
-    INC_zpg,   INC_zpg_2,   INC_zpg_3,   INC_zpg_4,
-    INC_zpg_x, INC_zpg_x_2, INC_zpg_x_3, INC_zpg_x_4, INC_zpg_x_5,
-    INC_abs,   INC_abs_2,   INC_abs_3,   INC_abs_4,   INC_abs_5,
-    INC_abs_x, INC_abs_x_2, INC_abs_x_3, INC_abs_x_4, INC_abs_x_5, INC_abs_x_6,
-    INC_ind_x, INC_ind_x_2, INC_ind_x_3, INC_ind_x_4, INC_ind_x_5, INC_ind_x_6, INC_ind_x_7,
-    
-    INX,
-    INY,
-    
-    JMP_abs, JMP_abs_2,
-    JMP_abs_indirect, JMP_abs_ind_2, JMP_abs_ind_3, JMP_abs_ind_4,
-    
-    JSR, JSR_2, JSR_3, JSR_4, JSR_5,
-    
-    LDA_imm,
-    LDA_zpg,   LDA_zpg_2,
-    LDA_zpg_x, LDA_zpg_x_2, LDA_zpg_x_3,
-    LDA_abs,   LDA_abs_2,   LDA_abs_3,
-    LDA_abs_x, LDA_abs_x_2, LDA_abs_x_3, LDA_abs_x_4,
-    LDA_abs_y, LDA_abs_y_2, LDA_abs_y_3, LDA_abs_y_4,
-    LDA_ind_x, LDA_ind_x_2, LDA_ind_x_3, LDA_ind_x_4, LDA_ind_x_5,
-    LDA_ind_y, LDA_ind_y_2, LDA_ind_y_3, LDA_ind_y_4, LDA_ind_y_5,
-    
-    LDX_imm,
-    LDX_zpg,   LDX_zpg_2,
-    LDX_zpg_y, LDX_zpg_y_2, LDX_zpg_y_3,
-    LDX_abs,   LDX_abs_2,   LDX_abs_3,
-    LDX_abs_y, LDX_abs_y_2, LDX_abs_y_3, LDX_abs_y_4,
-    LDX_ind_x, LDX_ind_x_2, LDX_ind_x_3, LDX_ind_x_4, LDX_ind_x_5,
-    LDX_ind_y, LDX_ind_y_2, LDX_ind_y_3, LDX_ind_y_4, LDX_ind_y_5,
-    
-    LDY_imm,
-    LDY_zpg,   LDY_zpg_2,
-    LDY_zpg_x, LDY_zpg_x_2, LDY_zpg_x_3,
-    LDY_abs,   LDY_abs_2,   LDY_abs_3,
-    LDY_abs_x, LDY_abs_x_2, LDY_abs_x_3, LDY_abs_x_4,
-    LDY_ind_x, LDY_ind_x_2, LDY_ind_x_3, LDY_ind_x_4, LDY_ind_x_5,
-    LDY_ind_y, LDY_ind_y_2, LDY_ind_y_3, LDY_ind_y_4, LDY_ind_y_5,
-    
-    LSR_acc,
-    LSR_zpg,   LSR_zpg_2,   LSR_zpg_3,   LSR_zpg_4,
-    LSR_zpg_x, LSR_zpg_x_2, LSR_zpg_x_3, LSR_zpg_x_4, LSR_zpg_x_5,
-    LSR_abs,   LSR_abs_2,   LSR_abs_3,   LSR_abs_4,   LSR_abs_5,
-    LSR_abs_x, LSR_abs_x_2, LSR_abs_x_3, LSR_abs_x_4, LSR_abs_x_5, LSR_abs_x_6,
-    LSR_abs_y, LSR_abs_y_2, LSR_abs_y_3, LSR_abs_y_4, LSR_abs_y_5, LSR_abs_y_6,
-    LSR_ind_x, LSR_ind_x_2, LSR_ind_x_3, LSR_ind_x_4, LSR_ind_x_5, LSR_ind_x_6, LSR_ind_x_7,
-    LSR_ind_y, LSR_ind_y_2, LSR_ind_y_3, LSR_ind_y_4, LSR_ind_y_5, LSR_ind_y_6, LSR_ind_y_7,
-    
-    NOP,
-    NOP_imm,
-    NOP_zpg,   NOP_zpg_2,
-    NOP_zpg_x, NOP_zpg_x_2, NOP_zpg_x_3,
-    NOP_abs,   NOP_abs_2,   NOP_abs_3,
-    NOP_abs_x, NOP_abs_x_2, NOP_abs_x_3, NOP_abs_x_4,
-    
-    ORA_imm,
-    ORA_zpg,   ORA_zpg_2,
-    ORA_zpg_x, ORA_zpg_x_2, ORA_zpg_x_3,
-    ORA_abs,   ORA_abs_2,   ORA_abs_3,
-    ORA_abs_x, ORA_abs_x_2, ORA_abs_x_3, ORA_abs_x_4,
-    ORA_abs_y, ORA_abs_y_2, ORA_abs_y_3, ORA_abs_y_4,
-    ORA_ind_x, ORA_ind_x_2, ORA_ind_x_3, ORA_ind_x_4, ORA_ind_x_5,
-    ORA_ind_y, ORA_ind_y_2, ORA_ind_y_3, ORA_ind_y_4, ORA_ind_y_5,
-    
-    PHA, PHA_2,
-    PHP, PHP_2,
-    PLA, PLA_2, PLA_3,
-    PLP, PLP_2, PLP_3,
-    
-    ROL_acc,
-    ROL_zpg,   ROL_zpg_2,   ROL_zpg_3,   ROL_zpg_4,
-    ROL_zpg_x, ROL_zpg_x_2, ROL_zpg_x_3, ROL_zpg_x_4, ROL_zpg_x_5,
-    ROL_abs,   ROL_abs_2,   ROL_abs_3,   ROL_abs_4,   ROL_abs_5,
-    ROL_abs_x, ROL_abs_x_2, ROL_abs_x_3, ROL_abs_x_4, ROL_abs_x_5, ROL_abs_x_6,
-    ROL_ind_x, ROL_ind_x_2, ROL_ind_x_3, ROL_ind_x_4, ROL_ind_x_5, ROL_ind_x_6, ROL_ind_x_7,
-    
-    ROR_acc,
-    ROR_zpg,   ROR_zpg_2,   ROR_zpg_3,   ROR_zpg_4,
-    ROR_zpg_x, ROR_zpg_x_2, ROR_zpg_x_3, ROR_zpg_x_4, ROR_zpg_x_5,
-    ROR_abs,   ROR_abs_2,   ROR_abs_3,   ROR_abs_4,   ROR_abs_5,
-    ROR_abs_x, ROR_abs_x_2, ROR_abs_x_3, ROR_abs_x_4, ROR_abs_x_5, ROR_abs_x_6,
-    ROR_ind_x, ROR_ind_x_2, ROR_ind_x_3, ROR_ind_x_4, ROR_ind_x_5, ROR_ind_x_6, ROR_ind_x_7,
-    
-    RTI, RTI_2, RTI_3, RTI_4, RTI_5,
-    RTS, RTS_2, RTS_3, RTS_4, RTS_5,
-    
-    SBC_imm,
-    SBC_zpg,   SBC_zpg_2,
-    SBC_zpg_x, SBC_zpg_x_2, SBC_zpg_x_3,
-    SBC_abs,   SBC_abs_2,   SBC_abs_3,
-    SBC_abs_x, SBC_abs_x_2, SBC_abs_x_3, SBC_abs_x_4,
-    SBC_abs_y, SBC_abs_y_2, SBC_abs_y_3, SBC_abs_y_4,
-    SBC_ind_x, SBC_ind_x_2, SBC_ind_x_3, SBC_ind_x_4, SBC_ind_x_5,
-    SBC_ind_y, SBC_ind_y_2, SBC_ind_y_3, SBC_ind_y_4, SBC_ind_y_5,
-    
-    SEC,
-    SED,
-    SEI,
-    
-    STA_zpg,   STA_zpg_2,
-    STA_zpg_x, STA_zpg_x_2, STA_zpg_x_3,
-    STA_abs,   STA_abs_2,   STA_abs_3,
-    STA_abs_x, STA_abs_x_2, STA_abs_x_3, STA_abs_x_4,
-    STA_abs_y, STA_abs_y_2, STA_abs_y_3, STA_abs_y_4,
-    STA_ind_x, STA_ind_x_2, STA_ind_x_3, STA_ind_x_4, STA_ind_x_5,
-    STA_ind_y, STA_ind_y_2, STA_ind_y_3, STA_ind_y_4, STA_ind_y_5,
-    
-    STX_zpg,   STX_zpg_2,
-    STX_zpg_y, STX_zpg_y_2, STX_zpg_y_3,
-    STX_abs,   STX_abs_2,   STX_abs_3,
-    
-    STY_zpg,   STY_zpg_2,
-    STY_zpg_x, STY_zpg_x_2, STY_zpg_x_3,
-    STY_abs,   STY_abs_2,   STY_abs_3,
-    
-    TAX,
-    TAY,
-    TSX,
-    TXA,
-    TXS,
-    TYA,
-    
-    // Illegal instructions
-    
-    ALR_imm,
-    ANC_imm,
-    ANE_imm,
-    ARR_imm,
-    AXS_imm,
-    
-    DCP_zpg,   DCP_zpg_2,   DCP_zpg_3,   DCP_zpg_4,
-    DCP_zpg_x, DCP_zpg_x_2, DCP_zpg_x_3, DCP_zpg_x_4, DCP_zpg_x_5,
-    DCP_abs,   DCP_abs_2,   DCP_abs_3,   DCP_abs_4,   DCP_abs_5,
-    DCP_abs_x, DCP_abs_x_2, DCP_abs_x_3, DCP_abs_x_4, DCP_abs_x_5, DCP_abs_x_6,
-    DCP_abs_y, DCP_abs_y_2, DCP_abs_y_3, DCP_abs_y_4, DCP_abs_y_5, DCP_abs_y_6,
-    DCP_ind_x, DCP_ind_x_2, DCP_ind_x_3, DCP_ind_x_4, DCP_ind_x_5, DCP_ind_x_6, DCP_ind_x_7,
-    DCP_ind_y, DCP_ind_y_2, DCP_ind_y_3, DCP_ind_y_4, DCP_ind_y_5, DCP_ind_y_6, DCP_ind_y_7,
-    
-    ISC_zpg,   ISC_zpg_2,   ISC_zpg_3,   ISC_zpg_4,
-    ISC_zpg_x, ISC_zpg_x_2, ISC_zpg_x_3, ISC_zpg_x_4, ISC_zpg_x_5,
-    ISC_abs,   ISC_abs_2,   ISC_abs_3,   ISC_abs_4,   ISC_abs_5,
-    ISC_abs_x, ISC_abs_x_2, ISC_abs_x_3, ISC_abs_x_4, ISC_abs_x_5, ISC_abs_x_6,
-    ISC_abs_y, ISC_abs_y_2, ISC_abs_y_3, ISC_abs_y_4, ISC_abs_y_5, ISC_abs_y_6,
-    ISC_ind_x, ISC_ind_x_2, ISC_ind_x_3, ISC_ind_x_4, ISC_ind_x_5, ISC_ind_x_6, ISC_ind_x_7,
-    ISC_ind_y, ISC_ind_y_2, ISC_ind_y_3, ISC_ind_y_4, ISC_ind_y_5, ISC_ind_y_6, ISC_ind_y_7,
-    
-    LAS_abs_y, LAS_abs_y_2, LAS_abs_y_3, LAS_abs_y_4,
-    
-    LAX_zpg,   LAX_zpg_2,
-    LAX_zpg_y, LAX_zpg_y_2, LAX_zpg_y_3,
-    LAX_abs,   LAX_abs_2,   LAX_abs_3,
-    LAX_abs_y, LAX_abs_y_2, LAX_abs_y_3, LAX_abs_y_4,
-    LAX_ind_x, LAX_ind_x_2, LAX_ind_x_3, LAX_ind_x_4, LAX_ind_x_5,
-    LAX_ind_y, LAX_ind_y_2, LAX_ind_y_3, LAX_ind_y_4, LAX_ind_y_5,
-    
-    LXA_imm,
-    
-    RLA_zpg,   RLA_zpg_2,   RLA_zpg_3,   RLA_zpg_4,
-    RLA_zpg_x, RLA_zpg_x_2, RLA_zpg_x_3, RLA_zpg_x_4, RLA_zpg_x_5,
-    RLA_abs,   RLA_abs_2,   RLA_abs_3,   RLA_abs_4,   RLA_abs_5,
-    RLA_abs_x, RLA_abs_x_2, RLA_abs_x_3, RLA_abs_x_4, RLA_abs_x_5, RLA_abs_x_6,
-    RLA_abs_y, RLA_abs_y_2, RLA_abs_y_3, RLA_abs_y_4, RLA_abs_y_5, RLA_abs_y_6,
-    RLA_ind_x, RLA_ind_x_2, RLA_ind_x_3, RLA_ind_x_4, RLA_ind_x_5, RLA_ind_x_6, RLA_ind_x_7,
-    RLA_ind_y, RLA_ind_y_2, RLA_ind_y_3, RLA_ind_y_4, RLA_ind_y_5, RLA_ind_y_6, RLA_ind_y_7,
-    
-    RRA_zpg,   RRA_zpg_2,   RRA_zpg_3,   RRA_zpg_4,
-    RRA_zpg_x, RRA_zpg_x_2, RRA_zpg_x_3, RRA_zpg_x_4, RRA_zpg_x_5,
-    RRA_abs,   RRA_abs_2,   RRA_abs_3,   RRA_abs_4,   RRA_abs_5,
-    RRA_abs_x, RRA_abs_x_2, RRA_abs_x_3, RRA_abs_x_4, RRA_abs_x_5, RRA_abs_x_6,
-    RRA_abs_y, RRA_abs_y_2, RRA_abs_y_3, RRA_abs_y_4, RRA_abs_y_5, RRA_abs_y_6,
-    RRA_ind_x, RRA_ind_x_2, RRA_ind_x_3, RRA_ind_x_4, RRA_ind_x_5, RRA_ind_x_6, RRA_ind_x_7,
-    RRA_ind_y, RRA_ind_y_2, RRA_ind_y_3, RRA_ind_y_4, RRA_ind_y_5, RRA_ind_y_6, RRA_ind_y_7,
-    
-    SAX_zpg,   SAX_zpg_2,
-    SAX_zpg_y, SAX_zpg_y_2, SAX_zpg_y_3,
-    SAX_abs,   SAX_abs_2,   SAX_abs_3,
-    SAX_ind_x, SAX_ind_x_2, SAX_ind_x_3, SAX_ind_x_4, SAX_ind_x_5,
-    
-    SHA_ind_y, SHA_ind_y_2, SHA_ind_y_3, SHA_ind_y_4, SHA_ind_y_5,
-    SHA_abs_y, SHA_abs_y_2, SHA_abs_y_3, SHA_abs_y_4,
-    
-    SHX_abs_y, SHX_abs_y_2, SHX_abs_y_3, SHX_abs_y_4,
-    SHY_abs_x, SHY_abs_x_2, SHY_abs_x_3, SHY_abs_x_4,
-    
-    SLO_zpg,   SLO_zpg_2,   SLO_zpg_3,   SLO_zpg_4,
-    SLO_zpg_x, SLO_zpg_x_2, SLO_zpg_x_3, SLO_zpg_x_4, SLO_zpg_x_5,
-    SLO_abs,   SLO_abs_2,   SLO_abs_3,   SLO_abs_4,   SLO_abs_5,
-    SLO_abs_x, SLO_abs_x_2, SLO_abs_x_3, SLO_abs_x_4, SLO_abs_x_5, SLO_abs_x_6,
-    SLO_abs_y, SLO_abs_y_2, SLO_abs_y_3, SLO_abs_y_4, SLO_abs_y_5, SLO_abs_y_6,
-    SLO_ind_x, SLO_ind_x_2, SLO_ind_x_3, SLO_ind_x_4, SLO_ind_x_5, SLO_ind_x_6, SLO_ind_x_7,
-    SLO_ind_y, SLO_ind_y_2, SLO_ind_y_3, SLO_ind_y_4, SLO_ind_y_5, SLO_ind_y_6, SLO_ind_y_7,
-    
-    SRE_zpg,   SRE_zpg_2,   SRE_zpg_3,   SRE_zpg_4,
-    SRE_zpg_x, SRE_zpg_x_2, SRE_zpg_x_3, SRE_zpg_x_4, SRE_zpg_x_5,
-    SRE_abs,   SRE_abs_2,   SRE_abs_3,   SRE_abs_4,   SRE_abs_5,
-    SRE_abs_x, SRE_abs_x_2, SRE_abs_x_3, SRE_abs_x_4, SRE_abs_x_5, SRE_abs_x_6,
-    SRE_abs_y, SRE_abs_y_2, SRE_abs_y_3, SRE_abs_y_4, SRE_abs_y_5, SRE_abs_y_6,
-    SRE_ind_x, SRE_ind_x_2, SRE_ind_x_3, SRE_ind_x_4, SRE_ind_x_5, SRE_ind_x_6, SRE_ind_x_7,
-    SRE_ind_y, SRE_ind_y_2, SRE_ind_y_3, SRE_ind_y_4, SRE_ind_y_5, SRE_ind_y_6, SRE_ind_y_7,
-    
-    TAS_abs_y, TAS_abs_y_2, TAS_abs_y_3, TAS_abs_y_4
-    
+#define MICRO_INSTRUCTION_ENUM(name) name,
+    MICRO_INSTRUCTIONS(MICRO_INSTRUCTION_ENUM)
+#undef MICRO_INSTRUCTION_ENUM
 } MicroInstruction;
 
 // Atomic CPU tasks
@@ -0,0 +1,364 @@
+/*!
+ * @header      Movie.cpp
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "C64.h"
+
+static const char movieMagic[8] = { 'V', 'C', '6', '4', 'M', 'O', 'V', 0 };
+
+Movie::Movie()
+{
+    setDescription("Movie");
+    debug(3, "Creating movie recorder at address %p...\n", this);
+
+    r = w = 0;
+    lostEvents = 0;
+    pthread_mutex_init(&lock, NULL);
+    pending = false;
+
+    state = MOVIE_IDLE;
+    snapshot = NULL;
+    mouseModel = MOUSE1350;
+    mousePort = 0;
+    next = 0;
+}
+
+Movie::~Movie()
+{
+    delete snapshot;
+    pthread_mutex_destroy(&lock);
+}
+
+void
+Movie::dumpState()
+{
+    msg("Movie:\n");
+    msg("------\n\n");
+    msg("         State : %s\n",
+        state == MOVIE_RECORDING ? "Recording" : state == MOVIE_PLAYING ? "Playing" : "Idle");
+    msg("        Events : %zu\n", events.size());
+    msg("    Next event : %zu\n", next);
+    msg("  Queued input : %u\n", (w - r) % queueSize);
+    msg("   Lost events : %llu\n", (unsigned long long)lostEvents);
+    msg("\n");
+}
+
+void
+Movie::setMouseXY(int64_t x, int64_t y)
+{
+    submit(INPUT_MOUSE_XY, 0, 0, (int32_t)x, (int32_t)y);
+}
+
+void
+Movie::submit(InputEventType type, uint8_t data1, uint8_t data2, int32_t x, int32_t y)
+{
+    InputEvent event;
+
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.data1 = data1;
+    event.data2 = data2;
+    event.x = x;
+    event.y = y;
+
+    pthread_mutex_lock(&lock);
+
+    if ((w + 1) % queueSize == r) {
+        // The event is neither applied nor recorded. Hence, a recording stays consistent.
+        warn("Input queue overflow. Event is lost.\n");
+        lostEvents++;
+    } else {
+        queue[w] = event;
+        w = (w + 1) % queueSize;
+        pending = true;
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+void
+Movie::processInput()
+{
+    pthread_mutex_lock(&lock);
+
+    for (; r != w; r = (r + 1) % queueSize) {
+
+        // The movie is in control while playing
+        if (state == MOVIE_PLAYING)
+            continue;
+
+        queue[r].cycle = c64->getCycles();
+        apply(queue[r]);
+        if (state == MOVIE_RECORDING) {
+            events.push_back(queue[r]);
+        }
+    }
+    pending = false;
+
+    pthread_mutex_unlock(&lock);
+}
+
+void
+Movie::execute()
+{
+    uint64_t cycle = c64->getCycles();
+
+    if (state != MOVIE_PLAYING) {
+        c64->cancelEvent(EVENT_INPUT);
+        return;
+    }
+
+    while (next < events.size() && events[next].cycle <= cycle) {
+        apply(events[next++]);
+    }
+
+    if (next < events.size()) {
+        c64->scheduleEvent(EVENT_INPUT, events[next].cycle);
+    } else {
+        debug(1, "Movie has ended in cycle %llu\n", (unsigned long long)cycle);
+        state = MOVIE_IDLE;
+        c64->cancelEvent(EVENT_INPUT);
+    }
+}
+
+void
+Movie::apply(const InputEvent &event)
+{
+    switch (event.type) {
+
+        case INPUT_KEY_PRESS:
+            c64->keyboard.pressKey(event.data1 & 7, event.data2 & 7);
+            break;
+        case INPUT_KEY_RELEASE:
+            c64->keyboard.releaseKey(event.data1 & 7, event.data2 & 7);
+            break;
+        case INPUT_RELEASE_ALL_KEYS:
+            c64->keyboard.releaseAll();
+            break;
+        case INPUT_RESTORE_PRESS:
+            c64->keyboard.pressRestoreKey();
+            break;
+        case INPUT_RESTORE_RELEASE:
+            c64->keyboard.releaseRestoreKey();
+            break;
+        case INPUT_SHIFT_LOCK_PRESS:
+            c64->keyboard.pressShiftLockKey();
+            break;
+        case INPUT_SHIFT_LOCK_RELEASE:
+            c64->keyboard.releaseShiftLockKey();
+            break;
+        case INPUT_JOYSTICK:
+            if (event.data1 == 1) c64->port1.trigger((JoystickEvent)event.data2);
+            if (event.data1 == 2) c64->port2.trigger((JoystickEvent)event.data2);
+            break;
+        case INPUT_MOUSE_XY:
+            c64->mouse->setXY(event.x, event.y);
+            break;
+        case INPUT_MOUSE_LEFT:
+            c64->mouse->leftButton = event.data1;
+            break;
+        case INPUT_MOUSE_RIGHT:
+            c64->mouse->rightButton = event.data1;
+            break;
+        default:
+            warn("Unknown input event %d\n", event.type);
+    }
+}
+
+void
+Movie::resetMouse()
+{
+    c64->mouse->reset();
+}
+
+void
+Movie::startRecording()
+{
+    debug(1, "Start recording\n");
+
+    c64->suspend();
+
+    delete snapshot;
+    snapshot = c64->takeSnapshotUnsafe();
+
+    // Continue with exactly the state a replay will start with
+    c64->loadFromSnapshotUnsafe(snapshot);
+    mouseModel = (uint8_t)c64->getMouseModel();
+    mousePort = (uint8_t)c64->mousePort;
+    resetMouse();
+
+    events.clear();
+    next = 0;
+    state = MOVIE_RECORDING;
+
+    c64->resume();
+}
+
+void
+Movie::stop()
+{
+    c64->suspend();
+
+    if (state == MOVIE_RECORDING) {
+        debug(1, "Stop recording (%zu events)\n", events.size());
+    }
+    state = MOVIE_IDLE;
+    c64->cancelEvent(EVENT_INPUT);
+
+    c64->resume();
+}
+
+bool
+Movie::startPlaying()
+{
+    if (snapshot == NULL)
+        return false;
+
+    debug(1, "Start playing (%zu events)\n", events.size());
+
+    // Configure the mouse before suspending (setMouseModel() suspends, too)
+    c64->setMouseModel((MouseModel)mouseModel);
+    c64->connectMouse(mousePort);
+
+    c64->suspend();
+
+    c64->loadFromSnapshotUnsafe(snapshot);
+    resetMouse();
+
+    // Discard all input that has been queued before
+    pthread_mutex_lock(&lock);
+    r = w;
+    pending = false;
+    pthread_mutex_unlock(&lock);
+
+    next = 0;
+    state = MOVIE_PLAYING;
+    c64->scheduleEvent(EVENT_INPUT, events.empty() ? 0 : events[0].cycle);
+
+    c64->resume();
+    return true;
+}
+
+bool
+Movie::writeToFile(const char *path)
+{
+    if (snapshot == NULL || state == MOVIE_RECORDING)
+        return false;
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        warn("Cannot write movie %s\n", path);
+        return false;
+    }
+
+    size_t snapshotSize = snapshot->writeToBuffer(NULL);
+    uint8_t *buffer = new uint8_t[snapshotSize];
+    snapshot->writeToBuffer(buffer);
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, movieMagic, sizeof(header.magic));
+    header.version = fileVersion;
+    header.eventSize = sizeof(InputEvent);
+    header.mouseModel = mouseModel;
+    header.mousePort = mousePort;
+    header.snapshotSize = snapshotSize;
+    header.numEvents = events.size();
+
+    bool success =
+    fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(buffer, 1, snapshotSize, file) == snapshotSize &&
+    fwrite(events.data(), sizeof(InputEvent), events.size(), file) == events.size();
+
+    delete[] buffer;
+    if (fclose(file) != 0 || !success) {
+        warn("Failed to write movie %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+bool
+Movie::readFromFile(const char *path)
+{
+    FileHeader header;
+    Snapshot *newSnapshot = NULL;
+    std::vector<InputEvent> newEvents;
+    uint8_t *buffer = NULL;
+    long payload;
+    bool success = false;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        warn("Cannot open movie %s\n", path);
+        return false;
+    }
+
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, movieMagic, sizeof(header.magic)) != 0) {
+        warn("%s is not a movie file\n", path);
+        goto exit;
+    }
+    if (header.version != fileVersion || header.eventSize != sizeof(InputEvent)) {
+        warn("Unsupported movie format (version %d)\n", header.version);
+        goto exit;
+    }
+
+    // Don't trust the sizes in the header
+    payload = getSizeOfFile(path) - (long)sizeof(header);
+    if (payload < 0 ||
+        header.snapshotSize > (uint64_t)payload ||
+        header.numEvents > ((uint64_t)payload - header.snapshotSize) / sizeof(InputEvent)) {
+        warn("Movie %s is truncated\n", path);
+        goto exit;
+    }
+    
+    // Read snapshot
+    buffer = new uint8_t[header.snapshotSize];
+    if (fread(buffer, 1, header.snapshotSize, file) != header.snapshotSize ||
+        !Snapshot::isSupportedSnapshot(buffer, header.snapshotSize) ||
+        (newSnapshot = Snapshot::makeSnapshotWithBuffer(buffer, header.snapshotSize)) == NULL) {
+        warn("Movie %s does not contain a supported snapshot\n", path);
+        goto exit;
+    }
+
+    // Read events
+    newEvents.resize(header.numEvents);
+    if (fread(newEvents.data(), sizeof(InputEvent), header.numEvents, file) != header.numEvents) {
+        warn("Movie %s is truncated\n", path);
+        goto exit;
+    }
+
+    // Replace the current movie
+    stop();
+    delete snapshot;
+    snapshot = newSnapshot;
+    newSnapshot = NULL;
+    events.swap(newEvents);
+    mouseModel = header.mouseModel;
+    mousePort = header.mousePort;
+    next = 0;
+    success = true;
+
+exit:
+    delete[] buffer;
+    delete newSnapshot;
+    fclose(file);
+    return success;
+}
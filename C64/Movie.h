@@ -0,0 +1,199 @@
+/*!
+ * @header      Movie.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MOVIE_INC
+#define _MOVIE_INC
+
+#include "VirtualComponent.h"
+#include "Snapshot.h"
+#include <atomic>
+#include <vector>
+
+/*! @class    Movie
+ *  @brief    Deterministic recording and replay of user input
+ *  @details  The GUI reports keyboard, joystick, and mouse input by calling the input
+ *            functions of this class. They can be called from any thread. The events
+ *            are queued and applied by the emulator thread at the end of the current
+ *            rasterline. Hence, each event takes effect in a well defined cycle.
+ *
+ *            While recording, each applied event is stored together with this cycle.
+ *            A recording starts with a snapshot. During playback, the snapshot is
+ *            restored and the events are injected via the EVENT_INPUT slot of the
+ *            component scheduler, i.e., in exactly the cycles they have been recorded
+ *            in. All input coming from the GUI is discarded while a movie is playing.
+ *
+ *            The mouse is not part of a snapshot. Therefore, the selected mouse model
+ *            and port are stored in the movie and the mouse is reset when a recording
+ *            or playback starts. Restoring a snapshot or resetting the C64 while a
+ *            movie is recorded or played breaks the recording.
+ *
+ *            A movie file starts with a 32 byte header (magic "VC64MOV", format version,
+ *            event size, mouse configuration, snapshot size, and number of events),
+ *            followed by the snapshot and the events in host byte order.
+ */
+class Movie : public VirtualComponent {
+
+public:
+
+    //! @brief    Version of the movie file format
+    static const uint16_t fileVersion = 1;
+
+    //! @brief    Header of a movie file
+    typedef struct {
+        char magic[8];
+        uint16_t version;
+        uint16_t eventSize;
+        uint8_t mouseModel;
+        uint8_t mousePort;
+        uint8_t reserved[2];
+        uint64_t snapshotSize;
+        uint64_t numEvents;
+    } FileHeader;
+
+private:
+
+    //! @brief    Maximum number of queued events
+    static const unsigned queueSize = 256;
+
+    //! @brief    Events reported by the GUI that have not been applied yet
+    InputEvent queue[queueSize];
+
+    //! @brief    Read and write pointer of the queue
+    unsigned r, w;
+
+    //! @brief    Mutex for streamlining parallel read and write accesses
+    pthread_mutex_t lock;
+
+    //! @brief    Indicates that the queue is not empty
+    std::atomic<bool> pending;
+
+    //! @brief    Number of events that have been dropped because the queue was full
+    uint64_t lostEvents;
+
+    //! @brief    Current state
+    MovieState state;
+
+    //! @brief    Snapshot the movie starts with
+    Snapshot *snapshot;
+
+    //! @brief    Mouse configuration the movie starts with
+    uint8_t mouseModel;
+    uint8_t mousePort;
+
+    //! @brief    Recorded events
+    std::vector<InputEvent> events;
+
+    //! @brief    Index of the next event to replay
+    size_t next;
+
+public:
+
+    //! @brief    Constructor
+    Movie();
+
+    //! @brief    Destructor
+    ~Movie();
+
+    //! @brief    Dumps the current state into the message queue
+    void dumpState();
+
+
+    //
+    //! @functiongroup Reporting input (callable from any thread)
+    //
+
+    void pressKey(uint8_t row, uint8_t col) { submit(INPUT_KEY_PRESS, row, col); }
+    void releaseKey(uint8_t row, uint8_t col) { submit(INPUT_KEY_RELEASE, row, col); }
+    void releaseAllKeys() { submit(INPUT_RELEASE_ALL_KEYS); }
+    void pressRestoreKey() { submit(INPUT_RESTORE_PRESS); }
+    void releaseRestoreKey() { submit(INPUT_RESTORE_RELEASE); }
+    void pressShiftLockKey() { submit(INPUT_SHIFT_LOCK_PRESS); }
+    void releaseShiftLockKey() { submit(INPUT_SHIFT_LOCK_RELEASE); }
+    void trigger(unsigned port, JoystickEvent event) { submit(INPUT_JOYSTICK, port, event); }
+    void setMouseXY(int64_t x, int64_t y);
+    void setMouseLeftButton(bool pressed) { submit(INPUT_MOUSE_LEFT, pressed); }
+    void setMouseRightButton(bool pressed) { submit(INPUT_MOUSE_RIGHT, pressed); }
+
+
+    //
+    //! @functiongroup Recording and playing
+    //
+
+    //! @brief    Returns the current state
+    MovieState getState() { return state; }
+
+    //! @brief    Returns true iff a movie is being recorded
+    bool isRecording() { return state == MOVIE_RECORDING; }
+
+    //! @brief    Returns true iff a movie is being played
+    bool isPlaying() { return state == MOVIE_PLAYING; }
+
+    //! @brief    Returns the number of recorded or loaded events
+    size_t numEvents() { return events.size(); }
+
+    //! @brief    Takes a snapshot and starts recording
+    void startRecording();
+
+    //! @brief    Stops recording or playing
+    void stop();
+
+    /*! @brief    Writes the recorded movie into a file
+     *  @return   false if there is no movie or the file cannot be written
+     */
+    bool writeToFile(const char *path);
+
+    /*! @brief    Reads a movie from a file
+     *  @return   false if the file cannot be read or is not a supported movie
+     */
+    bool readFromFile(const char *path);
+
+    /*! @brief    Restores the snapshot of the movie and starts playing
+     *  @return   false if no movie has been recorded or loaded
+     */
+    bool startPlaying();
+
+
+    //
+    //! @functiongroup Executing (emulator thread)
+    //
+
+    //! @brief    Returns true iff the GUI has reported input that is not applied yet
+    bool hasPendingInput() { return pending.load(std::memory_order_relaxed); }
+
+    //! @brief    Applies all queued input (called at the end of each rasterline)
+    void processInput();
+
+    //! @brief    Replays all events that are due (called via EVENT_INPUT)
+    void execute();
+
+private:
+
+    //! @brief    Queues an input event
+    void submit(InputEventType type, uint8_t data1 = 0, uint8_t data2 = 0,
+                int32_t x = 0, int32_t y = 0);
+
+    //! @brief    Feeds an event into the keyboard, a control port, or the mouse
+    void apply(const InputEvent &event);
+
+    //! @brief    Brings the mouse into the state a movie starts with
+    void resetMouse();
+};
+
+#endif
@@ -0,0 +1,54 @@
+//
+//  Movie_types.h
+//  V64
+//
+//  Created by Dirk Hoffmann
+//
+
+#ifndef MOVIE_TYPES_H
+#define MOVIE_TYPES_H
+
+#include <stdint.h>
+
+/*! @brief    Input events
+ *  @details  Every change of the keyboard, joystick, or mouse state is described by
+ *            one of these events. The meaning of the event parameters is given in
+ *            brackets.
+ */
+typedef enum : uint8_t {
+    INPUT_KEY_PRESS,            // (row, col)
+    INPUT_KEY_RELEASE,          // (row, col)
+    INPUT_RELEASE_ALL_KEYS,
+    INPUT_RESTORE_PRESS,
+    INPUT_RESTORE_RELEASE,
+    INPUT_SHIFT_LOCK_PRESS,
+    INPUT_SHIFT_LOCK_RELEASE,
+    INPUT_JOYSTICK,             // (port, JoystickEvent)
+    INPUT_MOUSE_XY,             // (x, y)
+    INPUT_MOUSE_LEFT,           // (pressed)
+    INPUT_MOUSE_RIGHT           // (pressed)
+} InputEventType;
+
+/*! @brief    Time stamped input event
+ *  @details  cycle is the C64 cycle in which the event takes effect. The event is
+ *            applied before the CPU executes this cycle.
+ */
+typedef struct {
+    uint64_t cycle;
+    int32_t x;
+    int32_t y;
+    InputEventType type;
+    uint8_t data1;
+    uint8_t data2;
+    uint8_t reserved[5];
+} InputEvent;
+
+/*! @brief    Movie state
+ */
+typedef enum {
+    MOVIE_IDLE,
+    MOVIE_RECORDING,
+    MOVIE_PLAYING
+} MovieState;
+
+#endif
@@ -26,8 +26,21 @@ PixelEngine::PixelEngine()
     
     debug(3, "  Creating PixelEngine at address %p...\n", this);
     
-    currentScreenBuffer = screenBuffer1[0];
-    pixelBuffer = currentScreenBuffer;
+    writeSlot = 0;
+    stableSlot = 1;
+    readSlot = 2;
+    readySlot = 1;
+    memset(frameNr, 0, sizeof(frameNr));
+    
+    memset(frames, 0, sizeof(frames));
+    indexFrame = NULL;
+    patternPending = 0;
+    paletteIndexMode = false;
+    allocateFrames();
+    renderPolicy = RENDER_ALL_FRAMES;
+    renderInterval = 1;
+    renderRequested = false;
+    rendering = true;
     bufferoffset = 0;
 
     // Register snapshot items
@@ -56,6 +69,10 @@ PixelEngine::PixelEngine()
 PixelEngine::~PixelEngine()
 {
     debug(3, "  Releasing PixelEngine...\n");
+    
+    for (unsigned slot = 0; slot < 3; slot++)
+        delete[] frames[slot];
+    delete[] indexFrame;
 }
 
 void
@@ -72,23 +89,153 @@ PixelEngine::reset()
 
 void
 PixelEngine::resetScreenBuffers()
+{
+    writePattern(currentIndexBuffer, currentScreenBuffer);
+    
+    // The other buffers may be read by the consumer. They are updated in endFrame()
+    patternPending = 0x07 & ~(1 << writeSlot);
+}
+
+void
+PixelEngine::writePattern(uint8_t *indices, int *rgba)
 {
     for (unsigned line = 0; line < PAL_RASTERLINES; line++) {
-        for (unsigned i = 0; i < NTSC_PIXELS; i++) {
-            screenBuffer1[line][i] = screenBuffer2[line][i] = (line % 2) ? colors[8] : colors[9];
+        uint8_t index = (line % 2) ? 8 : 9;
+        if (indices)
+            memset(indices + line * NTSC_PIXELS, index, NTSC_PIXELS);
+        if (rgba)
+            for (unsigned i = 0; i < NTSC_PIXELS; i++)
+                rgba[line * NTSC_PIXELS + i] = colors[index];
+    }
+}
+
+void
+PixelEngine::allocateFrames()
+{
+    const size_t pixels = PAL_RASTERLINES * NTSC_PIXELS;
+    
+    delete[] indexFrame;
+    indexFrame = paletteIndexMode ? NULL : new uint8_t[pixels];
+    
+    for (unsigned slot = 0; slot < 3; slot++) {
+        delete[] frames[slot];
+        if (paletteIndexMode) {
+            frames[slot] = new uint8_t[pixels];
+            writePattern(frames[slot], NULL);
+        } else {
+            frames[slot] = new uint8_t[pixels * 4];
+            writePattern(NULL, (int *)frames[slot]);
+        }
+    }
+    
+    patternPending = 0;
+    
+    currentScreenBuffer = paletteIndexMode ? NULL : (int *)frames[writeSlot];
+    currentIndexBuffer = paletteIndexMode ? frames[writeSlot] : indexFrame;
+    pixelBuffer = currentIndexBuffer;
+}
+
+bool
+PixelEngine::acquireFrame()
+{
+    // Check if a new frame has been published
+    if (!(readySlot.load(std::memory_order_relaxed) & 0x04))
+        return false;
+    
+    // Hand over the old buffer and grab the new one
+    readSlot = readySlot.exchange(readSlot, std::memory_order_acq_rel) & 0x03;
+    return true;
+}
+
+void
+PixelEngine::setPaletteIndexMode(bool value)
+{
+    const size_t pixels = PAL_RASTERLINES * NTSC_PIXELS;
+    
+    if (value == paletteIndexMode)
+        return;
+    
+    c64->suspend();
+    
+    // Save the latest complete frame
+    uint8_t *latest = new uint8_t[pixels];
+    memcpy(latest, indexScreenBuffer(), pixels);
+    
+    paletteIndexMode = value;
+    allocateFrames();
+    
+    // Initialize the new buffers. No consumer can hold any of them yet.
+    for (unsigned slot = 0; slot < 3; slot++) {
+        if (paletteIndexMode) {
+            memcpy(frames[slot], latest, pixels);
+        } else {
+            convertToRGBA(latest, (int *)frames[slot], pixels);
         }
     }
+    if (indexFrame)
+        memcpy(indexFrame, latest, pixels);
+    
+    delete[] latest;
+    c64->resume();
+}
+
+void
+PixelEngine::setRenderPolicy(RenderPolicy policy)
+{
+    switch (policy) {
+        case RENDER_ALL_FRAMES:
+        case RENDER_EVERY_NTH:
+        case RENDER_ON_DEMAND:
+        case RENDER_NO_FRAMES:
+            renderPolicy = policy;
+            break;
+        default:
+            warn("Unknown render policy %d\n", policy);
+    }
+}
+
+void
+PixelEngine::screenBufferToRGBA(void *target)
+{
+    convertToRGBA(indexScreenBuffer(), (int *)target, PAL_RASTERLINES * NTSC_PIXELS);
+}
+
+void
+PixelEngine::convertToRGBA(const uint8_t *source, int *target, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        target[i] = colors[source[i] & 0x0F];
+    }
 }
 
 void
 PixelEngine::beginFrame()
 {
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
     visibleColumn = false;
+    
+    // Decide whether this frame is drawn
+    switch (renderPolicy) {
+        case RENDER_ALL_FRAMES:
+            rendering = true;
+            break;
+        case RENDER_EVERY_NTH:
+            rendering = (c64->getFrame() % renderInterval) == 0;
+            break;
+        case RENDER_ON_DEMAND:
+            rendering = renderRequested.exchange(false, std::memory_order_relaxed);
+            break;
+        default:
+            rendering = false;
+    }
 }
 
 void
 PixelEngine::beginRasterline()
 {
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
     // Clear z buffer. The buffer is initialized with the highest positive 8-bit value (meaning the pixel is far away)
     // Not necessary, because canvas pixels are drawn first
     // memset(zBuffer, SCHAR_MAX, sizeof(zBuffer));
@@ -112,18 +259,28 @@ PixelEngine::beginRasterline()
     }
     
     // Clear pixel buffer (has same size as pixelSource and zBuffer)
-    // FOR DEBUGGING ONLY, 0xBB is a randomly chose debug color
-    if (!vic->vblank)
-        memset(pixelBuffer, 0xBB, sizeof(pixelSource));
+    // FOR DEBUGGING ONLY, light grey is a randomly chosen debug color
+    if (!vic->vblank && rendering)
+        memset(pixelBuffer, PixelEngine::GREY2, sizeof(pixelSource));
 }
 
 void
 PixelEngine::endRasterline()
 {
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
     if (!vic->vblank) {
         
         // Make the border look nice
-        expandBorders();
+        if (rendering)
+            expandBorders();
+        
+        // Translate palette indices into RGBA values
+        if (rendering && !paletteIndexMode) {
+            size_t offset = pixelBuffer - currentIndexBuffer;
+            convertToRGBA(pixelBuffer, currentScreenBuffer + offset,
+                          c64->isPAL() ? PAL_PIXELS : NTSC_PIXELS);
+        }
         
         // Advance pixelBuffer
         uint16_t nextline = c64->getRasterline() - PAL_UPPER_VBLANK + 1;
@@ -134,7 +291,7 @@ PixelEngine::endRasterline()
             // pxbuf += NTSC_PIXELS;
             
             // New code (slightly slower, but foolproof. Can't get outside the screen buffer)
-            pixelBuffer = currentScreenBuffer + (nextline * NTSC_PIXELS);
+            pixelBuffer = currentIndexBuffer + (nextline * NTSC_PIXELS);
             // pxbuf = pixelBuffer + bufshift;
             
         }
@@ -144,9 +301,33 @@ PixelEngine::endRasterline()
 void
 PixelEngine::endFrame()
 {
-    // Switch active screen buffer
-    currentScreenBuffer = (currentScreenBuffer == screenBuffer1[0]) ? screenBuffer2[0] : screenBuffer1[0];
-    pixelBuffer = currentScreenBuffer;    
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
+    // Skipped frames are not published
+    if (!rendering) {
+        pixelBuffer = currentIndexBuffer;
+        return;
+    }
+    
+    // Tag the completed frame (C64::frame has already been incremented)
+    frameNr[writeSlot] = c64->getFrame() - 1;
+    stableSlot = writeSlot;
+    
+    // Publish the completed frame and continue with the buffer handed back
+    writeSlot = readySlot.exchange(writeSlot | 0x04, std::memory_order_acq_rel) & 0x03;
+    
+    if (paletteIndexMode) {
+        currentIndexBuffer = frames[writeSlot];
+    } else {
+        currentScreenBuffer = (int *)frames[writeSlot];
+    }
+    pixelBuffer = currentIndexBuffer;
+    
+    // Catch up on a pattern that could not be written in resetScreenBuffers()
+    if (patternPending & (1 << writeSlot)) {
+        writePattern(paletteIndexMode ? currentIndexBuffer : NULL, currentScreenBuffer);
+        patternPending &= ~(1 << writeSlot);
+    }
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -167,6 +348,8 @@ PixelEngine::updateSpriteOnOff()
 void
 PixelEngine::draw()
 {
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
     if (vic->vblank)
         return;
         
@@ -180,6 +363,8 @@ PixelEngine::draw()
 void
 PixelEngine::draw17()
 {
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
     if (vic->vblank)
         return;
     
@@ -193,6 +378,8 @@ PixelEngine::draw17()
 void
 PixelEngine::draw55()
 {
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
     if (vic->vblank)
         return;
     
@@ -206,6 +393,8 @@ PixelEngine::draw55()
 void
 PixelEngine::drawOutsideBorder()
 {
+    PROFILE_SCOPE(c64->profiler, PROF_PIXEL_ENGINE);
+    
     if (vic->vblank)
         return;
     
@@ -217,19 +406,19 @@ PixelEngine::drawBorder()
 {
     if (pipe.mainFrameFF) {
         
-        int rgba = colors[pipe.borderColor];
-        setFramePixel(0, rgba);
+        uint8_t color = pipe.borderColor;
+        setFramePixel(0, color);
         
         // After the first pixel has been drawn, color register changes show up
-        rgba = colors[vic->p.borderColor];
-        
-        setFramePixel(1, rgba);
-        setFramePixel(2, rgba);
-        setFramePixel(3, rgba);
-        setFramePixel(4, rgba);
-        setFramePixel(5, rgba);
-        setFramePixel(6, rgba);
-        setFramePixel(7, rgba);
+        color = vic->p.borderColor;
+        
+        setFramePixel(1, color);
+        setFramePixel(2, color);
+        setFramePixel(3, color);
+        setFramePixel(4, color);
+        setFramePixel(5, color);
+        setFramePixel(6, color);
+        setFramePixel(7, color);
     }
 }
 
@@ -239,18 +428,18 @@ PixelEngine::drawBorder17()
     if (pipe.mainFrameFF && !vic->p.mainFrameFF) {
         
         // 38 column mode
-        int rgba = colors[pipe.borderColor];
-        setFramePixel(0, rgba);
+        uint8_t color = pipe.borderColor;
+        setFramePixel(0, color);
         
         // After the first pixel has been drawn, color register changes show up
-        rgba = colors[vic->p.borderColor];
-        
-        setFramePixel(1, rgba);
-        setFramePixel(2, rgba);
-        setFramePixel(3, rgba);
-        setFramePixel(4, rgba);
-        setFramePixel(5, rgba);
-        setFramePixel(6, rgba);
+        color = vic->p.borderColor;
+        
+        setFramePixel(1, color);
+        setFramePixel(2, color);
+        setFramePixel(3, color);
+        setFramePixel(4, color);
+        setFramePixel(5, color);
+        setFramePixel(6, color);
         // That's all, we only draw 7 pixels here
         
     } else {
@@ -266,7 +455,7 @@ PixelEngine::drawBorder55()
     if (!pipe.mainFrameFF && vic->p.mainFrameFF) {
         
         // 38 column mode
-        setFramePixel(7, colors[pipe.borderColor]);
+        setFramePixel(7, pipe.borderColor);
         
     } else {
         
@@ -325,9 +514,13 @@ PixelEngine::drawCanvas()
     } else {
         
         // "... bei gesetztem Flipflop wird die letzte aktuelle Hintergrundfarbe dargestellt."
-        int col = colors[vic->getBackgroundColor()];
+        if (!rendering) {
+            memset(pixelSource, 0x00, sizeof(pixelSource));
+            return;
+        }
+        uint8_t col = vic->getBackgroundColor();
         // The following fix (which was done for border-bm-idle is wrong)
-        // int col = col_rgba[0];
+        // uint8_t col = col_index[0];
         setEightBackgroundPixels(col);
     }
 }
@@ -359,7 +552,8 @@ PixelEngine::drawCanvasPixel(uint8_t pixelnr)
     }
     
     // Load colors
-    loadColors((DisplayMode)displayMode, sr.latchedCharacter, sr.latchedColor);
+    if (rendering)
+        loadColors((DisplayMode)displayMode, sr.latchedCharacter, sr.latchedColor);
     
     // Render pixel
     bool multicolorDisplayMode = (displayMode & 0x10) && ((displayMode & 0x20) || (sr.latchedColor & 0x8));
@@ -379,7 +573,11 @@ PixelEngine::drawCanvasPixel(uint8_t pixelnr)
             sr.colorbits <<= 1;
         }
     }
-    if (multicolorDisplayMode) {
+    if (!rendering) {
+        // Collision-only fast path: Only record whether a foreground pixel is drawn
+        bool foreground = multicolorDisplayMode ? (sr.colorbits & 0x02) : sr.colorbits;
+        pixelSource[pixelnr] = foreground ? 0x80 : 0x00;
+    } else if (multicolorDisplayMode) {
         setMultiColorPixel(pixelnr, sr.colorbits);
     } else {
         setSingleColorPixel(pixelnr, sr.colorbits);
@@ -491,7 +689,11 @@ PixelEngine::drawSpritePixel(unsigned spritenr, unsigned pixelnr, bool freeze, b
     
     // Draw pixel
     if (visibleColumn && vic->drawSprites) {
-        if (multicol)
+        if (!rendering) {
+            // Collision-only fast path: Skip color lookup and depth buffering
+            if (sprite_sr[spritenr].col_bits & (multicol ? 0x03 : 0x01))
+                pixelSource[pixelnr] |= checkCollisions(pixelnr, spritenr);
+        } else if (multicol)
             setMultiColorSpritePixel(spritenr, pixelnr, sprite_sr[spritenr].col_bits & 0x03);
         else
             setSingleColorSpritePixel(spritenr, pixelnr, sprite_sr[spritenr].col_bits & 0x01);
@@ -509,56 +711,56 @@ PixelEngine::loadColors(DisplayMode mode, uint8_t characterSpace, uint8_t colorS
             
         case STANDARD_TEXT:
             
-            col_rgba[0] = colors[cpipe.backgroundColor[0]];
-            col_rgba[1] = colors[colorSpace];
+            col_index[0] = cpipe.backgroundColor[0];
+            col_index[1] = colorSpace;
             break;
             
         case MULTICOLOR_TEXT:
             if (colorSpace & 0x8 /* MC flag */) {
-                col_rgba[0] = colors[cpipe.backgroundColor[0]];
-                col_rgba[1] = colors[cpipe.backgroundColor[1]];
-                col_rgba[2] = colors[cpipe.backgroundColor[2]];
-                col_rgba[3] = colors[colorSpace & 0x07];
+                col_index[0] = cpipe.backgroundColor[0];
+                col_index[1] = cpipe.backgroundColor[1];
+                col_index[2] = cpipe.backgroundColor[2];
+                col_index[3] = colorSpace & 0x07;
             } else {
-                col_rgba[0] = colors[cpipe.backgroundColor[0]];
-                col_rgba[1] = colors[colorSpace];
+                col_index[0] = cpipe.backgroundColor[0];
+                col_index[1] = colorSpace;
             }
             break;
             
         case STANDARD_BITMAP:
-            col_rgba[0] = colors[characterSpace & 0x0F]; // color of '0' pixels
-            col_rgba[1] = colors[characterSpace >> 4]; // color of '1' pixels
+            col_index[0] = characterSpace & 0x0F; // color of '0' pixels
+            col_index[1] = characterSpace >> 4; // color of '1' pixels
             break;
             
         case MULTICOLOR_BITMAP:
-            col_rgba[0] = colors[cpipe.backgroundColor[0]];
-            col_rgba[1] = colors[characterSpace >> 4];
-            col_rgba[2] = colors[characterSpace & 0x0F];
-            col_rgba[3] = colors[colorSpace];
+            col_index[0] = cpipe.backgroundColor[0];
+            col_index[1] = characterSpace >> 4;
+            col_index[2] = characterSpace & 0x0F;
+            col_index[3] = colorSpace;
             break;
             
         case EXTENDED_BACKGROUND_COLOR:
-            col_rgba[0] = colors[cpipe.backgroundColor[characterSpace >> 6]];
-            col_rgba[1] = colors[colorSpace];
+            col_index[0] = cpipe.backgroundColor[characterSpace >> 6];
+            col_index[1] = colorSpace;
             break;
             
         case INVALID_TEXT:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
-            col_rgba[2] = colors[PixelEngine::BLACK];
-            col_rgba[3] = colors[PixelEngine::BLACK];
+            col_index[0] = PixelEngine::BLACK;
+            col_index[1] = PixelEngine::BLACK;
+            col_index[2] = PixelEngine::BLACK;
+            col_index[3] = PixelEngine::BLACK;
             break;
             
         case INVALID_STANDARD_BITMAP:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
+            col_index[0] = PixelEngine::BLACK;
+            col_index[1] = PixelEngine::BLACK;
             break;
             
         case INVALID_MULTICOLOR_BITMAP:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
-            col_rgba[2] = colors[PixelEngine::BLACK];
-            col_rgba[3] = colors[PixelEngine::BLACK];
+            col_index[0] = PixelEngine::BLACK;
+            col_index[1] = PixelEngine::BLACK;
+            col_index[2] = PixelEngine::BLACK;
+            col_index[3] = PixelEngine::BLACK;
             break;
             
         default:
@@ -570,59 +772,60 @@ PixelEngine::loadColors(DisplayMode mode, uint8_t characterSpace, uint8_t colorS
 void
 PixelEngine::setSingleColorPixel(unsigned pixelnr, uint8_t bit /* valid: 0, 1 */)
 {
-    int rgba = col_rgba[bit];
+    uint8_t color = col_index[bit];
     
     if (bit)
-        setForegroundPixel(pixelnr, rgba);
+        setForegroundPixel(pixelnr, color);
     else
-        setBackgroundPixel(pixelnr, rgba);
+        setBackgroundPixel(pixelnr, color);
 }
 
 void
 PixelEngine::setMultiColorPixel(unsigned pixelnr, uint8_t two_bits /* valid: 00, 01, 10, 11 */)
 {
-    int rgba = col_rgba[two_bits];
+    uint8_t color = col_index[two_bits];
     
     if (two_bits & 0x02)
-        setForegroundPixel(pixelnr, rgba);
+        setForegroundPixel(pixelnr, color);
     else
-        setBackgroundPixel(pixelnr, rgba);
+        setBackgroundPixel(pixelnr, color);
 }
 
 void
 PixelEngine::setSingleColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t bit)
 {
     if (bit) {
-        int rgba = colors[vic->spriteColor[spritenr]];
-        setSpritePixel(pixelnr, rgba, spritenr);
+        setSpritePixel(pixelnr, vic->spriteColor[spritenr], spritenr);
     }
 }
 
 void
 PixelEngine::setMultiColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t two_bits)
 {
-    int rgba;
-    
     switch (two_bits) {
         case 0x01:
-            rgba = colors[vic->spriteExtraColor1];
-            setSpritePixel(pixelnr, rgba, spritenr);
+            setSpritePixel(pixelnr, vic->spriteExtraColor1, spritenr);
             break;
             
         case 0x02:
-            rgba = colors[vic->spriteColor[spritenr]];
-            setSpritePixel(pixelnr, rgba, spritenr);
+            setSpritePixel(pixelnr, vic->spriteColor[spritenr], spritenr);
             break;
             
         case 0x03:
-            rgba = colors[vic->spriteExtraColor2];
-            setSpritePixel(pixelnr, rgba, spritenr);
+            setSpritePixel(pixelnr, vic->spriteExtraColor2, spritenr);
             break;
     }
 }
 
 void
-PixelEngine::setSpritePixel(unsigned pixelnr, int color, int nr)
+PixelEngine::setSpritePixel(unsigned pixelnr, uint8_t color, int nr)
+{
+    int source = checkCollisions(pixelnr, nr);
+    setSpritePixel(pixelnr, color, vic->spriteDepth(nr), source);
+}
+
+uint8_t
+PixelEngine::checkCollisions(unsigned pixelnr, int nr)
 {
     uint8_t mask = (1 << nr);
     
@@ -640,8 +843,8 @@ PixelEngine::setSpritePixel(unsigned pixelnr, int color, int nr)
         
     if (nr == 7)
         mask = 0;
-        
-    setSpritePixel(pixelnr, color, vic->spriteDepth(nr), mask);
+    
+    return mask;
 }
 
 
@@ -650,18 +853,19 @@ PixelEngine::setSpritePixel(unsigned pixelnr, int color, int nr)
 // -----------------------------------------------------------------------------------------------
 
 void
-PixelEngine::setFramePixel(unsigned pixelnr, int rgba)
+PixelEngine::setFramePixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
     
-    pixelBuffer[offset] = rgba;
+    if (rendering)
+        pixelBuffer[offset] = color;
     zBuffer[pixelnr] = BORDER_LAYER_DEPTH;
     pixelSource[pixelnr] &= (~0x80); // disable sprite/foreground collision detection in border
 }
 
 void
-PixelEngine::setForegroundPixel(unsigned pixelnr, int rgba)
+PixelEngine::setForegroundPixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
@@ -669,14 +873,15 @@ PixelEngine::setForegroundPixel(unsigned pixelnr, int rgba)
     // The zBuffer check is not necessary as the canvas pixels are the first to draw
     // if (FOREGROUND_LAYER_DEPTH <= zBuffer[offset])
     {
-        pixelBuffer[offset] = rgba;
+        if (rendering)
+            pixelBuffer[offset] = color;
         zBuffer[pixelnr] = FOREGROUND_LAYER_DEPTH;
         pixelSource[pixelnr] = 0x80;
     }
 }
 
 void
-PixelEngine::setBackgroundPixel(unsigned pixelnr, int rgba)
+PixelEngine::setBackgroundPixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
@@ -684,7 +889,8 @@ PixelEngine::setBackgroundPixel(unsigned pixelnr, int rgba)
     // The zBuffer check is not necessary as the canvas pixels are the first to draw
     // if (BACKGROUD_LAYER_DEPTH <= zBuffer[offset])
     {
-        pixelBuffer[offset] = rgba;
+        if (rendering)
+            pixelBuffer[offset] = color;
         zBuffer[pixelnr] = BACKGROUD_LAYER_DEPTH;
         pixelSource[pixelnr] = 0x00;
     }
@@ -692,13 +898,14 @@ PixelEngine::setBackgroundPixel(unsigned pixelnr, int rgba)
 }
 
 void
-PixelEngine::setSpritePixel(unsigned pixelnr, int rgba, int depth, int source)
+PixelEngine::setSpritePixel(unsigned pixelnr, uint8_t color, int depth, int source)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
     
     if (depth <= zBuffer[pixelnr] && !(pixelSource[pixelnr] & 0x7F)) {
-        pixelBuffer[offset] = rgba;
+        if (rendering)
+            pixelBuffer[offset] = color;
         zBuffer[pixelnr] = depth;
     }
     pixelSource[pixelnr] |= source;
@@ -708,7 +915,8 @@ PixelEngine::setSpritePixel(unsigned pixelnr, int rgba, int depth, int source)
 void
 PixelEngine::expandBorders()
 {
-    int color, lastX;
+    uint8_t color;
+    unsigned lastX;
     unsigned leftPixelPos;
     unsigned rightPixelPos;
     
@@ -723,24 +931,24 @@ PixelEngine::expandBorders()
     }
     
     // Make picked pixels visible for debugging
-    // pixelBuffer[leftPixelPos + 1] = colors[5];
-    // pixelBuffer[rightPixelPos - 1] = colors[5];
+    // pixelBuffer[leftPixelPos + 1] = 5;
+    // pixelBuffer[rightPixelPos - 1] = 5;
     
     color = pixelBuffer[leftPixelPos];
     for (unsigned i = 0; i < leftPixelPos; i++) {
         pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
+        // pixelBuffer[i] = 5; // for debugging
     }
     color = pixelBuffer[rightPixelPos];
     for (unsigned i = rightPixelPos+1; i < lastX; i++) {
         pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
+        // pixelBuffer[i] = 5; // for debugging
     }
 
     /*
     // Draw grid lines
     for (unsigned i = 0; i < NTSC_PIXELS; i += 10)
-    pixelBuffer[i] = 0xFFFFFFFF;
+    pixelBuffer[i] = PixelEngine::WHITE;
     */
 }
 
@@ -749,8 +957,7 @@ PixelEngine::markLine(uint8_t color, unsigned start, unsigned end)
 {
     assert (end <= NTSC_PIXELS);
     
-    int rgba = colors[color];
     for (unsigned i = start; i < end; i++) {
-        pixelBuffer[start + i] = rgba;
+        pixelBuffer[start + i] = color;
     }	
 }
@@ -23,6 +23,7 @@
 #include "VirtualComponent.h"
 #include "VIC_globals.h"
 #include "C64_types.h"
+#include <atomic>
 
 // Forward declarations
 class VIC;
@@ -70,9 +71,9 @@ public:
     //! @brief    Restores the initial state
     void reset();
 
-    //! @brief    Initializes both screenBuffers
+    //! @brief    Initializes the screen buffers owned by the emulator thread
     /*! @details  This function is needed for debugging, only. It write some recognizable pattern 
-     *            into both buffers 
+     *            into the buffers 
      */
     void resetScreenBuffers();
 
@@ -132,31 +133,85 @@ private:
         LO_LO_HI_HI(0xc0, 0xc0, 0xc0, 0xFF)
     };
     
-    /*! @brief    First screen buffer
-     *  @details  The VIC chip writes its output into this buffer. The contents of the array is
-     *            later copied into to texture RAM of your graphic card by the drawRect method 
-     *            in the GPU related code. 
+    /*! @brief    Published frames
+     *  @details  The VIC chip uses triple buffering. At any time, one buffer is written by the
+     *            emulator thread, one buffer holds the latest complete frame, and one buffer is
+     *            owned by the consumer. In RGBA mode, each pixel is stored as an RGBA value.
+     *            In palette index mode, each pixel is stored as a VIC color index (0 to 15).
+     *            Only the representation of the active mode is allocated.
      */
-    int screenBuffer1[PAL_RASTERLINES][NTSC_PIXELS];
+    uint8_t *frames[3];
     
-    /*! @brief    Second screen buffer
-     *  @details  The VIC chip uses double buffering. Once a frame is drawn, the VIC chip writes 
-     *            the next frame to the second buffer. 
+    /*! @brief    Palette index frame used in RGBA mode
+     *  @details  All rendering methods store the VIC color index of each pixel. In RGBA mode,
+     *            they draw into this buffer and a rasterline is converted to RGBA format once
+     *            it has been completed. The buffer is owned by the emulator thread and holds
+     *            the latest complete frame until the next frame is drawn. In palette index
+     *            mode, it is not allocated and the pixels are drawn into the published frame.
      */
-    int screenBuffer2[PAL_RASTERLINES][NTSC_PIXELS];
+    uint8_t *indexFrame;
     
-    /*! @brief    Target screen buffer for all rendering methods
-     *  @details  The variable points either to screenBuffer1 or screenBuffer2 
+    //! @brief    Number of the frame stored in each buffer
+    uint64_t frameNr[3];
+    
+    //! @brief    Buffers still waiting for the debug pattern (one bit per slot)
+    uint8_t patternPending;
+    
+    //! @brief    Buffer that is currently drawn into (owned by the emulator thread)
+    unsigned writeSlot;
+    
+    //! @brief    Buffer that has been completed most recently (owned by the emulator thread)
+    unsigned stableSlot;
+    
+    //! @brief    Buffer that has been acquired by the consumer (owned by the consumer thread)
+    unsigned readSlot;
+    
+    /*! @brief    Buffer holding the latest complete frame
+     *  @details  Bits 0 and 1 contain the buffer number. Bit 2 is set if the buffer has
+     *            not yet been acquired by the consumer. The emulator thread and the consumer
+     *            exchange buffers by atomically swapping their own slot with this one. Hence,
+     *            neither thread ever blocks the other.
      */
+    std::atomic<uint8_t> readySlot;
+    
+    //! @brief    Target RGBA frame of the current frame (NULL in palette index mode)
     int *currentScreenBuffer;
     
+    //! @brief    Target palette index frame for all rendering methods
+    uint8_t *currentIndexBuffer;
+    
     /*! @brief    Pointer to the beginning of the current rasterline
      *  @details  This pointer is used by all rendering methods to write pixels. It always points 
-     *            to the beginning of a rasterline, either in screenBuffer1 or screenBuffer2. 
+     *            to the beginning of a rasterline in the current palette index buffer.
      *            It is reset at the beginning of each frame and incremented at the beginning of 
      *            each rasterline. 
      */
-    int *pixelBuffer;
+    uint8_t *pixelBuffer;
+    
+    /*! @brief    Indicates whether RGBA conversion is switched off
+     *  @details  If set to true, only the palette index buffers are written.
+     */
+    bool paletteIndexMode;
+        
+    //! @brief    Determines which frames are drawn
+    RenderPolicy renderPolicy;
+    
+    //! @brief    Distance between two drawn frames in policy RENDER_EVERY_NTH
+    unsigned renderInterval;
+    
+    /*! @brief    Indicates that the next frame should be drawn in policy RENDER_ON_DEMAND
+     *  @details  The flag is set by the consumer and cleared by the emulator thread.
+     */
+    std::atomic<bool> renderRequested;
+    
+    /*! @brief    Indicates whether the current frame is drawn
+     *  @details  The value is determined at the beginning of each frame. If it is false, the
+     *            pixel engine runs its collision-only fast path. The canvas and sprite
+     *            sequencers are executed as usual and the pixel sources are recorded, but no
+     *            colors are looked up, the screen buffers stay untouched, and the frame is not
+     *            published.
+     */
+    bool rendering;
         
     /*! @brief    Z buffer
      *  @details  Virtual VICII uses depth buffering to determine pixel priority. In the various
@@ -181,12 +236,93 @@ private:
 public:
     
     /*! @brief    Get screen buffer that is currently stable
-     *  @details  This method is called by the GPU code at the beginning of each frame. 
+     *  @details  The returned buffer contains the most recently completed frame in RGBA format.
+     *            It is only guaranteed to stay untouched until the emulator thread completes
+     *            the next frame. Consumers running in a different thread should use
+     *            acquireFrame(). In palette index mode, NULL is returned.
      */
-    void *screenBuffer() {
-        return (currentScreenBuffer == screenBuffer1[0]) ? screenBuffer2[0] : screenBuffer1[0];
-    }
+    void *screenBuffer() { return paletteIndexMode ? NULL : frames[stableSlot]; }
 
+    /*! @brief    Get palette index buffer that is currently stable
+     *  @details  Each byte contains the VIC color index of a single pixel. In RGBA mode, the
+     *            buffer is only valid between two frames, i.e., it is meant to be read by the
+     *            emulator thread at the end of a frame.
+     */
+    uint8_t *indexScreenBuffer() { return paletteIndexMode ? frames[stableSlot] : indexFrame; }
+    
+    /*! @brief    Acquires the latest complete frame
+     *  @details  This method is called by the consumer (e.g., the GPU code) at the beginning
+     *            of each frame. The previously acquired buffer is handed back to the emulator
+     *            thread. The acquired buffer stays untouched until this method is called
+     *            again. The method never blocks.
+     *  @return   true, if a frame has been completed since the last call
+     */
+    bool acquireFrame();
+    
+    //! @brief    Returns the RGBA screen buffer acquired by acquireFrame() (NULL in palette index mode)
+    void *acquiredScreenBuffer() { return paletteIndexMode ? NULL : frames[readSlot]; }
+    
+    //! @brief    Returns the palette index buffer acquired by acquireFrame() (NULL in RGBA mode)
+    uint8_t *acquiredIndexBuffer() { return paletteIndexMode ? frames[readSlot] : NULL; }
+    
+    /*! @brief    Returns the number of the frame acquired by acquireFrame()
+     *  @details  The value is taken from C64::frame. A gap between two subsequent values
+     *            indicates that the consumer has dropped frames.
+     */
+    uint64_t acquiredFrame() { return frameNr[readSlot]; }
+    
+    //! @brief    Returns true if RGBA conversion is switched off
+    bool getPaletteIndexMode() { return paletteIndexMode; }
+    
+    /*! @brief    Switches RGBA conversion off or on
+     *  @details  The frame buffers are reallocated in the representation of the new mode and
+     *            initialized with the latest complete frame. All buffer pointers obtained
+     *            before are invalidated. Hence, no consumer must hold a frame while the mode
+     *            is switched.
+     */
+    void setPaletteIndexMode(bool value);
+    
+    //! @brief    Returns the render policy
+    RenderPolicy getRenderPolicy() { return renderPolicy; }
+    
+    /*! @brief    Sets the render policy
+     *  @details  The new policy takes effect at the beginning of the next frame.
+     */
+    void setRenderPolicy(RenderPolicy policy);
+    
+    //! @brief    Returns the distance between two drawn frames in policy RENDER_EVERY_NTH
+    unsigned getRenderInterval() { return renderInterval; }
+    
+    //! @brief    Sets the distance between two drawn frames in policy RENDER_EVERY_NTH
+    void setRenderInterval(unsigned n) { renderInterval = n ? n : 1; }
+    
+    /*! @brief    Requests the next frame to be drawn in policy RENDER_ON_DEMAND
+     *  @details  This method may be called from any thread.
+     */
+    void requestFrame() { renderRequested.store(true, std::memory_order_relaxed); }
+    
+    //! @brief    Returns true if the current frame is drawn
+    bool isRendering() { return rendering; }
+    
+    /*! @brief    Converts the stable palette index buffer to RGBA format
+     *  @param    target  Buffer of size PAL_RASTERLINES * NTSC_PIXELS * 4 bytes
+     *  @details  The conversion uses the current color palette. In palette index mode, this
+     *            is the only way to obtain an RGBA image.
+     */
+    void screenBufferToRGBA(void *target);
+    
+private:
+    
+    //! @brief    Allocates the frame buffers for the current mode
+    void allocateFrames();
+    
+    //! @brief    Writes the debug pattern into a palette index frame and / or an RGBA frame
+    void writePattern(uint8_t *indices, int *rgba);
+    
+    //! @brief    Converts a number of palette indices to RGBA values
+    void convertToRGBA(const uint8_t *source, int *target, size_t count);
+    
+public:
     
     // ------------------------------------------------------------------------------------------
     //                                  Rastercycle information
@@ -477,7 +613,7 @@ private:
      *            [2] : color for '10' pixels in multicolor mode
      *            [3] : color for '11' pixels in multicolor mode 
      */
-    int col_rgba[4];
+    uint8_t col_index[4];
 
 public:
     
@@ -510,30 +646,38 @@ public:
      *  @details  This function is invoked by setSingleColorPixel() and setMultiColorPixel().
      *            It takes care of collison and invokes setSpritePixel(4) to actually render the pixel. 
      */
-    void setSpritePixel(unsigned pixelnr, int color, int nr);
+    void setSpritePixel(unsigned pixelnr, uint8_t color, int nr);
+
+    /*! @brief    Performs collision detection for a single sprite pixel
+     *  @details  Sets the collision registers and triggers interrupts if applicable.
+     *  @return   Pixel source bit of the sprite
+     */
+    uint8_t checkCollisions(unsigned pixelnr, int nr);
 
     
     // -----------------------------------------------------------------------------------------------
     //                        Low level drawing (pixel buffer access)
     // -----------------------------------------------------------------------------------------------
+    //
+    // In skipped frames, these methods only update the z buffer and the pixel sources.
     
 public:
 
     //! @brief    Draw a single frame pixel
-    void setFramePixel(unsigned pixelnr, int rgba);
+    void setFramePixel(unsigned pixelnr, uint8_t color);
     
     //! @brief    Draw a single foreground pixel
-    void setForegroundPixel(unsigned pixelnr, int rgba);
+    void setForegroundPixel(unsigned pixelnr, uint8_t color);
     
     //! @brief    Draw a single background pixel
-    void setBackgroundPixel(unsigned pixelnr, int rgba);
+    void setBackgroundPixel(unsigned pixelnr, uint8_t color);
 
     //! @brief    Draw eight background pixels in a row
-    void setEightBackgroundPixels(int rgba) {
-        for (unsigned i = 0; i < 8; i++) setBackgroundPixel(i, rgba); }
+    void setEightBackgroundPixels(uint8_t color) {
+        for (unsigned i = 0; i < 8; i++) setBackgroundPixel(i, color); }
 
     //! @brief    Draw a single sprite pixel
-    void setSpritePixel(unsigned pixelnr, int rgba, int depth, int source);
+    void setSpritePixel(unsigned pixelnr, uint8_t color, int depth, int source);
 
     /*! @brief    Extend border to the left and right to look nice.
      *  @details  This functions replicates the color of the leftmost and rightmost pixel 
@@ -0,0 +1,478 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "C64.h"
+
+RewindBuffer::RewindBuffer(C64 *c64)
+{
+    setDescription("RewindBuffer");
+    debug(3, "  Creating rewind buffer at address %p...\n", this);
+
+    this->c64 = c64;
+    arena = NULL;
+    capacity = 0;
+    first = 0;
+    count = 0;
+    nextId = 1;
+    keyframeInterval = defaultKeyframeInterval;
+    deltas = 0;
+    forceKeyframe = true;
+    previous = current = scratch = NULL;
+    workspaceSize = 0;
+    previousSize = 0;
+    cache = NULL;
+    cacheId = 0;
+    pthread_mutex_init(&lock, NULL);
+
+    setCapacity(defaultCapacity);
+}
+
+RewindBuffer::~RewindBuffer()
+{
+    free(arena);
+    free(previous);
+    free(current);
+    free(scratch);
+    delete cache;
+    pthread_mutex_destroy(&lock);
+}
+
+void
+RewindBuffer::clear()
+{
+    pthread_mutex_lock(&lock);
+
+    first = 0;
+    count = 0;
+    deltas = 0;
+    forceKeyframe = true;
+    cacheId = 0;
+
+    pthread_mutex_unlock(&lock);
+}
+
+void
+RewindBuffer::setCapacity(size_t bytes)
+{
+    pthread_mutex_lock(&lock);
+
+    free(arena);
+    if ((arena = (uint8_t *)malloc(bytes)) == NULL) {
+        warn("Cannot allocate %ld bytes for the rewind buffer\n", bytes);
+        bytes = 0;
+    }
+    capacity = bytes;
+    first = 0;
+    count = 0;
+    deltas = 0;
+    forceKeyframe = true;
+    cacheId = 0;
+
+    pthread_mutex_unlock(&lock);
+}
+
+size_t
+RewindBuffer::usedBytes()
+{
+    size_t result = 0;
+
+    pthread_mutex_lock(&lock);
+    for (unsigned i = 0; i < count; i++) {
+        result += entry(i).size;
+    }
+    pthread_mutex_unlock(&lock);
+
+    return result;
+}
+
+uint64_t
+RewindBuffer::getFrame(unsigned nr)
+{
+    pthread_mutex_lock(&lock);
+
+    assert(nr < count);
+    uint64_t result = entry(count - 1 - nr).frame;
+
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+int
+RewindBuffer::lookup(uint64_t frame)
+{
+    int result = -1;
+
+    pthread_mutex_lock(&lock);
+    for (unsigned nr = 0; nr < count; nr++) {
+        if (entry(count - 1 - nr).frame <= frame) {
+            result = nr;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+
+    return result;
+}
+
+void
+RewindBuffer::record()
+{
+    pthread_mutex_lock(&lock);
+
+    size_t size = screenSize + c64->stateSize();
+    if (!allocateWorkspace(size)) {
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+
+    // Gather screenshot and internal state
+    memcpy(current, c64->vic.indexScreenBuffer(), screenSize);
+    uint8_t *ptr = current + screenSize;
+    c64->saveToBuffer(&ptr, NATIVE_SNAPSHOT);
+    assert(ptr == current + size);
+
+    // Encode the state
+    bool keyframe =
+    forceKeyframe || count == 0 || previousSize != size || deltas + 1 >= keyframeInterval;
+    size_t encoded = encode(current, keyframe ? NULL : previous, size, scratch);
+    long offset = reserve(encoded, !keyframe);
+
+    if (offset < 0 && !keyframe) {
+
+        // There is no room for the current group. Start over with a keyframe
+        keyframe = true;
+        encoded = encode(current, NULL, size, scratch);
+        offset = reserve(encoded, false);
+    }
+    if (offset < 0) {
+        warn("Rewind buffer is too small to hold a keyframe (%ld bytes)\n", encoded);
+        forceKeyframe = true;
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+
+    // Store the encoded state
+    memcpy(arena + offset, scratch, encoded);
+    RewindEntry &e = entries[(first + count) % maxEntries];
+    e.offset = (size_t)offset;
+    e.size = encoded;
+    e.dataSize = size;
+    e.keyframe = keyframe;
+    e.pal = c64->isPAL();
+    e.frame = c64->getFrame();
+    e.timestamp = time(NULL);
+    e.id = nextId++;
+    count++;
+
+    debug(3, "Recorded %s (%ld bytes, %d states)\n",
+          keyframe ? "keyframe" : "delta", encoded, count);
+
+    deltas = keyframe ? 0 : deltas + 1;
+    forceKeyframe = false;
+
+    // Remember the state as reference for the next delta
+    uint8_t *tmp = previous; previous = current; current = tmp;
+    previousSize = size;
+
+    pthread_mutex_unlock(&lock);
+}
+
+Snapshot *
+RewindBuffer::snapshot(unsigned nr)
+{
+    pthread_mutex_lock(&lock);
+
+    if (nr >= count) {
+        pthread_mutex_unlock(&lock);
+        return NULL;
+    }
+
+    unsigned i = count - 1 - nr;
+    RewindEntry &e = entry(i);
+
+    if (cache && cacheId == e.id) {
+        pthread_mutex_unlock(&lock);
+        return cache;
+    }
+
+    if (!allocateWorkspace(e.dataSize) || !reconstruct(i, current)) {
+        warn("Failed to reconstruct rewind state %d\n", nr);
+        pthread_mutex_unlock(&lock);
+        return NULL;
+    }
+
+    if (cache == NULL) {
+        cache = new Snapshot();
+    }
+    cache->setCapacity(e.dataSize - screenSize);
+    cache->setFormat(NATIVE_SNAPSHOT);
+    cache->setTimestamp(e.timestamp);
+    memcpy(cache->getData(), current + screenSize, e.dataSize - screenSize);
+
+    // Translate the palette indices of the screenshot into RGBA values
+    uint32_t *rgba = new uint32_t[screenSize];
+    uint32_t colors[16];
+    for (unsigned j = 0; j < 16; j++) {
+        colors[j] = c64->vic.getColor(j);
+    }
+    for (size_t j = 0; j < screenSize; j++) {
+        rgba[j] = colors[current[j] & 0x0F];
+    }
+    cache->takeScreenshot(rgba, e.pal);
+    delete[] rgba;
+
+    cacheId = e.id;
+
+    pthread_mutex_unlock(&lock);
+    return cache;
+}
+
+void
+RewindBuffer::discardLatest(unsigned n)
+{
+    pthread_mutex_lock(&lock);
+
+    count -= MIN(n, count);
+
+    // The previous state no longer matches the most recent entry
+    forceKeyframe = true;
+
+    pthread_mutex_unlock(&lock);
+}
+
+bool
+RewindBuffer::allocateWorkspace(size_t size)
+{
+    if (size <= workspaceSize)
+        return true;
+
+    uint8_t *p = (uint8_t *)realloc(previous, size);
+    uint8_t *c = (uint8_t *)realloc(current, size);
+    uint8_t *s = (uint8_t *)realloc(scratch, 2 * size + 16);
+    if (p) previous = p;
+    if (c) current = c;
+    if (s) scratch = s;
+
+    if (!p || !c || !s) {
+        warn("Cannot allocate rewind buffer workspace (%ld bytes)\n", size);
+        return false;
+    }
+
+    workspaceSize = size;
+    return true;
+}
+
+long
+RewindBuffer::reserve(size_t size, bool keepLatest)
+{
+    if (size > capacity)
+        return -1;
+
+    while (1) {
+
+        if (count == 0)
+            return 0;
+
+        if (count < maxEntries) {
+
+            size_t start = entry(0).offset;
+            size_t end = entry(count - 1).offset + entry(count - 1).size;
+
+            if (end > start) {
+
+                // Used area is [start; end)
+                if (capacity - end >= size) return end;
+                if (start >= size) return 0;
+
+            } else {
+
+                // Used area is [start; capacity) and [0; end)
+                if (start - end >= size) return end;
+            }
+        }
+
+        if (!discardOldest(keepLatest))
+            return -1;
+    }
+}
+
+bool
+RewindBuffer::discardOldest(bool keepLatest)
+{
+    assert(count == 0 || entry(0).keyframe);
+
+    if (count == 0)
+        return false;
+
+    // Find the next keyframe
+    unsigned n = 1;
+    while (n < count && !entry(n).keyframe) n++;
+
+    if (n == count && keepLatest)
+        return false;
+
+    first = (first + n) % maxEntries;
+    count -= n;
+    return true;
+}
+
+static size_t
+putVarint(uint8_t *out, size_t value)
+{
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+static bool
+getVarint(const uint8_t *in, size_t inSize, size_t *pos, size_t *value)
+{
+    *value = 0;
+    for (unsigned shift = 0; *pos < inSize && shift < 64; shift += 7) {
+        uint8_t byte = in[(*pos)++];
+        *value |= (size_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+size_t
+RewindBuffer::encode(const uint8_t *cur, const uint8_t *prev, size_t size, uint8_t *out)
+{
+    size_t o = 0, i = 0;
+
+    #define DIFF(k) (prev ? (uint8_t)(cur[k] ^ prev[k]) : cur[k])
+
+    while (i < size) {
+
+        // Determine the number of unchanged bytes
+        size_t skip = 0;
+        while (i < size && DIFF(i) == 0) { i++; skip++; }
+
+        // Check for a run of identical bytes
+        size_t run = 0;
+        while (i + run < size && DIFF(i + run) == DIFF(i)) run++;
+
+        if (run >= 8) {
+
+            // Write fill token
+            o += putVarint(out + o, skip);
+            o += putVarint(out + o, (run << 1) | 1);
+            out[o++] = DIFF(i);
+            i += run;
+            continue;
+        }
+
+        // Collect changed bytes until a zero run or a fill run starts
+        size_t start = i, j = i, end, zeros = 0, same = 0;
+        int last = -1;
+        while (1) {
+            if (j == size) { end = size - zeros; break; }
+            uint8_t value = DIFF(j);
+            zeros = value ? 0 : zeros + 1;
+            same = (value == last) ? same + 1 : 1;
+            last = value;
+            if (zeros == 4) { end = j + 1 - zeros; break; }
+            if (same == 8) { end = j + 1 - same; break; }
+            j++;
+        }
+
+        // Write literal token
+        o += putVarint(out + o, skip);
+        o += putVarint(out + o, (end - start) << 1);
+        for (size_t k = start; k < end; k++) {
+            out[o++] = DIFF(k);
+        }
+        i = end;
+    }
+
+    #undef DIFF
+
+    return o;
+}
+
+bool
+RewindBuffer::decode(const uint8_t *in, size_t inSize, uint8_t *buf, size_t size)
+{
+    size_t i = 0, pos = 0, skip, token;
+
+    while (i < inSize) {
+
+        if (!getVarint(in, inSize, &i, &skip) || !getVarint(in, inSize, &i, &token))
+            return false;
+        if (skip > size - pos)
+            return false;
+        pos += skip;
+
+        size_t len = token >> 1;
+        if (len > size - pos)
+            return false;
+
+        if (token & 1) {
+
+            // Fill token
+            if (i >= inSize)
+                return false;
+            uint8_t value = in[i++];
+            for (size_t k = 0; k < len; k++) {
+                buf[pos + k] ^= value;
+            }
+
+        } else {
+
+            // Literal token
+            if (len > inSize - i)
+                return false;
+            for (size_t k = 0; k < len; k++) {
+                buf[pos + k] ^= in[i + k];
+            }
+            i += len;
+        }
+        pos += len;
+    }
+    return true;
+}
+
+bool
+RewindBuffer::reconstruct(unsigned i, uint8_t *buf)
+{
+    assert(i < count);
+
+    RewindEntry &e = entry(i);
+
+    // Find the keyframe this entry depends on
+    unsigned k = i;
+    while (!entry(k).keyframe) {
+        assert(k > 0);
+        k--;
+    }
+
+    // Apply the keyframe and all deltas
+    memset(buf, 0, e.dataSize);
+    for (unsigned j = k; j <= i; j++) {
+        RewindEntry &d = entry(j);
+        if (d.dataSize != e.dataSize || !decode(arena + d.offset, d.size, buf, d.dataSize))
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,239 @@
+/*!
+ * @header      RewindBuffer.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _REWINDBUFFER_INC
+#define _REWINDBUFFER_INC
+
+#include "VC64Object.h"
+#include "VIC_globals.h"
+
+// Forward declarations
+class C64;
+class Snapshot;
+
+/*! @class    RewindBuffer
+ *  @brief    Storage for the auto-saved snapshots
+ *  @details  Instead of keeping a complete Snapshot object for each recorded state, the
+ *            rewind buffer stores a keyframe once in a while and XOR deltas against the
+ *            previously recorded state in between. Both are run length encoded, which
+ *            is very effective because most bytes do not change from one state to the
+ *            next. All data is kept in a single arena of fixed size. If the arena runs
+ *            full, the oldest keyframe is discarded together with all deltas depending
+ *            on it.
+ *
+ *            Each recorded state consists of the palette index screen buffer of the
+ *            most recent frame, followed by the internal state as written by
+ *            C64::saveToBuffer() in native format.
+ */
+class RewindBuffer : public VC64Object {
+
+public:
+
+    //! @brief    Default size of the arena in bytes
+    static const size_t defaultCapacity = 16 * 1024 * 1024;
+
+    //! @brief    Maximum number of recorded states
+    static const unsigned maxEntries = 1024;
+
+    //! @brief    Default number of recorded states between two keyframes
+    static const unsigned defaultKeyframeInterval = 30;
+
+    //! @brief    Size of the screenshot part of each recorded state
+    static const size_t screenSize = PAL_RASTERLINES * NTSC_PIXELS;
+
+private:
+
+    //! @brief    Meta information about a single recorded state
+    typedef struct {
+
+        //! @brief    Start of the encoded data in the arena
+        size_t offset;
+
+        //! @brief    Size of the encoded data in the arena
+        size_t size;
+
+        //! @brief    Size of the decoded data (screenshot and internal state)
+        size_t dataSize;
+
+        //! @brief    Indicates if the entry can be decoded on its own
+        bool keyframe;
+
+        //! @brief    Indicates if the screenshot shows a PAL frame
+        bool pal;
+
+        //! @brief    Frame number at the time of recording (C64::frame)
+        uint64_t frame;
+
+        //! @brief    Date and time of recording
+        time_t timestamp;
+
+        //! @brief    Unique identifier
+        uint64_t id;
+
+    } RewindEntry;
+
+    //! @brief    Reference to the virtual C64
+    C64 *c64;
+
+    //! @brief    Storage for the encoded states
+    uint8_t *arena;
+
+    //! @brief    Size of the arena in bytes
+    size_t capacity;
+
+    //! @brief    Meta information for all recorded states (ringbuffer)
+    RewindEntry entries[maxEntries];
+
+    //! @brief    Position of the oldest entry in the entries ringbuffer
+    unsigned first;
+
+    //! @brief    Number of recorded states
+    unsigned count;
+
+    //! @brief    Identifier of the next recorded state
+    uint64_t nextId;
+
+    //! @brief    Number of recorded states between two keyframes
+    unsigned keyframeInterval;
+
+    //! @brief    Number of deltas recorded since the last keyframe
+    unsigned deltas;
+
+    //! @brief    If set, the next state is recorded as a keyframe
+    bool forceKeyframe;
+
+    //! @brief    Decoded version of the most recently recorded state
+    uint8_t *previous;
+
+    //! @brief    Workspace for the state to record
+    uint8_t *current;
+
+    //! @brief    Size of the previous and current workspaces
+    size_t workspaceSize;
+
+    //! @brief    Size of the data stored in previous
+    size_t previousSize;
+
+    //! @brief    Workspace for the encoder (worst case size)
+    uint8_t *scratch;
+
+    //! @brief    Most recently reconstructed snapshot
+    Snapshot *cache;
+
+    //! @brief    Identifier of the entry stored in cache
+    uint64_t cacheId;
+
+    //! @brief    Mutex for streamlining accesses from the emulator and the GUI thread
+    pthread_mutex_t lock;
+
+public:
+
+    //! @brief    Constructor
+    RewindBuffer(C64 *c64);
+
+    //! @brief    Destructor
+    ~RewindBuffer();
+
+    //! @brief    Deletes all recorded states
+    void clear();
+
+    //! @brief    Returns the size of the arena in bytes
+    size_t getCapacity() { return capacity; }
+
+    /*! @brief    Changes the size of the arena
+     *  @note     All recorded states are deleted.
+     */
+    void setCapacity(size_t bytes);
+
+    //! @brief    Returns the number of bytes occupied by recorded states
+    size_t usedBytes();
+
+    //! @brief    Returns the number of recorded states between two keyframes
+    unsigned getKeyframeInterval() { return keyframeInterval; }
+
+    //! @brief    Sets the number of recorded states between two keyframes
+    void setKeyframeInterval(unsigned value) { keyframeInterval = value ? value : 1; }
+
+    //! @brief    Returns the number of recorded states
+    unsigned numEntries() { return count; }
+
+    //! @brief    Returns the frame number of a recorded state (0 = most recent)
+    uint64_t getFrame(unsigned nr);
+
+    /*! @brief    Returns the most recent state recorded at or before the specified frame
+     *  @return   -1, if no such state exists
+     */
+    int lookup(uint64_t frame);
+
+    /*! @brief    Records the current state of the virtual C64
+     *  @note     Must be called inside the execution thread, only.
+     */
+    void record();
+
+    /*! @brief    Reconstructs a recorded state (0 = most recent)
+     *  @details  The returned object is owned by the rewind buffer. It stays valid until
+     *            this method is called again. The internal state is stored in native
+     *            format. Use C64::convertSnapshot() before exporting it.
+     *  @return   NULL, if nr is out of range
+     */
+    Snapshot *snapshot(unsigned nr);
+
+    /*! @brief    Deletes the n most recent states
+     *  @details  Because each delta depends on its predecessor, the history can only be
+     *            shortened from the end.
+     */
+    void discardLatest(unsigned n);
+
+private:
+
+    //! @brief    Returns the meta information of a recorded state (0 = oldest)
+    RewindEntry &entry(unsigned i) { return entries[(first + i) % maxEntries]; }
+
+    //! @brief    Makes sure that the workspaces can hold a state of the specified size
+    bool allocateWorkspace(size_t size);
+
+    /*! @brief    Reserves space for a new entry in the arena
+     *  @param    keepLatest  If set, the keyframe of the most recent entry is never discarded
+     *  @return   Offset into the arena or -1, if no space could be reserved
+     */
+    long reserve(size_t size, bool keepLatest);
+
+    /*! @brief    Deletes the oldest keyframe and all deltas depending on it
+     *  @return   false, if keepLatest is set and the most recent group would be deleted
+     */
+    bool discardOldest(bool keepLatest);
+
+    /*! @brief    Encodes (cur XOR prev) as a sequence of tokens
+     *  @details  Each token starts with the number of unchanged bytes to skip. It is
+     *            followed by either a literal run or a run of identical bytes.
+     *  @param    prev  Reference state or NULL for keyframes
+     *  @return   Number of bytes written to out
+     */
+    static size_t encode(const uint8_t *cur, const uint8_t *prev, size_t size, uint8_t *out);
+
+    /*! @brief    Applies an encoded delta to buf by XORing the decoded runs
+     *  @return   false, if the encoded data is malformed
+     */
+    static bool decode(const uint8_t *in, size_t inSize, uint8_t *buf, size_t size);
+
+    //! @brief    Decodes a recorded state into a buffer (0 = oldest)
+    bool reconstruct(unsigned i, uint8_t *buf);
+};
+
+#endif
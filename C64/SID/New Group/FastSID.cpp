@@ -30,6 +30,20 @@
 
 #include "C64.h"
 
+// Four 32 bit lanes holding the counters of voice 1, 2, and 3 (lane 4 is unused).
+// The GCC vector extension maps these to SSE2 on x86 and to NEON on ARM.
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+typedef int32_t  i32x4 __attribute__((vector_size(16)));
+typedef uint64_t u64x2 __attribute__((vector_size(16)));
+
+// Checks if a comparison result is true for at least one lane
+static inline bool
+anyLane(i32x4 mask)
+{
+    u64x2 m = (u64x2)mask;
+    return (m[0] | m[1]) != 0;
+}
+
 FastSID::FastSID()
 {
 	setDescription("SID");
@@ -58,7 +72,7 @@ FastSID::FastSID()
     Voice::initWaveTables();
     
     // Initialize voices
-    voice[0].init(this, 0, &voice[3]);
+    voice[0].init(this, 0, &voice[2]);
     voice[1].init(this, 1, &voice[0]);
     voice[2].init(this, 2, &voice[1]);
     
@@ -88,9 +102,9 @@ FastSID::reset()
 }
 
 void
-FastSID::loadFromBuffer(uint8_t **buffer)
+FastSID::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
-    VirtualComponent::loadFromBuffer(buffer);
+    VirtualComponent::loadFromBuffer(buffer, format);
 }
 
 void
@@ -299,9 +313,7 @@ FastSID::execute(uint64_t cycles)
     }
     
     // Compute missing samples
-    for (unsigned i = 0; i < numSamples; i++) {
-        buf[i] = calculateSingleSample();
-    }
+    calculateSamples(buf, (unsigned)numSamples);
     
     // Write samples into ringbuffer
     bridge->writeData(buf, numSamples);
@@ -502,3 +514,111 @@ FastSID::calculateSingleSample()
     
     return (int16_t)(((int32_t)((osc0 + osc1 + osc2) >> 20) - 0x600) * sidVolume());
 }
+
+void
+FastSID::calculateSamples(int16_t *buf, unsigned n)
+{
+    // Collect everything that only changes on register writes
+    const uint16_t *table[3];
+    uint32_t tableOffset[3];
+    bool noise[3], ringmod[3], filtered[3];
+    for (unsigned k = 0; k < 3; k++) {
+        Voice *v = &voice[k];
+        noise[k] = v->waveform() == FASTSID_NOISE;
+        table[k] = v->wavetable;
+        tableOffset[k] = v->waveTableOffset;
+        ringmod[k] = v->ringmod;
+        filtered[k] = emulateFilter && filterOn(k);
+    }
+    bool mute2 = voiceThreeDisconnected();
+    int32_t volume = sidVolume();
+    
+    // Load the wavetable and ADSR counters into vector registers
+    u32x4 counter = { voice[0].waveTableCounter, voice[1].waveTableCounter, voice[2].waveTableCounter, 0 };
+    u32x4 step = { voice[0].step, voice[1].step, voice[2].step, 0 };
+    i32x4 adsr = { (int32_t)voice[0].adsr, (int32_t)voice[1].adsr, (int32_t)voice[2].adsr, 0 };
+    i32x4 adsrInc = { voice[0].adsrInc, voice[1].adsrInc, voice[2].adsrInc, 0 };
+    i32x4 adsrCmp = { (int32_t)voice[0].adsrCmp, (int32_t)voice[1].adsrCmp, (int32_t)voice[2].adsrCmp, 0 };
+    
+    for (unsigned i = 0; i < n; i++) {
+        
+        // Advance wavetable counters
+        counter += step;
+        
+        // Check for counter overflows (waveform loops)
+        i32x4 overflow = (i32x4)(counter < step);
+        if (anyLane(overflow)) {
+            
+            bool sync[3] = { false, false, false };
+            for (unsigned k = 0; k < 3; k++) {
+                if (overflow[k]) {
+                    voice[k].lsfr = NSHIFT(voice[k].lsfr, 16);
+                    sync[(k + 1) % 3] = voice[(k + 1) % 3].syncBit();
+                }
+            }
+            
+            // Perform hard sync
+            for (unsigned k = 0; k < 3; k++) {
+                if (sync[k]) {
+                    voice[k].lsfr = NSHIFT(voice[k].lsfr, counter[k] >> 28);
+                    counter[k] = 0;
+                }
+            }
+        }
+        
+        // Advance ADSR counters and check if we need to perform state changes.
+        // The signed comparison equals the biased unsigned comparison in trigger_adsr().
+        adsr += adsrInc;
+        i32x4 trigger = adsr < adsrCmp;
+        if (anyLane(trigger)) {
+            
+            for (unsigned k = 0; k < 3; k++) {
+                if (trigger[k]) {
+                    voice[k].adsr = (uint32_t)adsr[k];
+                    voice[k].trigger_adsr();
+                    adsr[k] = (int32_t)voice[k].adsr;
+                    adsrInc[k] = voice[k].adsrInc;
+                    adsrCmp[k] = (int32_t)voice[k].adsrCmp;
+                }
+            }
+        }
+        
+        // Oscillators
+        uint32_t osc[3];
+        for (unsigned k = 0; k < 3; k++) {
+            
+            uint32_t wave = 0;
+            if (noise[k]) {
+                wave = Voice::noiseValue(NSHIFT(voice[k].lsfr, counter[k] >> 28)) << 7;
+            } else if (table[k]) {
+                wave = table[k][(counter[k] + tableOffset[k]) >> 20];
+                if (ringmod[k] && (counter[(k + 2) % 3] >> 31)) {
+                    wave ^= 0x7FFF;
+                }
+            }
+            osc[k] = ((uint32_t)adsr[k] >> 16) * wave;
+        }
+        
+        // Silence voice 3 if it is disconnected from the output
+        if (mute2) {
+            osc[2] = 0;
+        }
+        
+        // Apply filter
+        if (emulateFilter) {
+            for (unsigned k = 0; k < 3; k++) {
+                voice[k].filterIO = ampMod1x8[(osc[k] >> 22)];
+                if (filtered[k]) voice[k].applyFilter();
+                osc[k] = ((uint32_t)(voice[k].filterIO) + 0x80) << (7 + 15);
+            }
+        }
+        
+        buf[i] = (int16_t)(((int32_t)((osc[0] + osc[1] + osc[2]) >> 20) - 0x600) * volume);
+    }
+    
+    // Write back the counters
+    for (unsigned k = 0; k < 3; k++) {
+        voice[k].waveTableCounter = counter[k];
+        voice[k].adsr = (uint32_t)adsr[k];
+    }
+}
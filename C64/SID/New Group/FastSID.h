@@ -119,7 +119,7 @@ public:
     void reset();
 
     //! Load state
-    void loadFromBuffer(uint8_t **buffer);
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
     
     //! Dump internal state to console
     void dumpState();
@@ -142,6 +142,15 @@ public:
     //! @brief   Computes a single sound sample
     int16_t calculateSingleSample();
     
+    /*! @brief   Computes a block of sound samples
+     *  @details Produces the same samples as calling calculateSingleSample() n times.
+     *           The wavetable and ADSR counters of all three voices are advanced in a
+     *           single vector register. Everything that only changes on register writes
+     *           is looked up once per block. Hence, the block must not span a register
+     *           write, which is guaranteed by executing SID before each write.
+     */
+    void calculateSamples(int16_t *buf, unsigned n);
+    
     
     //
     //! @functiongroup Configuring the device
@@ -90,9 +90,9 @@ Voice::reset()
 }
 
 void
-Voice::loadFromBuffer(uint8_t **buffer)
+Voice::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
-    VirtualComponent::loadFromBuffer(buffer);
+    VirtualComponent::loadFromBuffer(buffer, format);
     updateWaveTablePtr();
 }
 
@@ -389,59 +389,3 @@ Voice::doosc()
     
     return 0;
 }
-
-void
-Voice::applyFilter()
-{
-    float sample, sample2;
-    
-    if (filterType == 0) {
-        filterIO = 0;
-        return;
-    }
-    
-    if (filterType == FASTSID_BAND_PASS) {
-        filterLow += filterRef * filterDy;
-        filterRef += (filterIO - filterLow - (filterRef * filterResDy)) * filterDy;
-        filterIO = (signed char)(filterRef - filterLow / 4);
-        return;
-    }
-    
-    if (filterType == FASTSID_HIGH_PASS) {
-        filterLow += filterRef * filterDy * 0.1;
-        filterRef += (filterIO - filterLow - (filterRef * filterResDy)) * filterDy;
-        sample = filterRef - (filterIO / 8);
-        sample = MAX(sample, -128);
-        sample = MIN(sample, 127);
-        filterIO = (signed char)sample;
-        return;
-    }
-    
-    filterLow += filterRef * filterDy;
-    sample = filterIO;
-    sample2 = sample - filterLow;
-    int tmp = (int)sample2;
-    sample2 -= filterRef * filterResDy;
-    filterRef += sample2 * filterDy;
-    
-    switch (filterType) {
-            
-        case FASTSID_LOW_PASS:
-        case FASTSID_BAND_PASS | FASTSID_LOW_PASS:
-            filterIO = (signed char)filterLow;
-            break;
-            
-        case FASTSID_HIGH_PASS | FASTSID_LOW_PASS:
-        case FASTSID_HIGH_PASS | FASTSID_BAND_PASS | FASTSID_LOW_PASS:
-            filterIO = (signed char)((int)(sample) - (tmp >> 1));
-            break;
-            
-        case FASTSID_HIGH_PASS | FASTSID_BAND_PASS:
-            filterIO = (signed char)tmp;
-            break;
-            
-        default:
-            assert(false); 
-            filterIO = 0;
-    }
-}
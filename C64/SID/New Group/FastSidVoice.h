@@ -173,7 +173,7 @@ public:
     void reset();
 
     //! @brief    Loads the current state from a buffer
-    void loadFromBuffer(uint8_t **buffer);
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
     
     //! @brief    Initializes the wave tables
     /*! @details  Needs to be called once prior to using this class
@@ -203,8 +203,11 @@ public:
     // 15-bit oscillator value
     uint32_t doosc();
     
+    //! @brief Returns the noise waveform output for a shift register value
+    static uint32_t noiseValue(uint32_t v) { return NVALUE(v); }
+    
     //! @brief Apply filter effect
-    void applyFilter();
+    inline void applyFilter();
     
     //
     // Querying configuration items
@@ -293,4 +296,61 @@ public:
     uint8_t releaseRate() { return sidreg[0x06] & 0x0F; }
 };
 
+// Defined inline, because it is called for every sound sample
+inline void
+Voice::applyFilter()
+{
+    float sample, sample2;
+    
+    if (filterType == 0) {
+        filterIO = 0;
+        return;
+    }
+    
+    if (filterType == FASTSID_BAND_PASS) {
+        filterLow += filterRef * filterDy;
+        filterRef += (filterIO - filterLow - (filterRef * filterResDy)) * filterDy;
+        filterIO = (signed char)(filterRef - filterLow / 4);
+        return;
+    }
+    
+    if (filterType == FASTSID_HIGH_PASS) {
+        filterLow += filterRef * filterDy * 0.1;
+        filterRef += (filterIO - filterLow - (filterRef * filterResDy)) * filterDy;
+        sample = filterRef - (filterIO / 8);
+        sample = MAX(sample, -128);
+        sample = MIN(sample, 127);
+        filterIO = (signed char)sample;
+        return;
+    }
+    
+    filterLow += filterRef * filterDy;
+    sample = filterIO;
+    sample2 = sample - filterLow;
+    int tmp = (int)sample2;
+    sample2 -= filterRef * filterResDy;
+    filterRef += sample2 * filterDy;
+    
+    switch (filterType) {
+            
+        case FASTSID_LOW_PASS:
+        case FASTSID_BAND_PASS | FASTSID_LOW_PASS:
+            filterIO = (signed char)filterLow;
+            break;
+            
+        case FASTSID_HIGH_PASS | FASTSID_LOW_PASS:
+        case FASTSID_HIGH_PASS | FASTSID_BAND_PASS | FASTSID_LOW_PASS:
+            filterIO = (signed char)((int)(sample) - (tmp >> 1));
+            break;
+            
+        case FASTSID_HIGH_PASS | FASTSID_BAND_PASS:
+            filterIO = (signed char)tmp;
+            break;
+            
+        default:
+            assert(false); 
+            filterIO = 0;
+    }
+}
+
 #endif
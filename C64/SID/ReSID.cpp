@@ -151,17 +151,24 @@ ReSID::setSamplingMethod(SamplingMethod value)
 }
 
 void
-ReSID::loadFromBuffer(uint8_t **buffer)
+ReSID::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
-    VirtualComponent::loadFromBuffer(buffer);
+    VirtualComponent::loadFromBuffer(buffer, format);
     sid->write_state(st);
 }
 
 void
-ReSID::saveToBuffer(uint8_t **buffer)
+ReSID::saveToBuffer(uint8_t **buffer, SnapshotFormat format)
 {
     st = sid->read_state();
-    VirtualComponent::saveToBuffer(buffer);
+    VirtualComponent::saveToBuffer(buffer, format);
+}
+
+uint64_t
+ReSID::hashState(uint64_t seed)
+{
+    st = sid->read_state();
+    return VirtualComponent::hashState(seed);
 }
 
 uint8_t
@@ -201,6 +208,13 @@ ReSID::execute(uint64_t elapsedCycles)
     }
 }
 
+void
+ReSID::executeSilently(uint64_t elapsedCycles)
+{
+    assert(elapsedCycles <= PAL_CYCLES_PER_SECOND);
+    sid->clock_voices((reSID::cycle_count)elapsedCycles);
+}
+
 void
 ReSID::dumpState()
 {
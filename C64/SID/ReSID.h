@@ -58,10 +58,13 @@ public:
 	void reset();
 	
     //! Load state
-	void loadFromBuffer(uint8_t **buffer);
+	void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
 
     //! Save state
-    void saveToBuffer(uint8_t **buffer);
+    void saveToBuffer(uint8_t **buffer, SnapshotFormat format);
+
+    //! Hash state (reads back the reSID state first)
+    uint64_t hashState(uint64_t seed);
 
 	//! Dump internal state to console
 	void dumpState();
@@ -78,6 +81,12 @@ public:
      */
     void execute(uint64_t cycles);
 	
+    /*! @brief   Execute SID without generating sound samples
+     *  @details Only the oscillators and envelope generators are clocked. The filters
+     *           stay untouched and no samples are written into the ring buffer.
+     */
+    void executeSilently(uint64_t cycles);
+
 
     // Configuring
     
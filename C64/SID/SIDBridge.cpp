@@ -18,6 +18,15 @@
 
 #include "C64.h"
 
+static void
+*runWorker(void *thisBridge)
+{
+    assert(thisBridge != NULL);
+    
+    ((SIDBridge *)thisBridge)->workerMain();
+    return NULL;
+}
+
 SIDBridge::SIDBridge()
 {
 	setDescription("SIDBridge");
@@ -42,15 +51,42 @@ SIDBridge::SIDBridge()
     registerSnapshotItems(items, sizeof(items));
     
     useReSID = true;
+    audioOff = false;
+    async = false;
+    
+    queueReadPtr = 0;
+    queueWritePtr = 0;
+    workerQuit = false;
+    pthread_mutex_init(&workerLock, NULL);
+    pthread_cond_init(&workerWake, NULL);
+    pthread_cond_init(&workerIdle, NULL);
+    
+    readPtr = 0;
+    writePtr = 0;
+    resamplePos = 0.0;
+    lastInputSample = 0.0f;
+    lastOutputSample = 0.0f;
+    resampleRatio = 1.0;
 }
 
 SIDBridge::~SIDBridge()
 {
+    // Terminate the worker thread without processing pending events
+    if (async) {
+        workerQuit = true;
+        wakeWorker();
+        pthread_join(worker, NULL);
+    }
+    
+    pthread_cond_destroy(&workerIdle);
+    pthread_cond_destroy(&workerWake);
+    pthread_mutex_destroy(&workerLock);
 }
 
 void
 SIDBridge::reset()
 {
+    drainQueue();
     VirtualComponent::reset();
 
     clearRingbuffer();
@@ -62,21 +98,100 @@ SIDBridge::reset()
 }
 
 void
-SIDBridge::loadFromBuffer(uint8_t **buffer)
+SIDBridge::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
-    VirtualComponent::loadFromBuffer(buffer);
+    drainQueue();
+    VirtualComponent::loadFromBuffer(buffer, format);
     clearRingbuffer();
 }
 
+void
+SIDBridge::saveToBuffer(uint8_t **buffer, SnapshotFormat format)
+{
+    // Make sure that a lazily updated SID is saved in an up-to-date state
+    if (audioOff)
+        synchronize();
+    
+    drainQueue();
+    
+    VirtualComponent::saveToBuffer(buffer, format);
+}
+
+uint64_t
+SIDBridge::hashState(uint64_t seed)
+{
+    if (audioOff)
+        synchronize();
+    
+    drainQueue();
+    
+    return VirtualComponent::hashState(seed);
+}
+
 void 
 SIDBridge::setReSID(bool enable)
 {
+    c64->suspend();
+    drainQueue();
     useReSID = enable;
+    c64->resume();
+}
+
+void
+SIDBridge::setAudioOff(bool value)
+{
+    if (value == audioOff)
+        return;
+    
+    c64->suspend();
+    
+    // Bring the SID up to date in the old mode
+    synchronize();
+    audioOff = value;
+    clearRingbuffer();
+    
+    c64->resume();
+}
+
+void
+SIDBridge::setAsync(bool value)
+{
+    if (value == async)
+        return;
+    
+    c64->suspend();
+    
+    if (value) {
+        
+        queueReadPtr = 0;
+        queueWritePtr = 0;
+        workerQuit = false;
+        if (pthread_create(&worker, NULL, runWorker, (void *)this) != 0) {
+            warn("Failed to create the SID worker thread\n");
+            c64->resume();
+            return;
+        }
+        async = true;
+        debug(2, "SID synthesis moved to worker thread\n");
+        
+    } else {
+        
+        drainQueue();
+        workerQuit = true;
+        wakeWorker();
+        pthread_join(worker, NULL);
+        async = false;
+        debug(2, "SID synthesis moved back to emulator thread\n");
+    }
+    
+    c64->resume();
 }
 
 void 
 SIDBridge::dumpState()
 {
+    drainQueue();
+    
     if (useReSID) {
         resid.dumpState();
     } else {
@@ -104,7 +219,7 @@ SIDBridge::peek(uint16_t addr)
     assert(addr <= 0x1F);
     
     // Get SID up to date
-    executeUntil(c64->getCycles());
+    synchronize();
     
     if (addr == 0x19) {
         return c64->potXBits();
@@ -130,8 +245,14 @@ SIDBridge::spy(uint16_t addr)
 void 
 SIDBridge::poke(uint16_t addr, uint8_t value)
 {
+    // Let the worker thread perform the write at the right time
+    if (async && !audioOff) {
+        enqueue(c64->getCycles(), addr, value);
+        return;
+    }
+    
     // Get SID up to date
-    executeUntil(c64->getCycles());
+    synchronize();
 
     // Keep both SID implementations up to date
     resid.poke(addr, value);
@@ -140,6 +261,24 @@ SIDBridge::poke(uint16_t addr, uint8_t value)
 
 void
 SIDBridge::executeUntil(uint64_t targetCycle)
+{
+    PROFILE_SCOPE(c64->profiler, PROF_SID);
+    
+    // In audio-off mode, the SID is brought up to date in synchronize()
+    if (audioOff)
+        return;
+    
+    if (async) {
+        enqueue(targetCycle, syncMarker, 0);
+        wakeWorker();
+        return;
+    }
+    
+    catchUp(targetCycle);
+}
+
+void
+SIDBridge::catchUp(uint64_t targetCycle)
 {
     uint64_t missingCycles = targetCycle - cycles;
     
@@ -152,6 +291,120 @@ SIDBridge::executeUntil(uint64_t targetCycle)
     cycles = targetCycle;
 }
 
+void
+SIDBridge::synchronize()
+{
+    if (!audioOff) {
+        executeUntil(c64->getCycles());
+        drainQueue();
+        return;
+    }
+    
+    // Only ReSID emulates OSC3 and ENV3. FastSID has nothing to catch up with.
+    uint64_t missingCycles = c64->getCycles() - cycles;
+    while (useReSID && missingCycles) {
+        uint64_t chunk = missingCycles < PAL_CYCLES_PER_SECOND ? missingCycles : PAL_CYCLES_PER_SECOND;
+        resid.executeSilently(chunk);
+        missingCycles -= chunk;
+    }
+    cycles = c64->getCycles();
+}
+
+void
+SIDBridge::enqueue(uint64_t cycle, uint16_t addr, uint8_t value)
+{
+    uint32_t w = queueWritePtr.load(std::memory_order_relaxed);
+    uint32_t next = (w + 1) % queueSize;
+    
+    // Wait for the worker thread if the queue is full
+    if (next == queueReadPtr.load(std::memory_order_acquire)) {
+        
+        int state;
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+        pthread_mutex_lock(&workerLock);
+        pthread_cond_signal(&workerWake);
+        while (next == queueReadPtr.load(std::memory_order_acquire)) {
+            pthread_cond_wait(&workerIdle, &workerLock);
+        }
+        pthread_mutex_unlock(&workerLock);
+        pthread_setcancelstate(state, NULL);
+    }
+    
+    queue[w].cycle = cycle;
+    queue[w].addr = addr;
+    queue[w].value = value;
+    queueWritePtr.store(next, std::memory_order_release);
+}
+
+void
+SIDBridge::wakeWorker()
+{
+    pthread_mutex_lock(&workerLock);
+    pthread_cond_signal(&workerWake);
+    pthread_mutex_unlock(&workerLock);
+}
+
+void
+SIDBridge::drainQueue()
+{
+    if (!async)
+        return;
+    
+    // The emulator thread must not be cancelled while waiting on the condition
+    int state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    pthread_mutex_lock(&workerLock);
+    pthread_cond_signal(&workerWake);
+    while (queueReadPtr.load(std::memory_order_acquire) !=
+           queueWritePtr.load(std::memory_order_relaxed)) {
+        pthread_cond_wait(&workerIdle, &workerLock);
+    }
+    pthread_mutex_unlock(&workerLock);
+    pthread_setcancelstate(state, NULL);
+}
+
+void
+SIDBridge::workerMain()
+{
+    debug(2, "SID worker thread started\n");
+    
+    while (1) {
+        
+        // Wait for new events
+        pthread_mutex_lock(&workerLock);
+        while (!workerQuit &&
+               queueReadPtr.load(std::memory_order_relaxed) ==
+               queueWritePtr.load(std::memory_order_acquire)) {
+            pthread_cond_wait(&workerWake, &workerLock);
+        }
+        pthread_mutex_unlock(&workerLock);
+        
+        if (workerQuit)
+            break;
+        
+        // Replay all pending events
+        uint32_t r = queueReadPtr.load(std::memory_order_relaxed);
+        uint32_t w = queueWritePtr.load(std::memory_order_acquire);
+        for (; r != w; r = (r + 1) % queueSize) {
+            
+            SIDEvent &event = queue[r];
+            catchUp(event.cycle);
+            
+            if (event.addr != syncMarker) {
+                resid.poke(event.addr, event.value);
+                fastsid.poke(event.addr, event.value);
+            }
+        }
+        
+        // Tell the emulator thread that the queue has been processed
+        pthread_mutex_lock(&workerLock);
+        queueReadPtr.store(r, std::memory_order_release);
+        pthread_cond_broadcast(&workerIdle);
+        pthread_mutex_unlock(&workerLock);
+    }
+    
+    debug(2, "SID worker thread terminated\n");
+}
 void
 SIDBridge::execute(uint64_t numCycles)
 {
@@ -169,12 +422,14 @@ SIDBridge::execute(uint64_t numCycles)
 void 
 SIDBridge::run()
 {
+    drainQueue();
     clearRingbuffer();
 }
 
 void 
 SIDBridge::halt()
 {
+    drainQueue();
     clearRingbuffer();
 }
 
@@ -191,8 +446,11 @@ SIDBridge::getAudioFilter()
 void 
 SIDBridge::setAudioFilter(bool value)
 {
+    c64->suspend();
+    drainQueue();
     resid.setAudioFilter(value);
     fastsid.setAudioFilter(value);
+    c64->resume();
 }
 
 SamplingMethod
@@ -205,8 +463,12 @@ SIDBridge::getSamplingMethod()
 void
 SIDBridge::setSamplingMethod(SamplingMethod value)
 {
+    c64->suspend();
+    drainQueue();
+    
     // Option is ReSID only
     resid.setSamplingMethod(value);
+    c64->resume();
 }
 
 SIDChipModel
@@ -227,8 +489,11 @@ SIDBridge::setChipModel(SIDChipModel model)
         model = MOS_8580;
     }
     
+    c64->suspend();
+    drainQueue();
     resid.setChipModel(model);
     fastsid.setChipModel(model);
+    c64->resume();
 }
 
 uint32_t
@@ -244,8 +509,11 @@ SIDBridge::getSampleRate()
 void 
 SIDBridge::setSampleRate(uint32_t rate)
 {
+    c64->suspend();
+    drainQueue();
     resid.setSampleRate(rate);
     fastsid.setSampleRate(rate);
+    c64->resume();
 }
 
 uint32_t
@@ -261,8 +529,11 @@ SIDBridge::getClockFrequency()
 void 
 SIDBridge::setClockFrequency(uint32_t frequency)
 {
+    c64->suspend();
+    drainQueue();
     resid.setClockFrequency(frequency);
     fastsid.setClockFrequency(frequency);
+    c64->resume();
 }
 
 
@@ -277,16 +548,29 @@ SIDBridge::clearRingbuffer()
         ringBuffer[i] = 0.0f;
     }
     
-    // Reset pointer positions
-    readPtr = 0;
-    alignWritePtr();
+    // Reset resampler
+    resamplePos = 0.0;
+    lastInputSample = 0.0f;
+    resampleRatio = 1.0;
+    
+    // Put the write pointer somewhat ahead of the read pointer
+    uint32_t r = readPtr.load(std::memory_order_acquire);
+    writePtr.store((r + targetFillLevel) % bufferSize, std::memory_order_release);
 }
 
 float
 SIDBridge::readData()
 {
-    // Read sound sample
-    float value = ringBuffer[readPtr];
+    uint32_t r = readPtr.load(std::memory_order_relaxed);
+    float value;
+    
+    // Read sound sample (repeat the last one if the buffer has run dry)
+    if (r != writePtr.load(std::memory_order_acquire)) {
+        value = lastOutputSample = ringBuffer[r];
+        readPtr.store((r + 1) % bufferSize, std::memory_order_release);
+    } else {
+        value = lastOutputSample;
+    }
     
     // Adjust volume
     if (volume != targetVolume) {
@@ -298,9 +582,6 @@ SIDBridge::readData()
     }
     value = (volume <= 0) ? 0.0f : value * (float)volume / 100000.0f;
     
-    // Advance read pointer
-    advanceReadPtr();
-    
     return value;
 }
 
@@ -353,36 +634,70 @@ SIDBridge::readStereoSamplesInterleaved(float *target, size_t n)
 void
 SIDBridge::writeData(short *data, size_t count)
 {
-    // Check for buffer overflow
-    if (bufferCapacity() < count) {
-        handleBufferOverflow();
+    unsigned fillLevel = samplesInBuffer();
+    unsigned capacity = bufferSize - 1 - fillLevel;
+    
+    // In warp mode, we don't fill up the buffer beyond the target level. Otherwise,
+    // the audio would lag far behind when switching back to normal mode.
+    if (c64->getWarp()) {
+        capacity = (fillLevel < targetFillLevel) ? targetFillLevel - fillLevel : 0;
     }
     
-    // Convert sound samples to floating point values and write into ringbuffer
+    updateResampleRatio();
+    double step = 1.0 / resampleRatio;
+    
+    uint32_t w = writePtr.load(std::memory_order_relaxed);
+    size_t written = 0;
+    size_t dropped = 0;
+    
+    // Convert sound samples to floating point values, resample, and write into ringbuffer
     for (unsigned i = 0; i < count; i++) {
-        ringBuffer[writePtr] = float(data[i]) * scale;
-        advanceWritePtr();
+        
+        float sample = float(data[i]) * scale;
+        
+        while (resamplePos < 1.0) {
+            if (written < capacity) {
+                float delta = sample - lastInputSample;
+                ringBuffer[w] = lastInputSample + delta * (float)resamplePos;
+                w = (w + 1) % bufferSize;
+                written++;
+            } else {
+                dropped++;
+            }
+            resamplePos += step;
+        }
+        resamplePos -= 1.0;
+        lastInputSample = sample;
+    }
+    
+    // Publish the new samples
+    writePtr.store(w, std::memory_order_release);
+    
+    if (dropped && !c64->getWarp()) {
+        handleBufferOverflow();
     }
 }
 
+void
+SIDBridge::updateResampleRatio()
+{
+    // Relative deviation from the target fill level
+    double error = ((double)samplesInBuffer() - targetFillLevel) / targetFillLevel;
+    if (error > 1.0) error = 1.0;
+    if (error < -1.0) error = -1.0;
+    
+    // Produce less samples if the buffer is too full and more if it is too empty
+    resampleRatio = 1.0 - maxRatioDeviation * error;
+}
+
 void
 SIDBridge::handleBufferUnderflow()
 {
-    debug(3, "SID RINGBUFFER UNDERFLOW (%ld)\n", readPtr);
+    debug(3, "SID RINGBUFFER UNDERFLOW (%ld)\n", readPtr.load());
 }
 
 void
 SIDBridge::handleBufferOverflow()
 {
-    debug(3, "SID RINGBUFFER OVERFLOW (%ld)\n", writePtr);
-    
-    if (!c64->getWarp()) {
-        // In real-time mode, we readjust the write pointer
-        alignWritePtr();
-    } else {
-        // In warp mode, we don't advance the write ptr to avoid crack noises
-        return;
-    }
+    debug(3, "SID RINGBUFFER OVERFLOW (%ld)\n", writePtr.load());
 }
-
-
@@ -25,6 +25,7 @@
 #include "FastSID.h"
 #include "ReSID.h"
 #include "SID_types.h"
+#include <atomic>
 
 class SIDBridge : public VirtualComponent {
 
@@ -44,6 +45,76 @@ private:
     //! @brief    Current clock cycle since power up
     uint64_t cycles;
     
+    /*! @brief    Indicates whether sound synthesis is switched off
+     *  @details  In audio-off mode, no sound samples are computed and the filters are not
+     *            clocked. The oscillators and envelope generators, which determine the
+     *            values of OSC3 ($D41B) and ENV3 ($D41C), are brought up to date lazily by
+     *            delta clocking whenever a SID register is accessed or the state is saved.
+     */
+    bool audioOff;
+    
+private:
+    
+    //
+    // Asynchronous mode
+    //
+    
+    //! @brief    A queued register write or synchronization point
+    typedef struct {
+        
+        //! @brief    CPU cycle at which the event takes place
+        uint64_t cycle;
+        
+        //! @brief    Register number (syncMarker for synchronization points)
+        uint16_t addr;
+        
+        //! @brief    Value written into the register
+        uint8_t value;
+        
+    } SIDEvent;
+    
+    //! @brief    Number of slots in the event queue
+    static const uint32_t queueSize = 4096;
+    
+    //! @brief    Register number indicating a synchronization point
+    static const uint16_t syncMarker = 0xFFFF;
+    
+    /*! @brief    Indicates whether sound synthesis runs on a worker thread
+     *  @details  In asynchronous mode, the emulator thread only records register writes
+     *            together with their cycle timestamps. A worker thread replays them into
+     *            ReSID or FastSID and writes the generated samples into the ringbuffer.
+     *            Register reads make the emulator thread wait until the worker has caught
+     *            up with the current cycle. The emulation result does not depend on the
+     *            mode, because the SID is clocked in exactly the same steps.
+     */
+    bool async;
+    
+    /*! @brief    Event queue (lock-free single-producer, single-consumer queue)
+     *  @details  Events are written by the emulator thread and consumed by the worker.
+     */
+    SIDEvent queue[queueSize];
+    
+    //! @brief    Queue read pointer (only modified by the worker thread)
+    std::atomic<uint32_t> queueReadPtr;
+    
+    //! @brief    Queue write pointer (only modified by the emulator thread)
+    std::atomic<uint32_t> queueWritePtr;
+    
+    //! @brief    The worker thread
+    pthread_t worker;
+    
+    //! @brief    Requests the worker thread to terminate
+    std::atomic<bool> workerQuit;
+    
+    //! @brief    Mutex protecting the condition variables below
+    pthread_mutex_t workerLock;
+    
+    //! @brief    Signaled by the emulator thread when new events are available
+    pthread_cond_t workerWake;
+    
+    //! @brief    Signaled by the worker thread when it has processed all events
+    pthread_cond_t workerIdle;
+    
 private:
     
     //
@@ -53,9 +124,24 @@ private:
     //! @brief   Number of sound samples stored in ringbuffer
     static constexpr size_t bufferSize = 12288;
     
+    /*! @brief   Number of samples the write pointer is kept ahead of the read pointer
+     *  @details With a standard sample rate of 44100 Hz, 735 samples is 1/60 sec.
+     */
+    static constexpr size_t targetFillLevel = 8 * 735;
+    
+    /*! @brief   Maximum deviation of the resampling ratio from 1.0
+     *  @details A deviation of 0.5% keeps the pitch shift below the audible threshold.
+     */
+    static constexpr double maxRatioDeviation = 0.005;
+    
     /*! @brief   The audio sample ringbuffer.
      *  @details This ringbuffer serves as the data interface between the
      *           emulation code and the audio API (CoreAudio on Mac OS X).
+     *           It is a lock-free single-producer, single-consumer queue.
+     *           Samples are written by the emulator thread only (writeData)
+     *           and read by the audio thread only (readData and friends).
+     *           Each pointer is modified by a single thread. Hence, no locks
+     *           are needed.
      */
     float ringBuffer[bufferSize];
     
@@ -66,12 +152,29 @@ private:
     static constexpr float scale = 0.000005f;
     
     /*! @brief   Ring buffer read pointer
+     *  @details Only modified by the consumer (audio thread).
      */
-    uint32_t readPtr;
+    std::atomic<uint32_t> readPtr;
     
     /*! @brief   Ring buffer write pointer
+     *  @details Only modified by the producer (emulator thread).
+     */
+    std::atomic<uint32_t> writePtr;
+    
+    /*! @brief   Position of the next output sample between the two latest input samples
+     *  @details writeData() resamples the SID output by linear interpolation.
+     *           The value ranges from 0.0 (previous sample) to 1.0 (current sample).
      */
-    uint32_t writePtr;
+    double resamplePos;
+    
+    //! @brief   Most recent input sample (used for interpolation)
+    float lastInputSample;
+    
+    //! @brief   Most recent output sample (repeated on buffer underflow)
+    float lastOutputSample;
+    
+    //! @brief   Current resampling ratio (output samples per input sample)
+    double resampleRatio;
     
     /*! @brief   Current volume
      *  @note    A value of 0 or below silences the audio playback.
@@ -110,7 +213,13 @@ public:
     void reset();
     
     //! Load state
-    void loadFromBuffer(uint8_t **buffer);
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
+    
+    //! Save state
+    void saveToBuffer(uint8_t **buffer, SnapshotFormat format);
+    
+    //! Hash state (brings the SID up to date first, like saveToBuffer)
+    uint64_t hashState(uint64_t seed);
     
 	//! @brief    Prints debug information
 	void dumpState();
@@ -132,6 +241,18 @@ public:
     //! @brief    Enables or disables the ReSID library.
     void setReSID(bool enable);
     
+    //! @brief    Returns true if sound synthesis is switched off.
+    bool getAudioOff() { return audioOff; }
+    
+    //! @brief    Switches sound synthesis off or on.
+    void setAudioOff(bool value);
+    
+    //! @brief    Returns true if sound synthesis runs on a worker thread.
+    bool getAsync() { return async; }
+    
+    //! @brief    Moves sound synthesis to a worker thread or back to the emulator thread.
+    void setAsync(bool value);
+    
     //! @brief    Returns the simulated chip model.
     SIDChipModel getChipModel();
     
@@ -201,10 +322,15 @@ public:
     // Ringbuffer handling
     //
     
-    //! @brief  Clears the ringbuffer and resets the read and write pointer
+    /*! @brief   Clears the ringbuffer
+     *  @details The write pointer is put targetFillLevel samples ahead of the read pointer.
+     *           The read pointer is left untouched, because it is owned by the audio thread.
+     */
     void clearRingbuffer();
     
-    //! @brief  Reads a single audio sample from the ringbuffer
+    /*! @brief   Reads a single audio sample from the ringbuffer
+     *  @details If the ringbuffer is empty, the most recently read sample is repeated.
+     */
     float readData();
     
     /*! @brief   Reads a certain amount of samples from ringbuffer
@@ -222,7 +348,8 @@ public:
      */
     void readStereoSamplesInterleaved(float *target, size_t n);
     
-    /*! @brief  Writes a certain number of audio samples into ringbuffer
+    /*! @brief   Writes a certain number of audio samples into ringbuffer
+     *  @details The samples are resampled with the current resampling ratio.
      */
     void writeData(short *data, size_t count);
     
@@ -238,36 +365,66 @@ public:
      */
     void handleBufferOverflow();
     
-    //! @brief   Moves read pointer one position forward
-    void advanceReadPtr() { readPtr = (readPtr + 1) % bufferSize; }
-    
-    //! @brief   Moves read pointer forward or backward
-    void advanceReadPtr(int steps) { readPtr = (readPtr + bufferSize + steps) % bufferSize; }
-    
-    //! @brief   Moves write pointer one position forward
-    void advanceWritePtr() { writePtr = (writePtr + 1) % bufferSize; }
-    
-    //! @brief   Moves write pointer forward or backward
-    void advanceWritePtr(int steps) { writePtr = (writePtr + bufferSize + steps) % bufferSize; }
+    /*! @brief   Adjusts the resampling ratio
+     *  @details The ratio is steered such that the fill level of the ringbuffer
+     *           converges to targetFillLevel. As a result, small differences
+     *           between the emulation speed and the speed of the audio device are
+     *           compensated without dropping or duplicating samples.
+     */
+    void updateResampleRatio();
     
     //! @brief   Returns number of stored samples in ringbuffer
-    unsigned samplesInBuffer() { return (writePtr + bufferSize - readPtr) % bufferSize; }
+    unsigned samplesInBuffer() {
+        return (writePtr.load(std::memory_order_acquire) + bufferSize -
+                readPtr.load(std::memory_order_acquire)) % bufferSize; }
     
     //! @brief   Returns remaining storage capacity of ringbuffer
-    unsigned bufferCapacity() { return (readPtr + bufferSize - writePtr) % bufferSize; }
+    unsigned bufferCapacity() { return bufferSize - 1 - samplesInBuffer(); }
     
-    /*! @brief   Align write pointer
-     *  @details This function puts the write pointer somewhat ahead of the read pointer.
-     *           With a standard sample rate of 44100 Hz, 735 samples is 1/60 sec.
-     */
-    void alignWritePtr() { writePtr = (readPtr + (8 * 735)) % bufferSize; }
+    //! @brief   Returns the current resampling ratio (output samples per input sample)
+    double getResampleRatio() { return resampleRatio; }
+    
+    //! @brief   Returns the current fill level of the ringbuffer in samples
+    unsigned getFillLevel() { return samplesInBuffer(); }
     
 public:
     
     /*! @brief    Executes SID until a certain cycle is reached
+     *  @details  In audio-off mode, this function does nothing. In asynchronous mode,
+     *            it only hands over the target cycle to the worker thread.
      *  @param    cycle The target cycle
      */
     void executeUntil(uint64_t targetCycle);
+    
+    /*! @brief    Brings the SID up to date with the current CPU cycle
+     *  @details  This function is called before a SID register is accessed. In
+     *            asynchronous mode, it waits until the worker thread has caught up.
+     */
+    void synchronize();
+
+private:
+    
+    //! @brief    Executes SID until a certain cycle is reached (on the calling thread)
+    void catchUp(uint64_t targetCycle);
+    
+    /*! @brief    Appends an event to the queue
+     *  @details  If the queue is full, the emulator thread waits for the worker.
+     */
+    void enqueue(uint64_t cycle, uint16_t addr, uint8_t value);
+    
+    //! @brief    Wakes up the worker thread
+    void wakeWorker();
+    
+    /*! @brief    Waits until the worker thread has processed all queued events
+     *  @details  Does nothing if the worker thread isn't running. Must be called before
+     *            the SID is accessed or reconfigured from outside the worker.
+     */
+    void drainQueue();
+    
+public:
+    
+    //! @brief    Main loop of the worker thread
+    void workerMain();
 
     /*! @brief    Executes SID for a certain number of cycles
      *  @param    cycles Number of cycles to execute
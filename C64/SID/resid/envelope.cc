@@ -174,6 +174,7 @@ EnvelopeGenerator::EnvelopeGenerator()
 
   // Counter's odd bits are high on powerup
   envelope_counter = 0xaa;
+  env3 = envelope_counter;
 
   reset();
 }
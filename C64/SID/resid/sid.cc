@@ -26,6 +26,11 @@
 
 #include "sid.h"
 #include <math.h>
+#include <mutex>
+
+#if RESID_X86_SIMD
+#include <immintrin.h>
+#endif
 
 #ifndef round
 #define round(x) (x>=0.0?floor(x+0.5):ceil(x-0.5))
@@ -34,6 +39,119 @@
 namespace reSID
 {
 
+// ----------------------------------------------------------------------------
+// Convolution kernels.
+// The 16x16 bit products are summed up pairwise by (v)pmaddwd. Because all
+// partial sums wrap around modulo 2^32 just like the scalar sum, the vector
+// kernels are bit exact.
+// ----------------------------------------------------------------------------
+int convolve_scalar(const short* a, const short* b, int n)
+{
+  int v = 0;
+  for (int i = 0; i < n; i++) {
+    v += a[i]*b[i];
+  }
+  return v;
+}
+
+#if RESID_X86_SIMD
+
+__attribute__((target("sse2")))
+int convolve_sse2(const short* a, const short* b, int n)
+{
+  __m128i acc0 = _mm_setzero_si128();
+  __m128i acc1 = _mm_setzero_si128();
+  int i = 0;
+
+  // Two accumulators to hide the latency of pmaddwd.
+  for (; i + 16 <= n; i += 16) {
+    __m128i va0 = _mm_loadu_si128((const __m128i*)(a + i));
+    __m128i vb0 = _mm_loadu_si128((const __m128i*)(b + i));
+    __m128i va1 = _mm_loadu_si128((const __m128i*)(a + i + 8));
+    __m128i vb1 = _mm_loadu_si128((const __m128i*)(b + i + 8));
+    acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(va0, vb0));
+    acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(va1, vb1));
+  }
+  __m128i acc = _mm_add_epi32(acc0, acc1);
+  if (i + 8 <= n) {
+    __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+    __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+    i += 8;
+  }
+
+  // Horizontal sum.
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+  int v = _mm_cvtsi128_si32(acc);
+
+  for (; i < n; i++) {
+    v += a[i]*b[i];
+  }
+  return v;
+}
+
+__attribute__((target("avx2")))
+int convolve_avx2(const short* a, const short* b, int n)
+{
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  int i = 0;
+
+  // Two accumulators to hide the latency of vpmaddwd.
+  for (; i + 32 <= n; i += 32) {
+    __m256i va0 = _mm256_loadu_si256((const __m256i*)(a + i));
+    __m256i vb0 = _mm256_loadu_si256((const __m256i*)(b + i));
+    __m256i va1 = _mm256_loadu_si256((const __m256i*)(a + i + 16));
+    __m256i vb1 = _mm256_loadu_si256((const __m256i*)(b + i + 16));
+    acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(va0, vb0));
+    acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(va1, vb1));
+  }
+  if (i + 16 <= n) {
+    __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+    __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+    acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(va, vb));
+    i += 16;
+  }
+  acc0 = _mm256_add_epi32(acc0, acc1);
+
+  __m128i acc = _mm_add_epi32(_mm256_castsi256_si128(acc0),
+                              _mm256_extracti128_si256(acc0, 1));
+  if (i + 8 <= n) {
+    __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+    __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(va, vb));
+    i += 8;
+  }
+
+  // Horizontal sum.
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+  int v = _mm_cvtsi128_si32(acc);
+
+  for (; i < n; i++) {
+    v += a[i]*b[i];
+  }
+  return v;
+}
+
+#endif // RESID_X86_SIMD
+
+convolve_kernel select_convolve_kernel()
+{
+#if RESID_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return convolve_avx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return convolve_sse2;
+  }
+#endif
+  return convolve_scalar;
+}
+
+
 // ----------------------------------------------------------------------------
 // Constructor.
 // ----------------------------------------------------------------------------
@@ -46,7 +164,9 @@ SID::SID()
   fir_RES = 0;
   fir_beta = 0;
   fir_f_cycles_per_sample = 0;
+  fir_f_samples_per_cycle = 0;
   fir_filter_scale = 0;
+  convolve = select_convolve_kernel();
 
   sid_model = MOS6581;
   voice[0].set_sync_source(&voice[2]);
@@ -69,7 +189,7 @@ SID::SID()
 SID::~SID()
 {
   delete[] sample;
-  delete[] fir;
+  release_fir_table(fir);
 }
 
 
@@ -349,6 +469,10 @@ SID::State SID::read_state()
   state.sid_register[j++] = (filter.res << 4) | filter.filt;
   state.sid_register[j++] = filter.mode | filter.vol;
 
+  // Reading back the state must not alter the data bus.
+  state.bus_value = bus_value;
+  state.bus_value_ttl = bus_value_ttl;
+
   // These registers are superfluous, but are included for completeness.
   for (; j < 0x1d; j++) {
     state.sid_register[j] = read(j);
@@ -357,8 +481,8 @@ SID::State SID::read_state()
     state.sid_register[j] = 0;
   }
 
-  state.bus_value = bus_value;
-  state.bus_value_ttl = bus_value_ttl;
+  bus_value = state.bus_value;
+  bus_value_ttl = state.bus_value_ttl;
   state.write_pipeline = write_pipeline;
   state.write_address = write_address;
   state.voice_mask = filter.voice_mask;
@@ -487,6 +611,108 @@ double SID::I0(double x)
 }
 
 
+// ----------------------------------------------------------------------------
+// FIR table cache.
+// The FIR tables only depend on the sampling parameters. With
+// SAMPLE_RESAMPLE_FASTMEM, a single table occupies more than 12MB. Hence,
+// the tables are shared by all SID instances using the same parameters.
+// Each table is reference counted and freed when the last user releases it.
+// ----------------------------------------------------------------------------
+namespace {
+
+struct fir_table
+{
+  int N;
+  int RES;
+  double beta;
+  double f_cycles_per_sample;
+  double f_samples_per_cycle;
+  double filter_scale;
+
+  short* data;
+  int refs;
+  fir_table* next;
+};
+
+fir_table* fir_tables = 0;
+std::mutex fir_tables_mutex;
+
+} // anonymous namespace
+
+short* SID::acquire_fir_table()
+{
+  std::lock_guard<std::mutex> lock(fir_tables_mutex);
+
+  for (fir_table* t = fir_tables; t; t = t->next) {
+    if (t->N == fir_N && t->RES == fir_RES && t->beta == fir_beta &&
+        t->f_cycles_per_sample == fir_f_cycles_per_sample &&
+        t->f_samples_per_cycle == fir_f_samples_per_cycle &&
+        t->filter_scale == fir_filter_scale) {
+      t->refs++;
+      return t->data;
+    }
+  }
+
+  fir_table* t = new fir_table;
+  t->N = fir_N;
+  t->RES = fir_RES;
+  t->beta = fir_beta;
+  t->f_cycles_per_sample = fir_f_cycles_per_sample;
+  t->f_samples_per_cycle = fir_f_samples_per_cycle;
+  t->filter_scale = fir_filter_scale;
+  t->data = new short[fir_N*fir_RES];
+  t->refs = 1;
+  t->next = fir_tables;
+  fir_tables = t;
+
+  const double pi = 3.1415926535897932385;
+  const double I0beta = I0(fir_beta);
+
+  // The cutoff frequency is midway through the transition band (nyquist)
+  const double wc = pi;
+
+  // Calculate fir_RES FIR tables for linear interpolation.
+  for (int i = 0; i < fir_RES; i++) {
+    int fir_offset = i*fir_N + fir_N/2;
+    double j_offset = double(i)/fir_RES;
+    // Calculate FIR table. This is the sinc function, weighted by the
+    // Kaiser window.
+    for (int j = -fir_N/2; j <= fir_N/2; j++) {
+      double jx = j - j_offset;
+      double wt = wc*jx/fir_f_cycles_per_sample;
+      double temp = jx/(fir_N/2);
+      double Kaiser = fabs(temp) <= 1 ? I0(fir_beta*sqrt(1 - temp*temp))/I0beta : 0;
+      double sincwt = fabs(wt) >= 1e-6 ? sin(wt)/wt : 1;
+      double val = (1 << FIR_SHIFT)*fir_filter_scale*fir_f_samples_per_cycle*wc/pi*sincwt*Kaiser;
+      t->data[fir_offset + j] = (short)round(val);
+    }
+  }
+
+  return t->data;
+}
+
+void SID::release_fir_table(short* table)
+{
+  if (!table) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(fir_tables_mutex);
+
+  for (fir_table** t = &fir_tables; *t; t = &(*t)->next) {
+    if ((*t)->data == table) {
+      if (--(*t)->refs == 0) {
+        fir_table* unused = *t;
+        *t = unused->next;
+        delete[] unused->data;
+        delete unused;
+      }
+      return;
+    }
+  }
+}
+
+
 // ----------------------------------------------------------------------------
 // Setting of SID sampling parameters.
 //
@@ -554,7 +780,7 @@ bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
   if (method != SAMPLE_RESAMPLE && method != SAMPLE_RESAMPLE_FASTMEM)
   {
     delete[] sample;
-    delete[] fir;
+    release_fir_table(fir);
     sample = 0;
     fir = 0;
     return true;
@@ -576,14 +802,11 @@ bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
   const double A = -20*log10(1.0/(1 << 16));
   // A fraction of the bandwidth is allocated to the transition band,
   double dw = (1 - 2*pass_freq/sample_freq)*pi*2;
-  // The cutoff frequency is midway through the transition band (nyquist)
-  double wc = pi;
 
   // For calculation of beta and N see the reference for the kaiserord
   // function in the MATLAB Signal Processing Toolbox:
   // http://www.mathworks.com/access/helpdesk/help/toolbox/signal/kaiserord.html
   const double beta = 0.1102*(A - 8.7);
-  const double I0beta = I0(beta);
 
   // The filter order will maximally be 124 with the current constraints.
   // N >= (96.33 - 7.95)/(2.285*0.1*pi) -> N >= 123
@@ -607,39 +830,21 @@ bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
   int n = (int)ceil(log(res/f_cycles_per_sample)/log(2.0f));
   int fir_RES_new = 1 << n;
 
-  /* Determine if we need to recalculate table, or whether we can reuse earlier cached copy.
-   * This pays off on slow hardware such as current Android devices.
-   */
-  if (fir && fir_RES_new == fir_RES && fir_N_new == fir_N && beta == fir_beta && f_cycles_per_sample == fir_f_cycles_per_sample && fir_filter_scale == filter_scale) {
+  // Determine if we can keep the current table. Otherwise, the matching
+  // table is taken from the FIR table cache when it is needed first.
+  if (fir && fir_RES_new == fir_RES && fir_N_new == fir_N && beta == fir_beta && f_cycles_per_sample == fir_f_cycles_per_sample && f_samples_per_cycle == fir_f_samples_per_cycle && fir_filter_scale == filter_scale) {
       return true;
   }
+  release_fir_table(fir);
+  fir = 0;
+
   fir_RES = fir_RES_new;
   fir_N = fir_N_new;
   fir_beta = beta;
   fir_f_cycles_per_sample = f_cycles_per_sample;
+  fir_f_samples_per_cycle = f_samples_per_cycle;
   fir_filter_scale = filter_scale;
 
-  // Allocate memory for FIR tables.
-  delete[] fir;
-  fir = new short[fir_N*fir_RES];
-
-  // Calculate fir_RES FIR tables for linear interpolation.
-  for (int i = 0; i < fir_RES; i++) {
-    int fir_offset = i*fir_N + fir_N/2;
-    double j_offset = double(i)/fir_RES;
-    // Calculate FIR table. This is the sinc function, weighted by the
-    // Kaiser window.
-    for (int j = -fir_N/2; j <= fir_N/2; j++) {
-      double jx = j - j_offset;
-      double wt = wc*jx/f_cycles_per_sample;
-      double temp = jx/(fir_N/2);
-      double Kaiser = fabs(temp) <= 1 ? I0(beta*sqrt(1 - temp*temp))/I0beta : 0;
-      double sincwt = fabs(wt) >= 1e-6 ? sin(wt)/wt : 1;
-      double val = (1 << FIR_SHIFT)*filter_scale*f_samples_per_cycle*wc/pi*sincwt*Kaiser;
-      fir[fir_offset + j] = (short)round(val);
-    }
-  }
-
   return true;
 }
 
@@ -668,8 +873,6 @@ void SID::adjust_sampling_frequency(double sample_freq)
 // ----------------------------------------------------------------------------
 void SID::clock(cycle_count delta_t)
 {
-  int i;
-
   // Pipelined writes on the MOS8580.
   if (unlikely(write_pipeline) && likely(delta_t > 0)) {
     // Step one cycle by a recursive call to ourselves.
@@ -683,6 +886,49 @@ void SID::clock(cycle_count delta_t)
     return;
   }
 
+  // Clock envelope generators and oscillators.
+  clock_generators(delta_t);
+
+  // Clock filter.
+  filter.clock(delta_t, voice[0].output(), voice[1].output(), voice[2].output());
+
+  // Clock external filter.
+  extfilt.clock(delta_t, filter.output());
+}
+
+
+// ----------------------------------------------------------------------------
+// SID clocking - delta_t cycles without audio output.
+// Only the envelope generators and oscillators are clocked, i.e., the
+// filter and the external filter are left untouched. This is sufficient to
+// keep the OSC3 and ENV3 registers up to date.
+// ----------------------------------------------------------------------------
+void SID::clock_voices(cycle_count delta_t)
+{
+  // Pipelined writes on the MOS8580.
+  if (unlikely(write_pipeline) && likely(delta_t > 0)) {
+    // Step one cycle by a recursive call to ourselves.
+    write_pipeline = 0;
+    clock_voices(1);
+    write();
+    delta_t -= 1;
+  }
+
+  if (unlikely(delta_t <= 0)) {
+    return;
+  }
+
+  clock_generators(delta_t);
+}
+
+
+// ----------------------------------------------------------------------------
+// Clock envelope generators and oscillators - delta_t cycles.
+// ----------------------------------------------------------------------------
+void SID::clock_generators(cycle_count delta_t)
+{
+  int i;
+
   // Age bus value.
   bus_value_ttl -= delta_t;
   if (unlikely(bus_value_ttl <= 0)) {
@@ -747,12 +993,6 @@ void SID::clock(cycle_count delta_t)
   for (i = 0; i < 3; i++) {
     voice[i].wave.set_waveform_output(delta_t);
   }
-
-  // Clock filter.
-  filter.clock(delta_t, voice[0].output(), voice[1].output(), voice[2].output());
-
-  // Clock external filter.
-  extfilt.clock(delta_t, filter.output());
 }
 
 
@@ -779,8 +1019,14 @@ int SID::clock(cycle_count& delta_t, short* buf, int n, int interleave)
   case SAMPLE_INTERPOLATE:
     return clock_interpolate(delta_t, buf, n, interleave);
   case SAMPLE_RESAMPLE:
+    if (unlikely(!fir)) {
+      fir = acquire_fir_table();
+    }
     return clock_resample(delta_t, buf, n, interleave);
   case SAMPLE_RESAMPLE_FASTMEM:
+    if (unlikely(!fir)) {
+      fir = acquire_fir_table();
+    }
     return clock_resample_fastmem(delta_t, buf, n, interleave);
   }
 }
@@ -927,10 +1173,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v1 = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v1 += sample_start[j]*fir_start[j];
-    }
+    int v1 = convolve(sample_start, fir_start, fir_N);
 
     // Use next FIR table, wrap around to first FIR table using
     // next sample.
@@ -941,10 +1184,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n, int interleave)
     fir_start = fir + fir_offset*fir_N;
 
     // Convolution with filter impulse response.
-    int v2 = 0;
-    for (int k = 0; k < fir_N; k++) {
-      v2 += sample_start[k]*fir_start[k];
-    }
+    int v2 = convolve(sample_start, fir_start, fir_N);
 
     // Linear interpolation.
     // fir_offset_rmd is equal for all samples, it can thus be factorized out:
@@ -1002,10 +1242,7 @@ int SID::clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int int
     short* sample_start = sample + sample_index - fir_N + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v += sample_start[j]*fir_start[j];
-    }
+    int v = convolve(sample_start, fir_start, fir_N);
 
     v >>= FIR_SHIFT;
 
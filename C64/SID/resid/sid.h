@@ -31,6 +31,20 @@
 namespace reSID
 {
 
+// Convolution kernels for the resampling FIR filter.
+// All kernels return sum(a[i]*b[i]) with 32 bit wraparound and can thus
+// be exchanged for each other without changing a single output sample.
+typedef int (*convolve_kernel)(const short* a, const short* b, int n);
+
+int convolve_scalar(const short* a, const short* b, int n);
+#if RESID_X86_SIMD
+int convolve_sse2(const short* a, const short* b, int n);
+int convolve_avx2(const short* a, const short* b, int n);
+#endif
+
+// Returns the fastest kernel supported by the host CPU.
+convolve_kernel select_convolve_kernel();
+
 class SID
 {
 public:
@@ -49,6 +63,7 @@ public:
 
   void clock();
   void clock(cycle_count delta_t);
+  void clock_voices(cycle_count delta_t);
   int clock(cycle_count& delta_t, short* buf, int n, int interleave = 1);
   void reset();
 
@@ -105,6 +120,9 @@ public:
   int clock_resample(cycle_count& delta_t, short* buf, int n, int interleave);
   int clock_resample_fastmem(cycle_count& delta_t, short* buf, int n, int interleave);
   void write();
+  void clock_generators(cycle_count delta_t);
+  short* acquire_fir_table();
+  static void release_fir_table(short* table);
 
   chip_model sid_model;
   Voice voice[3];
@@ -156,13 +174,18 @@ public:
   int fir_RES;
   double fir_beta;
   double fir_f_cycles_per_sample;
+  double fir_f_samples_per_cycle;
   double fir_filter_scale;
 
   // Ring buffer with overflow for contiguous storage of RINGSIZE samples.
   short* sample;
 
-  // FIR_RES filter tables (FIR_N*FIR_RES).
+  // FIR_RES filter tables (FIR_N*FIR_RES), shared with other SID instances.
+  // Acquired from the FIR table cache on first use.
   short* fir;
+
+  // Convolution kernel used by the resampling methods.
+  convolve_kernel convolve;
 };
 
 
@@ -30,6 +30,13 @@
 #define HAVE_BUILTIN_EXPECT 1
 #define HAVE_LOG1P 1
 
+// Vectorized FIR convolution (SSE2 / AVX2, selected at runtime).
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define RESID_X86_SIMD 1
+#else
+#define RESID_X86_SIMD 0
+#endif
+
 // Define bool, true, and false for C++ compilers that lack these keywords.
 #if !HAVE_BOOL
 typedef int bool;
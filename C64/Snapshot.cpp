@@ -19,6 +19,7 @@
 #include "C64.h"
 
 const uint8_t Snapshot::magicBytes[] = { 'V', 'C', '6', '4', 0x00 };
+const uint8_t Snapshot::nativeMagicBytes[] = { 'V', 'C', '6', 'N', 0x00 };
 
 Snapshot::Snapshot()
 {
@@ -90,6 +91,20 @@ Snapshot::setCapacity(size_t size)
     return true;
 }
 
+SnapshotFormat
+Snapshot::getFormat()
+{
+    assert(state != NULL);
+    return header()->magic[3] == nativeMagicBytes[3] ? NATIVE_SNAPSHOT : PORTABLE_SNAPSHOT;
+}
+
+void
+Snapshot::setFormat(SnapshotFormat format)
+{
+    assert(state != NULL);
+    header()->magic[3] = (format == NATIVE_SNAPSHOT) ? nativeMagicBytes[3] : magicBytes[3];
+}
+
 bool
 Snapshot::isSnapshot(const uint8_t *buffer, size_t length)
 {
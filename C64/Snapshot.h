@@ -21,6 +21,7 @@
 #define _SNAPSHOT_INC
 
 #include "Container.h"
+#include "VirtualComponent.h"
 #include "VIC_globals.h"
 
 // Forward declarations
@@ -29,7 +30,7 @@ class C64;
 // Snapshot header
 typedef struct {
     
-    //! @brief    Magic bytes ('V','C','6','4')
+    //! @brief    Magic bytes ('V','C','6','4' or 'V','C','6','N' for native format)
     char magic[4];
     
     //! @brief    Version number (V major.minor.subminor)
@@ -64,6 +65,13 @@ private:
     //! @brief    Header signature
     static const uint8_t magicBytes[];
     
+    //! @brief    Header signature of snapshots in native format
+    /*! @details  Native snapshots are only valid inside the emulator instance that
+     *            created them. The different signature makes sure that they are never
+     *            accepted as a snapshot file.
+     */
+    static const uint8_t nativeMagicBytes[];
+    
     //! @brief    Capacity
     /*! @details  State size in bytes exluding header information
      *  @note     Number of allocated bytes is capacity + sizeof(SnapshotHeader)
@@ -148,6 +156,12 @@ public:
 	//! @brief    Sets the timestamp
 	void setTimestamp(time_t value) { header()->timestamp = value; }
 	
+    //! @brief    Returns the format of the internal state data
+    SnapshotFormat getFormat();
+    
+    //! @brief    Sets the format of the internal state data
+    void setFormat(SnapshotFormat format);
+    
 	//! Returns true, if snapshot does not contain data yet
 	bool isEmpty() { return state == NULL; }
 	
@@ -0,0 +1,229 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "C64.h"
+
+static const char hashMagic[8] = { 'V', 'C', '6', '4', 'H', 'S', 'H', 0 };
+
+StateHasher::StateHasher(C64 *c64)
+{
+    setDescription("StateHasher");
+
+    this->c64 = c64;
+    numComponents = 0;
+    memset(hashes, 0, sizeof(hashes));
+    output = NULL;
+    reference = NULL;
+    compared = 0;
+    memset(&divergence, 0, sizeof(divergence));
+}
+
+StateHasher::~StateHasher()
+{
+    stop();
+}
+
+void
+StateHasher::collectComponents()
+{
+    VirtualComponent **sub = c64->getSubComponents();
+
+    numComponents = 0;
+    for (unsigned i = 0; sub && sub[i] != NULL && numComponents < maxComponents - 1; i++) {
+        components[numComponents++] = sub[i];
+    }
+    components[numComponents++] = c64;
+}
+
+unsigned
+StateHasher::getNumComponents()
+{
+    if (numComponents == 0) collectComponents();
+    return numComponents;
+}
+
+const char *
+StateHasher::getComponentName(unsigned nr)
+{
+    return nr < getNumComponents() ? components[nr]->getDescription() : "";
+}
+
+uint64_t
+StateHasher::computeHashes()
+{
+    unsigned n = getNumComponents();
+
+    // The C64 itself only contributes its own items, sub components are hashed separately
+    for (unsigned i = 0; i < n - 1; i++) {
+        hashes[i] = components[i]->hashState(0);
+    }
+    hashes[n - 1] = c64->hashItems(0);
+
+    return hashBlock(0, hashes, n * sizeof(uint64_t));
+}
+
+bool
+StateHasher::startRecording(const char *path)
+{
+    if (output) {
+        fclose(output);
+        output = NULL;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        warn("Cannot write hash stream %s\n", path);
+        return false;
+    }
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, hashMagic, sizeof(header.magic));
+    header.version = fileVersion;
+    header.numComponents = getNumComponents();
+    fwrite(&header, sizeof(header), 1, file);
+
+    for (unsigned i = 0; i < numComponents; i++) {
+        char name[nameSize];
+        memset(name, 0, nameSize);
+        strncpy(name, getComponentName(i), nameSize - 1);
+        fwrite(name, nameSize, 1, file);
+    }
+
+    output = file;
+    return true;
+}
+
+bool
+StateHasher::startComparing(const char *path)
+{
+    FileHeader header;
+
+    if (reference) {
+        fclose(reference);
+        reference = NULL;
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        warn("Cannot open hash stream %s\n", path);
+        return false;
+    }
+
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, hashMagic, sizeof(header.magic)) != 0 ||
+        header.version != fileVersion) {
+        warn("%s is not a supported hash stream\n", path);
+        fclose(file);
+        return false;
+    }
+
+    // Both streams must hash the same components in the same order
+    bool match = header.numComponents == getNumComponents();
+    for (unsigned i = 0; i < header.numComponents; i++) {
+        char name[nameSize];
+        if (fread(name, nameSize, 1, file) != 1) {
+            match = false;
+            break;
+        }
+        name[nameSize - 1] = 0;
+        if (match && strncmp(name, getComponentName(i), nameSize - 1) != 0) {
+            match = false;
+        }
+    }
+    if (!match) {
+        warn("%s has been written for different components\n", path);
+        fclose(file);
+        return false;
+    }
+
+    reference = file;
+    compared = 0;
+    memset(&divergence, 0, sizeof(divergence));
+    return true;
+}
+
+void
+StateHasher::stop()
+{
+    if (output) {
+        fclose(output);
+        output = NULL;
+    }
+    if (reference) {
+        fclose(reference);
+        reference = NULL;
+    }
+}
+
+void
+StateHasher::endOfFrame()
+{
+    uint64_t frame = c64->getFrame();
+    uint64_t cycle = c64->getCycles();
+
+    computeHashes();
+
+    if (output) {
+        fwrite(&frame, sizeof(frame), 1, output);
+        fwrite(&cycle, sizeof(cycle), 1, output);
+        fwrite(hashes, sizeof(uint64_t), numComponents, output);
+    }
+
+    if (reference == NULL || divergence.diverged)
+        return;
+
+    // Read the reference record
+    uint64_t refFrame, refCycle, refHashes[maxComponents];
+    if (fread(&refFrame, sizeof(refFrame), 1, reference) != 1 ||
+        fread(&refCycle, sizeof(refCycle), 1, reference) != 1 ||
+        fread(refHashes, sizeof(uint64_t), numComponents, reference) != numComponents) {
+        debug(1, "End of reference hash stream reached after %llu frames\n",
+              (unsigned long long)compared);
+        fclose(reference);
+        reference = NULL;
+        return;
+    }
+
+    // Compare
+    if (refFrame != frame || refCycle != cycle) {
+        divergence.component = "Timing";
+        divergence.expected = refCycle;
+        divergence.actual = cycle;
+    } else {
+        for (unsigned i = 0; i < numComponents; i++) {
+            if (refHashes[i] != hashes[i]) {
+                divergence.component = getComponentName(i);
+                divergence.expected = refHashes[i];
+                divergence.actual = hashes[i];
+                break;
+            }
+        }
+    }
+
+    if (divergence.component) {
+        divergence.diverged = true;
+        divergence.frame = frame;
+        divergence.cycle = cycle;
+        warn("State diverges in frame %llu (cycle %llu) in component %s\n",
+             (unsigned long long)frame, (unsigned long long)cycle, divergence.component);
+        c64->putMessage(MSG_STATE_DIVERGED);
+    } else {
+        compared++;
+    }
+}
@@ -0,0 +1,156 @@
+/*!
+ * @header      StateHasher.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _STATEHASHER_INC
+#define _STATEHASHER_INC
+
+#include "VC64Object.h"
+
+// Forward declarations
+class C64;
+class VirtualComponent;
+
+/*! @class    StateHasher
+ *  @brief    Per-frame state hashes for detecting determinism divergences
+ *  @details  At the end of each frame, a 64 bit hash is computed for each sub component
+ *            of the C64 and for the C64 itself (see VirtualComponent::hashState()). The
+ *            hashes can be written into a file and compared against a reference file
+ *            written by another build. The first frame in which a hash differs is
+ *            recorded together with the diverging component.
+ *
+ *            A hash file starts with a 16 byte header (magic "VC64HSH", format version,
+ *            and the number of components), followed by the component names (16 bytes
+ *            each) and one record per frame (frame, cycle, and the component hashes).
+ *            All values are stored in host byte order.
+ */
+class StateHasher : public VC64Object {
+
+public:
+
+    //! @brief    Maximum number of hashed components
+    static const unsigned maxComponents = 32;
+
+    //! @brief    Size of a component name in the file
+    static const unsigned nameSize = 16;
+
+    //! @brief    Version of the hash file format
+    static const uint16_t fileVersion = 1;
+
+    //! @brief    Header of a hash file
+    typedef struct {
+        char magic[8];
+        uint16_t version;
+        uint16_t numComponents;
+        uint8_t reserved[4];
+    } FileHeader;
+
+    //! @brief    Location of the first divergence
+    typedef struct {
+        bool diverged;
+        uint64_t frame;
+        uint64_t cycle;
+        const char *component;
+        uint64_t expected;
+        uint64_t actual;
+    } Divergence;
+
+private:
+
+    //! @brief    Reference to the virtual C64
+    C64 *c64;
+
+    //! @brief    Hashed components (the C64 itself is hashed last)
+    VirtualComponent *components[maxComponents];
+
+    //! @brief    Number of hashed components
+    unsigned numComponents;
+
+    //! @brief    Hashes of the most recent frame
+    uint64_t hashes[maxComponents];
+
+    //! @brief    File the hash stream is written to (NULL if none)
+    FILE *output;
+
+    //! @brief    Reference hash stream (NULL if none)
+    FILE *reference;
+
+    //! @brief    Number of compared frames
+    uint64_t compared;
+
+    //! @brief    First divergence
+    Divergence divergence;
+
+public:
+
+    //! @brief    Constructor
+    StateHasher(C64 *c64);
+
+    //! @brief    Destructor
+    ~StateHasher();
+
+    //! @brief    Returns true iff hashes are computed at the end of each frame
+    bool isEnabled() { return output != NULL || reference != NULL; }
+
+    /*! @brief    Computes the hashes of all components
+     *  @return   Hash over all components
+     */
+    uint64_t computeHashes();
+
+    //! @brief    Returns the number of hashed components
+    unsigned getNumComponents();
+
+    //! @brief    Returns the name of a component
+    const char *getComponentName(unsigned nr);
+
+    //! @brief    Returns the hash of a component computed by the most recent call of computeHashes()
+    uint64_t getHash(unsigned nr) { assert(nr < maxComponents); return hashes[nr]; }
+
+    /*! @brief    Starts writing the hash stream into a file
+     *  @return   false if the file cannot be opened
+     */
+    bool startRecording(const char *path);
+
+    /*! @brief    Starts comparing against a reference stream
+     *  @return   false if the file cannot be read or has been written for different components
+     */
+    bool startComparing(const char *path);
+
+    //! @brief    Closes all files
+    void stop();
+
+    //! @brief    Returns the number of frames that have been compared
+    uint64_t getComparedFrames() { return compared; }
+
+    //! @brief    Returns the first divergence
+    Divergence getDivergence() { return divergence; }
+
+    /*! @brief    Hashes the state and writes and compares the result
+     *  @details  Called by the C64 at the end of each frame. Posts MSG_STATE_DIVERGED when the
+     *            first difference is found.
+     */
+    void endOfFrame();
+
+private:
+
+    //! @brief    Collects the components to hash
+    void collectComponents();
+};
+
+#endif
@@ -49,6 +49,9 @@ VC1541::VC1541()
         { &read_shiftreg,           sizeof(read_shiftreg),          CLEAR_ON_RESET },
         { &write_shiftreg,          sizeof(write_shiftreg),         CLEAR_ON_RESET },
         { &sync,                    sizeof(sync),                   CLEAR_ON_RESET },
+        { &sleeping,                sizeof(sleeping),               CLEAR_ON_RESET },
+        { &sleepCycle,              sizeof(sleepCycle),             CLEAR_ON_RESET },
+        { &idleLoopCycles,          sizeof(idleLoopCycles),         CLEAR_ON_RESET },
         
         // Disk properties (will survive reset)
         { &diskInserted,            sizeof(diskInserted),           KEEP_ON_RESET },
@@ -57,6 +60,7 @@ VC1541::VC1541()
     registerSnapshotItems(items, sizeof(items));
     
     sendSoundMessages = true;
+    sleepMode = true;
     resetDisk();
 }
 
@@ -76,6 +80,15 @@ VC1541::reset()
     
     cpu.setPC(0xEAA0);
     halftrack = 41;
+    disk.encodeHalftrackOnDemand(halftrack);
+    idleCycle = 0;
+}
+
+void
+VC1541::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
+{
+    VirtualComponent::loadFromBuffer(buffer, format);
+    idleCycle = 0;
 }
 
 void
@@ -105,6 +118,15 @@ VC1541::ping()
 
 }
 
+uint64_t
+VC1541::hashState(uint64_t seed)
+{
+    if (sleeping)
+        wakeUp();
+    
+    return VirtualComponent::hashState(seed);
+}
+
 void 
 VC1541::dumpState()
 {
@@ -129,13 +151,18 @@ VC1541::powerUp() {
 bool
 VC1541::executeOneCycle() {
     
+    PROFILE_SWITCH(c64->profiler, PROF_VIA);
     via1.execute();
     via2.execute();
+    PROFILE_SWITCH(c64->profiler, PROF_VC1541);
     uint8_t result = cpu.executeOneCycle();
     
     // Only proceed if drive is active
-    if (!rotating)
+    if (!rotating) {
+        if (cpu.getPC() == VC1541_IDLE_LOOP && cpu.atBeginningOfNewCommand())
+            idleLoopReached();
         return result;
+    }
     
     // Wait until next bit is ready
     if (bitReadyTimer > 0) {
@@ -149,6 +176,162 @@ VC1541::executeOneCycle() {
     return result;
 }
 
+void
+VC1541::idleLoopReached()
+{
+    if (!isQuiescent()) {
+        idleCycle = 0;
+        return;
+    }
+    
+    // Check if the last iteration of the idle loop has changed anything
+    if (idleCycle && c64->cycle < idleTimerEvent && matchesIdleState(c64->cycle - idleCycle)) {
+        sleep(c64->cycle - idleCycle);
+        return;
+    }
+
+    // Watch the next iteration
+    recordIdleState();
+}
+
+bool
+VC1541::isQuiescent()
+{
+    return
+    sleepMode &&
+    !cpu.tracingEnabled() &&
+    cpu.interruptsIdle() &&
+    via1.isSteady() &&
+    via2.isSteady();
+}
+
+void
+VC1541::recordIdleState()
+{
+    idleCycle = c64->cycle;
+    
+    idleRegisters[0] = cpu.getA();
+    idleRegisters[1] = cpu.getX();
+    idleRegisters[2] = cpu.getY();
+    idleRegisters[3] = cpu.getSP();
+    idleRegisters[4] = cpu.getP();
+    memcpy(idleRam, mem.mem, sizeof(idleRam));
+    saveVIAState(&via1, idleVIA[0], 0);
+    saveVIAState(&via2, idleVIA[1], 0);
+    idleHead = ((uint64_t)halftrack << 32) | ((uint64_t)bitoffset << 16) | (uint16_t)bitReadyTimer;
+    
+    uint64_t cycles = MIN(via1.cyclesUntilTimerEvent(), via2.cyclesUntilTimerEvent());
+    idleTimerEvent = (cycles == UINT64_MAX) ? UINT64_MAX : idleCycle + cycles;
+    mem.timerAccess = false;
+}
+
+bool
+VC1541::matchesIdleState(uint64_t cycles)
+{
+    uint8_t buffer[sizeof(idleVIA[0])];
+    
+    if (mem.timerAccess ||
+        idleRegisters[0] != cpu.getA() ||
+        idleRegisters[1] != cpu.getX() ||
+        idleRegisters[2] != cpu.getY() ||
+        idleRegisters[3] != cpu.getSP() ||
+        idleRegisters[4] != cpu.getP() ||
+        idleHead != (((uint64_t)halftrack << 32) | ((uint64_t)bitoffset << 16) | (uint16_t)bitReadyTimer) ||
+        memcmp(idleRam, mem.mem, sizeof(idleRam)) != 0) {
+        return false;
+    }
+    
+    // VIA states must match, except the timers that have counted down
+    size_t size1 = saveVIAState(&via1, buffer, cycles);
+    if (memcmp(idleVIA[0], buffer, size1) != 0)
+        return false;
+    size_t size2 = saveVIAState(&via2, buffer, cycles);
+    if (memcmp(idleVIA[1], buffer, size2) != 0)
+        return false;
+    
+    return true;
+}
+
+size_t
+VC1541::saveVIAState(VIA6522 *via, uint8_t *buffer, uint64_t cycles)
+{
+    assert(via->stateSize() <= sizeof(idleVIA[0]));
+    
+    uint16_t t1 = via->t1;
+    uint16_t t2 = via->t2;
+    uint8_t *ptr = buffer;
+    
+    if (via->delay & VIACountA1) via->t1 += cycles;
+    if (via->delay & VIACountB1) via->t2 += cycles;
+    via->saveToBuffer(&ptr, NATIVE_SNAPSHOT);
+    via->t1 = t1;
+    via->t2 = t2;
+    
+    return ptr - buffer;
+}
+
+void
+VC1541::setSleepMode(bool enable)
+{
+    c64->suspend();
+    sleepMode = enable;
+    if (!enable)
+        wakeUp();
+    c64->resume();
+}
+
+void
+VC1541::sleep(uint64_t cycles)
+{
+    assert(!sleeping);
+    assert(cycles > 0);
+    
+    sleeping = true;
+    sleepCycle = c64->cycle + 1;
+    idleLoopCycles = cycles;
+    idleCycle = 0;
+    
+    // Wake up right before a timer reaches zero
+    uint64_t timer = MIN(via1.cyclesUntilTimerEvent(), via2.cyclesUntilTimerEvent());
+    c64->scheduleEvent(EVENT_VC1541, timer == UINT64_MAX ? UINT64_MAX : c64->cycle + timer);
+}
+
+void
+VC1541::wakeUp()
+{
+    c64->cancelEvent(EVENT_VC1541);
+    
+    if (!sleeping)
+        return;
+    
+    sleeping = false;
+    
+    // Determine the number of missed cycles
+    uint64_t lastCycle = c64->cycle - 1;
+    uint64_t missed = lastCycle + 1 - sleepCycle;
+    uint64_t remaining = missed % idleLoopCycles;
+    uint64_t skipped = missed - remaining;
+    
+    // Skip over complete iterations of the idle loop
+    if (skipped) {
+        via1.advanceTimers(skipped);
+        via2.advanceTimers(skipped);
+        cpu.shiftTimeStamps(sleepCycle - idleLoopCycles + 1, sleepCycle, skipped);
+    }
+    
+    // Execute the remaining cycles with their original cycle stamps
+    uint64_t cycle = c64->cycle;
+    for (c64->cycle = lastCycle + 1 - remaining; c64->cycle <= lastCycle; c64->cycle++) {
+        executeOneCycle();
+    }
+    c64->cycle = cycle;
+    
+    // The sleep state is part of the snapshot. Clear it to make an awake drive
+    // look the same, no matter if it has slept before.
+    sleepCycle = 0;
+    idleLoopCycles = 0;
+}
+
 void
 VC1541::executeBitReady()
 {
@@ -268,6 +451,7 @@ VC1541::moveHeadUp()
 
         float position = (float)bitoffset / (float)disk.length.halftrack[halftrack];
         halftrack++;
+        disk.encodeHalftrackOnDemand(halftrack);
         bitoffset = position * disk.length.halftrack[halftrack];
          
         // Make sure new bitoffset starts at the beginning of a new byte to keep fast loader happy
@@ -290,6 +474,7 @@ VC1541::moveHeadDown()
     if (halftrack > 1) {
         float position = (float)bitoffset / (float)disk.length.halftrack[halftrack];
         halftrack--;
+        disk.encodeHalftrackOnDemand(halftrack);
         bitoffset = position * disk.length.halftrack[halftrack];
 
         // Make sure new bitoffset starts at the beginning of a new byte to keep fast loader happy
@@ -338,10 +523,13 @@ VC1541::insertDisk(Archive *a)
 
             ejectDisk();
             disk.encodeArchive(converted);
+            delete converted;
             break;
     }
     
     diskInserted = true;
+    disk.encodeHalftrackOnDemand(halftrack);
+    c64->virtualDrive.insertDisk(a);
     c64->putMessage(MSG_VC1541_DISK);
     if (sendSoundMessages)
         c64->putMessage(MSG_VC1541_DISK_SOUND);
@@ -352,6 +540,8 @@ VC1541::insertDisk(Archive *a)
 void 
 VC1541::ejectDisk()
 {
+    c64->virtualDrive.ejectDisk();
+    
     if (!hasDisk())
         return;
     
@@ -30,6 +30,13 @@
 class IEC;
 class C64;
 
+/*! @brief    Start address of the DOS idle loop
+ *  @details  When the drive has nothing to do, the DOS loops from here to $EC9B, waiting for ATN
+ *            or a pending command. It only leaves the loop in the job interrupt handler, which is
+ *            triggered periodically by timer 1 of VIA 2.
+ */
+#define VC1541_IDLE_LOOP 0xEBFF
+
 /*!
  * @brief    Virtual VC1541 drive
  * @details  Bit-accurate emulation of a VC1541
@@ -65,6 +72,9 @@ public:
     //! @brief    Resets the VC1541 drive.
     void reset();
 
+    //! @brief    Restores the drive state from a snapshot.
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
+
     /*! @brief    Resets disk properties
      *  @details  Resets all disk related properties. reset() keeps the disk alive. 
      */
@@ -75,6 +85,12 @@ public:
         
     //! @brief    Dump current state into logfile
     void dumpState();
+    
+    /*! @brief    Hashes the state
+     *  @details  A sleeping drive is woken up first. Otherwise, the hash would depend on
+     *            whether the drive has skipped over its idle loop.
+     */
+    uint64_t hashState(uint64_t seed);
 
     
 private:
@@ -115,6 +131,16 @@ public:
     //! @brief    Enables or disables sending of sound messages.
     void setSendSoundMessages(bool b) { sendSoundMessages = b; }
 
+    //! @brief    Returns true if the drive may skip over its idle loop (see sleeping).
+    bool getSleepMode() { return sleepMode; }
+
+    /*! @brief    Enables or disables sleep mode.
+     *  @details  Sleep mode is an optimization of the host performance. The emulated drive
+     *            behaves the same in both settings. A sleeping drive is woken up when sleep
+     *            mode gets disabled.
+     */
+    void setSleepMode(bool enable);
+
     
     //
     //! @functiongroup Accessing drive properties
@@ -146,7 +172,8 @@ public:
     /*! @brief    Inserts an archive as a virtual disk.
      *  @details  This function consumes some time as it needs to perform various conversions.
      *            E.g., if you provide a T64 archive, it is first converted to an D64 archive.
-     *            After that, all tracks will be GCR-encoded and written to a new disk.
+     *            After that, the tracks will be GCR-encoded and written to a new disk.
+     *            D64 tracks are encoded lazily when the drive head moves onto them.
      */
     bool insertDisk(Archive *a);
     
@@ -192,8 +219,42 @@ public:
      */
     bool executeOneCycle();
 
+    //! @brief    Returns true iff the drive is in sleep mode
+    bool isSleeping() { return sleeping; }
+    
+    /*! @brief    Terminates sleep mode
+     *  @details  The skipped cycles are made up for. Afterwards, the drive is in the same state
+     *            as if it had been executed in all cycles up to and including c64->cycle - 1.
+     *            Does nothing if the drive is not sleeping.
+     */
+    void wakeUp();
+    
 private:
     
+    /*! @brief    Helper method for executeOneCycle
+     *  @details  Method is executed whenever the CPU is about to enter the DOS idle loop.
+     */
+    void idleLoopReached();
+    
+    //! @brief    Returns true iff the drive may enter sleep mode in the current cycle
+    bool isQuiescent();
+    
+    //! @brief    Records the drive state at the beginning of an iteration of the idle loop
+    void recordIdleState();
+    
+    //! @brief    Returns true iff the drive state matches the recorded one
+    bool matchesIdleState(uint64_t cycles);
+    
+    /*! @brief    Saves the state of a VIA with both timers rewound by the specified number of cycles
+     *  @return   Number of written bytes
+     */
+    size_t saveVIAState(VIA6522 *via, uint8_t *buffer, uint64_t cycles);
+    
+    /*! @brief    Puts the drive into sleep mode
+     *  @param    cycles Duration of a single iteration of the idle loop
+     */
+    void sleep(uint64_t cycles);
+    
     /*! @brief    Helper method for executeOneCycle
      *  @details  Method is executed whenever a single bit is ready
      */
@@ -268,6 +329,53 @@ private:
     //! @brief    Indicates whether the VC1541 shall provide sound notification messages to the GUI
     bool sendSoundMessages;
 
+    
+    // ----------------------------------------------------------------------------------------
+    //                                      Sleep mode
+    // ----------------------------------------------------------------------------------------
+    
+    /*! @brief    Sleep mode
+     *  @details  Most of the time, the drive motor is off and the DOS spins in its idle loop.
+     *            Once the drive has verified that a complete iteration of the loop leaves the CPU,
+     *            the RAM, and both VIAs unchanged (except the timers that have counted down), all
+     *            subsequent iterations are known to do the same and the drive stops executing.
+     *            It wakes up when the C64 changes the IEC bus or shortly before a VIA timer
+     *            reaches zero. When it wakes up, whole iterations are skipped by advancing the
+     *            timers and the remaining cycles are executed normally.
+     *  @note     Breakpoints set inside the idle loop while the drive is sleeping are not
+     *            recognized before the drive wakes up.
+     */
+    bool sleeping;
+    
+    //! @brief    Indicates if the drive may enter sleep mode (not part of the snapshot)
+    bool sleepMode;
+    
+    //! @brief    First cycle that has not been executed by the sleeping drive
+    uint64_t sleepCycle;
+    
+    //! @brief    Number of cycles needed for one iteration of the idle loop
+    uint64_t idleLoopCycles;
+    
+    /*! @brief    Cycle in which the currently watched iteration of the idle loop has started
+     *  @details  0, if no iteration is being watched.
+     */
+    uint64_t idleCycle;
+    
+    //! @brief    CPU registers at the beginning of the watched iteration (A, X, Y, SP, P)
+    uint8_t idleRegisters[5];
+    
+    //! @brief    RAM contents at the beginning of the watched iteration
+    uint8_t idleRam[0x800];
+    
+    //! @brief    VIA states at the beginning of the watched iteration
+    uint8_t idleVIA[2][64];
+    
+    //! @brief    Head position and bit ready timer at the beginning of the watched iteration
+    uint64_t idleHead;
+    
+    //! @brief    Cycle in which the next VIA timer event occurs (if the drive keeps idling)
+    uint64_t idleTimerEvent;
+
 
     // ----------------------------------------------------------------------------------------
     //                                  Read/Write logic
@@ -335,7 +443,7 @@ public:
 
     //! @brief    Sets the current halftrack position of the drive head
     void setHalftrack(Halftrack ht) {
-        if (isHalftrackNumber(ht)) halftrack = ht;
+        if (isHalftrackNumber(ht)) { halftrack = ht; disk.encodeHalftrackOnDemand(ht); }
     }
 
     //! @brief    Returns the number of bits in the current halftrack
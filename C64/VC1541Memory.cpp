@@ -33,6 +33,7 @@ VC1541Memory::VC1541Memory()
     registerSnapshotItems(items, sizeof(items));
 
 	romFile = NULL;
+    timerAccess = false;
 }
 
 VC1541Memory::~VC1541Memory()
@@ -114,11 +115,13 @@ VC1541Memory::peek(uint16_t addr)
         // 0x0800 - 0x17FF : unmapped
         // 0x1800 - 0x1BFF : VIA 1 (repeats every 16 bytes)
         // 0x1C00 - 0x1FFF : VIA 2 (repeats every 16 bytes)
-        return
-        (addr < 0x0800) ? mem[addr] :
-        (addr < 0x1800) ? addr >> 8 :
-        (addr < 0x1C00) ? floppy->via1.peek(addr & 0xF) :
-        floppy->via2.peek(addr & 0xF);
+        if (addr < 0x0800) return mem[addr];
+        if (addr < 0x1800) return addr >> 8;
+        
+        // Registers 0x4 - 0x9 belong to the timers
+        if (((addr - 4) & 0xF) < 6) timerAccess = true;
+        
+        return (addr < 0x1C00) ? floppy->via1.peek(addr & 0xF) : floppy->via2.peek(addr & 0xF);
     }
 }
      
@@ -166,14 +169,19 @@ VC1541Memory::poke(uint16_t addr, uint8_t value)
         return;
     }
     
-    if (addr >= 0x1C00) { // VIA 2
-        floppy->via2.poke(addr & 0xF, value);
+    if (addr < 0x1800) { // Unmapped
         return;
     }
     
-    if (addr >= 0x1800) { // VIA 1
-        floppy->via1.poke(addr & 0xF, value);
+    // Registers 0x4 - 0x9 belong to the timers
+    if (((addr - 4) & 0xF) < 6) timerAccess = true;
+    
+    if (addr >= 0x1C00) { // VIA 2
+        floppy->via2.poke(addr & 0xF, value);
         return;
     }
+    
+    // VIA 1
+    floppy->via1.poke(addr & 0xF, value);
 }
 
@@ -46,6 +46,13 @@ public:
      */
 	char *romFile;
 
+    /*! @brief    Indicates that the CPU has accessed a VIA timer register
+     *  @details  The flag is set by peek and poke and cleared by the VC1541 when it starts
+     *            to watch the DOS idle loop. An idle loop that reads or writes the timers
+     *            does not behave the same in each iteration and must not be skipped.
+     */
+    bool timerAccess;
+
     /*! @brief    Checks the integrity of a VC1541 ROM image.
      *  @details  Returns true, iff the specified file contains a valid VC1541 ROM image.
      *            File integrity is checked via the checkFileHeader function.
@@ -192,6 +192,68 @@ VIA6522::executeTimer2()
     }
 }
 
+bool
+VIA6522::isSteady()
+{
+    // The event pipeline must be stable
+    if (delay != (((delay << 1) & VIAClearBits) | feed))
+        return false;
+    
+    return (delay & VIAPendingBits) == 0 && (ifr & ier) == 0;
+}
+
+uint64_t
+VIA6522::cyclesUntilTimerEvent()
+{
+    uint64_t result = UINT64_MAX;
+    
+    if ((delay & VIACountA1) && !(feed & VIAPostOneShotA0)) {
+        result = t1 ? t1 : 0x10000;
+    }
+    if ((delay & VIACountB1) && !(feed & VIAPostOneShotB0)) {
+        result = MIN(result, t2 ? t2 : 0x10000);
+    }
+    
+    return result;
+}
+
+void
+VIA6522::advanceTimers(uint64_t cycles)
+{
+    assert(cycles < cyclesUntilTimerEvent());
+    
+    if (delay & VIACountA1) {
+        
+        uint64_t underflow = t1 ? t1 : 0x10000;
+        
+        if (cycles < underflow) {
+            t1 -= cycles;
+        } else {
+            
+            // Timer 1 has fired in one-shot mode before. It reaches zero in the cycle given by
+            // variable underflow, counts down once more, and is reloaded two cycles later.
+            uint64_t offset = (cycles - underflow) % (HI_LO(t1_latch_hi, t1_latch_lo) + 2);
+            
+            switch (offset) {
+                case 0:
+                    t1 = 0;
+                    delay |= VIAReloadA1;
+                    break;
+                case 1:
+                    t1 = 0xFFFF;
+                    delay |= VIAReloadA2;
+                    break;
+                default:
+                    t1 = HI_LO(t1_latch_hi, t1_latch_lo) - (offset - 2);
+            }
+        }
+    }
+    
+    if (delay & VIACountB1) {
+        t2 -= cycles;
+    }
+}
+
 void
 VIA6522::IRQ() {
     if (ifr & ier) {
@@ -51,6 +51,8 @@ class VC1541;
 #define VIAClearCB2out1  (1ULL << 21)
 #define VIAPB7out0       (1ULL << 22) // Current value of PB7 pin (if output is enabled)
 
+#define VIAPendingBits (VIAReloadA0 | VIAReloadA1 | VIAReloadA2 | VIAReloadB0 | VIAReloadB1 | VIAReloadB2 | VIAInterrupt0 | VIAInterrupt1 | VIASetCA2out0 | VIASetCA2out1 | VIAClearCA2out0 | VIAClearCA2out1 | VIASetCB2out0 | VIASetCB2out1 | VIAClearCB2out0 | VIAClearCB2out1)
+
 #define VIAClearBits   ~((1ULL << 23) | VIACountA0 | VIACountB0 | VIAReloadA0 | VIAReloadB0 | VIAPostOneShotA0 | VIAPostOneShotB0 | VIAInterrupt0 | VIASetCA2out0 | VIAClearCA2out0 | VIASetCB2out0 | VIAClearCB2out0 | VIAPB7out0)
 
 /*! @brief    Virtual VIA6522 controller
@@ -212,6 +214,25 @@ public:
 
     //! @brief    Executes timer 2 for one cycle.
     void executeTimer2();
+
+    /*! @brief    Returns true iff the VIA is in a steady state
+     *  @details  In a steady state, no interrupt is pending, no control line is about to change,
+     *            and the only thing happening in each cycle is that the timers count down.
+     */
+    bool isSteady();
+    
+    /*! @brief    Returns the number of cycles until a timer sets its interrupt flag
+     *  @details  A timer that has already fired in one-shot mode is ignored, because it keeps
+     *            on counting (and timer 1 keeps on reloading) without any visible effect.
+     *  @note     Only meaningful if the VIA is in a steady state.
+     */
+    uint64_t cyclesUntilTimerEvent();
+    
+    /*! @brief    Lets the timers count down for the specified number of cycles
+     *  @details  This function has the same effect as calling execute() for the specified number
+     *            of cycles in a steady state. No timer must set its interrupt flag in between.
+     */
+    void advanceTimers(uint64_t cycles);
 	
 	/*! @brief    Special peek function for the I/O memory range
 	 *  @details  The peek function only handles those registers that are treated
@@ -467,6 +467,42 @@ public:
 	//! @brief    Returns the screen buffer that is currently stable.
     void *screenBuffer() { return pixelEngine.screenBuffer(); }
 
+	//! @brief    Acquires the latest complete frame for a consumer thread.
+    bool acquireFrame() { return pixelEngine.acquireFrame(); }
+
+	//! @brief    Returns the screen buffer acquired by acquireFrame().
+    void *acquiredScreenBuffer() { return pixelEngine.acquiredScreenBuffer(); }
+
+	//! @brief    Returns the number of the frame acquired by acquireFrame().
+    uint64_t acquiredFrame() { return pixelEngine.acquiredFrame(); }
+
+	//! @brief    Returns the palette index buffer that is currently stable.
+    uint8_t *indexScreenBuffer() { return pixelEngine.indexScreenBuffer(); }
+
+	//! @brief    Converts the stable palette index buffer to RGBA format.
+    void screenBufferToRGBA(void *target) { pixelEngine.screenBufferToRGBA(target); }
+
+	//! @brief    Returns true if no RGBA screen buffers are maintained.
+    bool getPaletteIndexMode() { return pixelEngine.getPaletteIndexMode(); }
+
+	//! @brief    Switches RGBA conversion off (true) or on (false).
+    void setPaletteIndexMode(bool value) { pixelEngine.setPaletteIndexMode(value); }
+
+	//! @brief    Returns the render policy.
+    RenderPolicy getRenderPolicy() { return pixelEngine.getRenderPolicy(); }
+
+	//! @brief    Sets the render policy. Takes effect in the next frame.
+    void setRenderPolicy(RenderPolicy policy) { pixelEngine.setRenderPolicy(policy); }
+
+	//! @brief    Returns the distance between two drawn frames (RENDER_EVERY_NTH).
+    unsigned getRenderInterval() { return pixelEngine.getRenderInterval(); }
+
+	//! @brief    Sets the distance between two drawn frames (RENDER_EVERY_NTH).
+    void setRenderInterval(unsigned n) { pixelEngine.setRenderInterval(n); }
+
+	//! @brief    Requests the next frame to be drawn (RENDER_ON_DEMAND).
+    void requestFrame() { pixelEngine.requestFrame(); }
+
 	//! @brief    Restores the initial state.
 	void reset();
 		
@@ -24,6 +24,8 @@ VirtualComponent::VirtualComponent()
     running = false;
 	suspendCounter = 0;	
     snapshotItems = NULL;
+    nativeRuns = NULL;
+    numNativeRuns = 0;
     subComponents = NULL;
     snapshotSize = 0;
 }
@@ -37,6 +39,9 @@ VirtualComponent::~VirtualComponent()
 
     if (snapshotItems)
         delete [] snapshotItems;
+    
+    if (nativeRuns)
+        delete [] nativeRuns;
 }
 
 void
@@ -106,11 +111,12 @@ VirtualComponent::suspend()
 {
     debug(2, "Suspending...\n");
 
-    if (isHalted())
+    // Nothing to do if the component has been halted without calling suspend()
+    if (suspendCounter == 0 && isHalted())
         return;
     
-    halt();
-    suspendCounter++;
+    if (suspendCounter++ == 0)
+        halt();
 }
 
 void
@@ -176,6 +182,19 @@ VirtualComponent::registerSnapshotItems(SnapshotItem *items, unsigned length) {
     // Determine size of snapshot on disk
     for (i = snapshotSize = 0; snapshotItems[i].data != NULL; i++)
         snapshotSize += snapshotItems[i].size;
+    
+    // Merge items that are adjacent in memory into runs for the native format
+    nativeRuns = new SnapshotItem[numItems];
+    numNativeRuns = 0;
+    for (i = 0; snapshotItems[i].data != NULL; i++) {
+        
+        SnapshotItem *last = numNativeRuns ? &nativeRuns[numNativeRuns - 1] : NULL;
+        if (last && (uint8_t *)last->data + last->size == snapshotItems[i].data) {
+            last->size += snapshotItems[i].size;
+        } else {
+            nativeRuns[numNativeRuns++] = snapshotItems[i];
+        }
+    }
 }
 
 void
@@ -206,7 +225,7 @@ VirtualComponent::stateSize()
 }
 
 void
-VirtualComponent::loadFromBuffer(uint8_t **buffer)
+VirtualComponent::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
 {
     uint8_t *old = *buffer;
     
@@ -215,9 +234,29 @@ VirtualComponent::loadFromBuffer(uint8_t **buffer)
     // Load internal state of sub components
     if (subComponents != NULL)
         for (unsigned i = 0; subComponents[i] != NULL; i++)
-            subComponents[i]->loadFromBuffer(buffer);
+            subComponents[i]->loadFromBuffer(buffer, format);
 
     // Load own internal state
+    if (format == NATIVE_SNAPSHOT) {
+        
+        for (unsigned i = 0; i < numNativeRuns; i++) {
+            readBlock(buffer, (uint8_t *)nativeRuns[i].data, nativeRuns[i].size);
+        }
+        
+    } else {
+        
+        loadItemsFromBuffer(buffer);
+    }
+    
+    if ((size_t)(*buffer - old) != VirtualComponent::stateSize()) {
+        panic("loadFromBuffer: Snapshot size is wrong.\n");
+        assert(false);
+    }
+}
+
+void
+VirtualComponent::loadItemsFromBuffer(uint8_t **buffer)
+{
     void *data; size_t size; int flags;
     for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++) {
         
@@ -246,15 +285,10 @@ VirtualComponent::loadFromBuffer(uint8_t **buffer)
             }
         }
     }
-    
-    if (*buffer - old != VirtualComponent::stateSize()) {
-        panic("loadFromBuffer: Snapshot size is wrong.\n");
-        assert(false);
-    }
 }
 
 void
-VirtualComponent::saveToBuffer(uint8_t **buffer)
+VirtualComponent::saveToBuffer(uint8_t **buffer, SnapshotFormat format)
 {
     uint8_t *old = *buffer;
 
@@ -263,10 +297,30 @@ VirtualComponent::saveToBuffer(uint8_t **buffer)
     // Save internal state of sub components
     if (subComponents != NULL) {
         for (unsigned i = 0; subComponents[i] != NULL; i++)
-            subComponents[i]->saveToBuffer(buffer);
+            subComponents[i]->saveToBuffer(buffer, format);
     }
     
     // Save own internal state
+    if (format == NATIVE_SNAPSHOT) {
+        
+        for (unsigned i = 0; i < numNativeRuns; i++) {
+            writeBlock(buffer, (uint8_t *)nativeRuns[i].data, nativeRuns[i].size);
+        }
+        
+    } else {
+        
+        saveItemsToBuffer(buffer);
+    }
+    
+    if ((size_t)(*buffer - old) != VirtualComponent::stateSize()) {
+        panic("saveToBuffer: Snapshot size is wrong.");
+        assert(false);
+    }
+}
+
+void
+VirtualComponent::saveItemsToBuffer(uint8_t **buffer)
+{
     void *data; size_t size; int flags;
     for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++) {
         
@@ -295,11 +349,30 @@ VirtualComponent::saveToBuffer(uint8_t **buffer)
             }
         }
     }
+}
+
+uint64_t
+VirtualComponent::hashState(uint64_t seed)
+{
+    uint64_t hash = seed;
     
-    if (*buffer - old != VirtualComponent::stateSize()) {
-        panic("saveToBuffer: Snapshot size is wrong.");
-        assert(false);
+    if (subComponents != NULL)
+        for (unsigned i = 0; subComponents[i] != NULL; i++)
+            hash = subComponents[i]->hashState(hash);
+    
+    return hashItems(hash);
+}
+
+uint64_t
+VirtualComponent::hashItems(uint64_t seed)
+{
+    uint64_t hash = seed;
+    
+    for (unsigned i = 0; i < numNativeRuns; i++) {
+        hash = hashBlock(hash, nativeRuns[i].data, nativeRuns[i].size);
     }
+    
+    return hash;
 }
 
 void
@@ -37,6 +37,18 @@ typedef struct {
     uint8_t prevValue;
 } uint8_delayed;
 
+//! @brief    Data format of a saved internal state
+/*! @details  The portable format stores all multi-byte values in big endian byte order and is
+ *            used for snapshot files and everything else that leaves the emulator. The native
+ *            format copies all snapshot items as they are stored in memory. It is faster, but
+ *            only valid inside the emulator instance that created it. Both formats have the
+ *            same size.
+ */
+typedef enum {
+    PORTABLE_SNAPSHOT = 0,
+    NATIVE_SNAPSHOT = 1
+} SnapshotFormat;
+
 /*! @brief    Common functionality of all virtual computer components.
  *  @details  This class defines the base functionality of all virtual components.
  *            The class comprises functions for resetting, suspending and resuming the component,
@@ -192,6 +204,15 @@ protected:
      */
     SnapshotItem *snapshotItems;
     
+    /*! @brief    Snapshot items as they are saved in native format
+     *  @details  Items that are adjacent in memory are merged into a single run and
+     *            copied with a single memcpy.
+     */
+    SnapshotItem *nativeRuns;
+    
+    //! @brief    Number of elements in nativeRuns
+    unsigned numNativeRuns;
+    
     /*! @brief    Snapshot size on disk (in bytes)
      */
     unsigned snapshotSize;
@@ -229,20 +250,52 @@ public:
     virtual size_t stateSize();
     
     /*! @brief    Load internal state from memory buffer
-     *  @note     Snapshot items of size 2, 4, or 8 are converted automatically to
-     *            big endian format.
+     *  @note     In portable format, snapshot items of size 2, 4, or 8 are converted
+     *            automatically from big endian format.
      *            Take this into account when loading byte arrays of these sizes.
      *  @param    buffer Pointer to next byte to read
+     *  @param    format Format the state has been saved in
      */
-    virtual void loadFromBuffer(uint8_t **buffer);
+    virtual void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
     
     /*! @brief    Save internal state to memory buffer
-     *  @note     Snapshot items of size 2, 4, or 8 are converted automatically to
-     *            big endian format.
+     *  @note     In portable format, snapshot items of size 2, 4, or 8 are converted
+     *            automatically to big endian format.
      *            Take this into account when saving byte arrays of these sizes.
-     *  @param    buffer Pointer to next byte to read
+     *  @param    buffer Pointer to next byte to write
+     *  @param    format Format to save the state in
      */
-    virtual void saveToBuffer(uint8_t **buffer);
+    virtual void saveToBuffer(uint8_t **buffer, SnapshotFormat format);
+    
+    
+    //
+    //! @functiongroup Hashing the internal state
+    //
+    
+    /*! @brief    Computes a 64 bit hash over the internal state
+     *  @details  The hash covers the snapshot items of this component and all of its sub
+     *            components. Components that save additional data in saveToBuffer()
+     *            include this data, too. The items are hashed as they are stored in memory
+     *            (see hashBlock()).
+     *  @param    seed Hash value to continue with
+     */
+    virtual uint64_t hashState(uint64_t seed);
+    
+    //! @brief    Computes a 64 bit hash over the snapshot items of this component only
+    uint64_t hashItems(uint64_t seed);
+    
+    //! @brief    Returns the NULL terminated list of sub components (NULL if there are none)
+    VirtualComponent **getSubComponents() { return subComponents; }
+    
+private:
+    
+    //! @brief    Loads the snapshot items of this component in portable format
+    void loadItemsFromBuffer(uint8_t **buffer);
+    
+    //! @brief    Saves the snapshot items of this component in portable format
+    void saveItemsToBuffer(uint8_t **buffer);
+    
+public:
     
     
     //
@@ -0,0 +1,648 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "C64.h"
+
+// Kernal variables (zero page)
+#define ST      0x90    // Status
+#define VERCK   0x93    // LOAD / VERIFY flag
+#define DFLTN   0x99    // Default input device
+#define SA      0xB9    // Secondary address
+#define FA      0xBA    // Device number
+#define FNLEN   0xB7    // Length of the file name
+#define FNADR   0xBB    // Pointer to the file name
+#define EAL     0xAE    // End address of LOAD and SAVE
+#define STAL    0xC1    // Start address of SAVE
+#define MEMUSS  0xC3    // Load address passed to LOAD
+
+// Trapped Kernal routines (901227-03)
+#define TRAP_TALK   0xED09
+#define TRAP_ACPTR  0xEE13
+#define TRAP_CHKIN  0xF237
+#define TRAP_OPEN   0xF3D5
+#define TRAP_LOAD   0xF4A5
+#define TRAP_SAVE   0xF5ED
+#define TRAP_CLOSE  0xF642
+
+/* Code found at the trap addresses in the stock Kernal. A trap only fires if the code
+ * matches. Otherwise, a modified Kernal (e.g., a fast loader ROM) is installed that might
+ * use the same addresses for something else.
+ */
+static const struct {
+    uint16_t addr;
+    uint8_t length;
+    uint8_t code[6];
+} kernalTraps[] = {
+
+    { TRAP_TALK,  5, { 0x09, 0x40, 0x2C, 0x09, 0x20 } },       // ORA #$40, BIT $2009
+    { TRAP_ACPTR, 5, { 0x78, 0xA9, 0x00, 0x85, 0xA5 } },       // SEI, LDA #0, STA $A5
+    { TRAP_CHKIN, 4, { 0xAA, 0x20, 0x09, 0xED } },             // TAX, JSR TALK
+    { TRAP_OPEN,  3, { 0xA5, 0xB9, 0x30 } },                   // LDA SA, BMI
+    { TRAP_LOAD,  6, { 0x85, 0x93, 0xA9, 0x00, 0x85, 0x90 } }, // STA VERCK, LDA #0, STA ST
+    { TRAP_SAVE,  4, { 0xA5, 0xBA, 0xD0, 0x03 } },             // LDA FA, BNE
+    { TRAP_CLOSE, 3, { 0x24, 0xB9, 0x30 } },                   // BIT SA, BMI
+    { 0,          0, { } }
+};
+
+VirtualDrive::VirtualDrive()
+{
+    setDescription("VirtualDrive");
+    debug(3, "Creating virtual drive at address %p...\n", this);
+
+    archive = NULL;
+    enabled = false;
+    memset(channel, 0, sizeof(channel));
+    talker = -1;
+}
+
+VirtualDrive::~VirtualDrive()
+{
+    closeAllChannels();
+    delete archive;
+}
+
+void
+VirtualDrive::reset()
+{
+    VirtualComponent::reset();
+    closeAllChannels();
+}
+
+void
+VirtualDrive::loadFromBuffer(uint8_t **buffer, SnapshotFormat format)
+{
+    VirtualComponent::loadFromBuffer(buffer, format);
+
+    // Open channels don't survive a snapshot
+    closeAllChannels();
+}
+
+void
+VirtualDrive::dumpState()
+{
+    msg("Virtual drive:\n");
+    msg("--------------\n\n");
+    msg("       Enabled : %s\n", enabled ? "yes" : "no");
+    msg("          Disk : %s\n", archive ? archive->getName() : "none");
+    msg("        Talker : %d\n", talker);
+    for (unsigned i = 0; i < 16; i++) {
+        if (channel[i].data)
+            msg("    Channel %2d : %ld of %ld bytes read\n", i, channel[i].pos, channel[i].size);
+    }
+    msg("\n");
+}
+
+void
+VirtualDrive::setEnabled(bool value)
+{
+    if (value == enabled)
+        return;
+
+    c64->suspend();
+
+    for (unsigned i = 0; kernalTraps[i].length; i++) {
+        if (value)
+            c64->cpu.setTrap(kernalTraps[i].addr);
+        else
+            c64->cpu.deleteTrap(kernalTraps[i].addr);
+    }
+    closeAllChannels();
+    enabled = value;
+
+    c64->resume();
+}
+
+void
+VirtualDrive::insertDisk(Archive *a)
+{
+    assert(a != NULL);
+
+    D64Archive *copy = NULL;
+
+    switch (a->type()) {
+
+        case D64_CONTAINER:
+        {
+            size_t length = a->writeToBuffer(NULL);
+            uint8_t *buffer = new uint8_t[length];
+            a->writeToBuffer(buffer);
+            copy = D64Archive::makeD64ArchiveWithBuffer(buffer, length);
+            delete[] buffer;
+            break;
+        }
+        case G64_CONTAINER:
+        case NIB_CONTAINER:
+
+            // No file system level access
+            break;
+
+        default:
+            copy = D64Archive::makeD64ArchiveWithAnyArchive(a);
+            break;
+    }
+
+    c64->suspend();
+    closeAllChannels();
+    delete archive;
+    archive = copy;
+    c64->resume();
+}
+
+void
+VirtualDrive::ejectDisk()
+{
+    c64->suspend();
+    closeAllChannels();
+    delete archive;
+    archive = NULL;
+    c64->resume();
+}
+
+bool
+VirtualDrive::trap(uint16_t addr)
+{
+    if (!enabled || !isGenuineKernalRoutine(addr))
+        return false;
+
+    switch (addr) {
+
+        case TRAP_TALK:
+
+            // The real drive is addressed. Stop serving ACPTR
+            talker = -1;
+            return false;
+
+        case TRAP_ACPTR: return acptr();
+        case TRAP_CHKIN: return chkin();
+        case TRAP_OPEN:  return open();
+        case TRAP_LOAD:  return load();
+        case TRAP_SAVE:  return save();
+        case TRAP_CLOSE: return close();
+    }
+    return false;
+}
+
+bool
+VirtualDrive::isGenuineKernalRoutine(uint16_t addr)
+{
+    if (c64->mem.peekSource(addr) != M_KERNAL)
+        return false;
+
+    for (unsigned i = 0; kernalTraps[i].length; i++) {
+        if (kernalTraps[i].addr == addr)
+            return memcmp(c64->mem.rom + addr, kernalTraps[i].code, kernalTraps[i].length) == 0;
+    }
+    return false;
+}
+
+void
+VirtualDrive::returnFromSubroutine(bool carry)
+{
+    uint8_t sp = c64->cpu.getSP();
+    uint8_t lo = c64->mem.ram[0x100 + (uint8_t)(sp + 1)];
+    uint8_t hi = c64->mem.ram[0x100 + (uint8_t)(sp + 2)];
+
+    c64->cpu.setSP(sp + 2);
+    c64->cpu.setC(carry);
+    c64->cpu.setPC_at_cycle_0(LO_HI(lo, hi) + 1);
+}
+
+void
+VirtualDrive::closeChannel(unsigned nr)
+{
+    assert(nr < 16);
+
+    free(channel[nr].data);
+    channel[nr].data = NULL;
+    channel[nr].size = 0;
+    channel[nr].pos = 0;
+
+    if (talker == (int)nr)
+        talker = -1;
+}
+
+void
+VirtualDrive::closeAllChannels()
+{
+    for (unsigned i = 0; i < 16; i++)
+        closeChannel(i);
+}
+
+void
+VirtualDrive::readFileName(char *name)
+{
+    uint8_t length = c64->mem.ram[FNLEN];
+    uint16_t addr = LO_HI(c64->mem.ram[FNADR], c64->mem.ram[FNADR + 1]);
+
+    for (unsigned i = 0; i < length; i++)
+        name[i] = (char)c64->mem.spy(addr + i);
+    name[length] = 0;
+}
+
+void
+VirtualDrive::parseFileName(const char *name, char *pattern, bool *replace, bool *write)
+{
+    const char *p = name;
+
+    // "@0:NAME" replaces an existing file
+    if ((*replace = (*p == '@')))
+        p++;
+
+    // Skip drive number
+    if (const char *colon = strchr(p, ':'))
+        p = colon + 1;
+
+    // Extract name and check the modifiers (",S,W", ",P,A", ...)
+    size_t i;
+    for (i = 0; p[i] && p[i] != ',' && i < 16; i++)
+        pattern[i] = p[i];
+    pattern[i] = 0;
+
+    const char *modifiers = strchr(p, ',');
+    *write = modifiers && (strchr(modifiers, 'W') || strchr(modifiers, 'A'));
+}
+
+static bool
+matchesPattern(const char *pattern, const char *name)
+{
+    for (; *pattern; pattern++, name++) {
+        if (*pattern == '*')
+            return true;
+        if (*name == 0)
+            return false;
+        if (*pattern != '?' && *pattern != *name)
+            return false;
+    }
+    return *name == 0;
+}
+
+int
+VirtualDrive::findFile(const char *pattern, bool prgOnly)
+{
+    assert(archive != NULL);
+
+    for (int n = 0; n < archive->getNumberOfItems(); n++) {
+
+        const char *type = archive->getTypeOfItem(n);
+        if (strncmp(type, "PRG", 3) != 0 &&
+            (prgOnly || (strncmp(type, "SEQ", 3) != 0 && strncmp(type, "USR", 3) != 0)))
+            continue;
+
+        if (matchesPattern(pattern, archive->getNameOfItem(n)))
+            return n;
+    }
+    return -1;
+}
+
+uint8_t *
+VirtualDrive::readFile(int item, size_t *length)
+{
+    assert(archive != NULL);
+
+    size_t capacity = 2 + 254 * (archive->getSizeOfItemInBlocks(item) + 1);
+    uint8_t *buffer = (uint8_t *)malloc(capacity);
+    uint16_t addr = archive->getDestinationAddrOfItem(item);
+    size_t size = 0;
+    int byte;
+
+    buffer[size++] = LO_BYTE(addr);
+    buffer[size++] = HI_BYTE(addr);
+
+    archive->selectItem(item);
+    while ((byte = archive->getByte()) >= 0 && size < maxFileSize) {
+
+        // The block count in the directory might be wrong
+        if (size == capacity) {
+            capacity *= 2;
+            buffer = (uint8_t *)realloc(buffer, capacity);
+        }
+        buffer[size++] = (uint8_t)byte;
+    }
+
+    *length = size;
+    return buffer;
+}
+
+// Starts a new line of a BASIC program
+static size_t
+beginLine(uint8_t *buffer, size_t *pos, uint16_t number)
+{
+    size_t start = *pos;
+
+    buffer[(*pos)++] = 0; // Link to the next line (written by endLine)
+    buffer[(*pos)++] = 0;
+    buffer[(*pos)++] = LO_BYTE(number);
+    buffer[(*pos)++] = HI_BYTE(number);
+    return start;
+}
+
+// Terminates a line of a BASIC program that is loaded at $0401
+static void
+endLine(uint8_t *buffer, size_t *pos, size_t start)
+{
+    buffer[(*pos)++] = 0;
+
+    uint16_t next = 0x0401 + (uint16_t)(*pos - 2);
+    buffer[start] = LO_BYTE(next);
+    buffer[start + 1] = HI_BYTE(next);
+}
+
+uint8_t *
+VirtualDrive::makeDirectoryListing(size_t *length)
+{
+    assert(archive != NULL);
+
+    // Each line is at most 32 bytes long
+    int items = archive->getNumberOfItems();
+    uint8_t *buffer = (uint8_t *)malloc(2 + 32 * (items + 2) + 2);
+    uint8_t *bam = archive->findSector(18, 0);
+    size_t pos = 0, line;
+
+    // Load address
+    buffer[pos++] = 0x01;
+    buffer[pos++] = 0x04;
+
+    // Header: 0 "DISK NAME" ID 2A
+    line = beginLine(buffer, &pos, 0);
+    buffer[pos++] = 0x12; // RVS ON
+    buffer[pos++] = '"';
+    for (unsigned i = 0x90; i < 0xA0; i++)
+        buffer[pos++] = (bam[i] == 0xA0) ? ' ' : bam[i];
+    buffer[pos++] = '"';
+    buffer[pos++] = ' ';
+    for (unsigned i = 0xA2; i < 0xA7; i++)
+        buffer[pos++] = (bam[i] == 0xA0) ? ' ' : bam[i];
+    endLine(buffer, &pos, line);
+
+    // One line per file: BLOCKS "NAME" TYPE
+    for (int n = 0; n < items; n++) {
+
+        size_t blocks = archive->getSizeOfItemInBlocks(n);
+        const char *name = archive->getNameOfItem(n);
+        const char *type = archive->getTypeOfItem(n);
+        size_t nameLength = strlen(name);
+
+        line = beginLine(buffer, &pos, (uint16_t)blocks);
+        for (unsigned i = (blocks < 10) ? 3 : (blocks < 100) ? 2 : 1; i > 0; i--)
+            buffer[pos++] = ' ';
+        buffer[pos++] = '"';
+        memcpy(buffer + pos, name, nameLength);
+        pos += nameLength;
+        buffer[pos++] = '"';
+        for (size_t i = nameLength; i < 16; i++)
+            buffer[pos++] = ' ';
+        if (type[0] != '*')
+            buffer[pos++] = ' ';
+        memcpy(buffer + pos, type, strlen(type));
+        pos += strlen(type);
+        endLine(buffer, &pos, line);
+    }
+
+    // Footer: BLOCKS FREE.
+    const char *footer = "BLOCKS FREE.             ";
+    line = beginLine(buffer, &pos, (uint16_t)archive->numberOfFreeBlocks());
+    memcpy(buffer + pos, footer, strlen(footer));
+    pos += strlen(footer);
+    endLine(buffer, &pos, line);
+
+    // End of program
+    buffer[pos++] = 0;
+    buffer[pos++] = 0;
+
+    *length = pos;
+    return buffer;
+}
+
+bool
+VirtualDrive::load()
+{
+    uint8_t *ram = c64->mem.ram;
+
+    if (!archive || ram[FA] != deviceNumber || ram[FNLEN] == 0)
+        return false;
+
+    char name[256], pattern[17];
+    bool replace, write;
+    uint8_t *data;
+    size_t length;
+
+    readFileName(name);
+    if (name[0] == '$') {
+        data = makeDirectoryListing(&length);
+    } else {
+        parseFileName(name, pattern, &replace, &write);
+        int item = findFile(pattern, true);
+        if (item < 0)
+            return false; // Let the real drive report the error
+        data = readFile(item, &length);
+    }
+
+    // Secondary address 0 relocates the file to the address passed in X/Y
+    uint8_t verck = c64->cpu.getA();
+    bool verify = verck != 0;
+    uint16_t start = (ram[SA] == 0) ? LO_HI(ram[MEMUSS], ram[MEMUSS + 1]) : LO_HI(data[0], data[1]);
+    uint16_t addr = start;
+    uint8_t status = 0x40; // End of file
+
+    for (size_t i = 2; i < length; i++, addr++) {
+        if (!verify) {
+            c64->mem.poke(addr, data[i]);
+        } else if (c64->mem.spy(addr) != data[i]) {
+            status |= 0x10; // Verify error
+        }
+    }
+    free(data);
+
+    debug(2, "%s %s from $%04X to $%04X\n", verify ? "Verified" : "Loaded", name, start, addr);
+
+    c64->mem.pokeRam(VERCK, verck);
+    c64->mem.pokeRam(ST, status);
+    c64->mem.pokeRam(EAL, LO_BYTE(addr));
+    c64->mem.pokeRam(EAL + 1, HI_BYTE(addr));
+    c64->cpu.setX(LO_BYTE(addr));
+    c64->cpu.setY(HI_BYTE(addr));
+    returnFromSubroutine(false);
+    return true;
+}
+
+bool
+VirtualDrive::save()
+{
+    uint8_t *ram = c64->mem.ram;
+
+    if (!archive || ram[FA] != deviceNumber || ram[FNLEN] == 0)
+        return false;
+
+    char name[256], pattern[17];
+    bool replace, write;
+
+    readFileName(name);
+    parseFileName(name, pattern, &replace, &write);
+    if (pattern[0] == 0 || strchr(pattern, '*') || strchr(pattern, '?'))
+        return false;
+
+    uint16_t start = LO_HI(ram[STAL], ram[STAL + 1]);
+    uint16_t end = LO_HI(ram[EAL], ram[EAL + 1]);
+    if (end < start)
+        return false;
+
+    // Check if the file fits on disk
+    int item = findFile(pattern, false);
+    size_t length = 2 + (end - start);
+    size_t blocks = (length + 253) / 254;
+    size_t available = archive->numberOfFreeBlocks();
+    if (item >= 0) {
+        if (!replace)
+            return false; // Let the real drive report "FILE EXISTS"
+        available += archive->getSizeOfItemInBlocks(item);
+    }
+    if (blocks > available)
+        return false;
+
+    // Gather data
+    uint8_t *data = (uint8_t *)malloc(length);
+    data[0] = LO_BYTE(start);
+    data[1] = HI_BYTE(start);
+    for (size_t i = 2; i < length; i++)
+        data[i] = c64->mem.spy(start + i - 2);
+
+    if (item >= 0)
+        archive->deleteItem(item);
+    bool success = archive->addFile(pattern, data, length);
+    free(data);
+
+    if (!success) {
+        warn("Failed to save %s\n", pattern);
+        return false;
+    }
+    debug(2, "Saved %s from $%04X to $%04X\n", pattern, start, end);
+
+    c64->mem.pokeRam(ST, 0);
+    returnFromSubroutine(false);
+    return true;
+}
+
+bool
+VirtualDrive::open()
+{
+    uint8_t *ram = c64->mem.ram;
+
+    if (!archive || ram[FA] != deviceNumber || (ram[SA] & 0x80))
+        return false;
+
+    unsigned nr = ram[SA] & 0x0F;
+    closeChannel(nr);
+
+    // Channel 1 is the write channel, channel 15 the command channel
+    if (nr == 1 || nr == 15 || ram[FNLEN] == 0)
+        return false;
+
+    char name[256], pattern[17];
+    bool replace, write;
+    uint8_t *data;
+    size_t length;
+
+    readFileName(name);
+    if (name[0] == '$') {
+        if (nr != 0)
+            return false;
+        data = makeDirectoryListing(&length);
+    } else {
+        parseFileName(name, pattern, &replace, &write);
+        if (replace || write)
+            return false;
+        int item = findFile(pattern, false);
+        if (item < 0)
+            return false;
+        data = readFile(item, &length);
+    }
+
+    debug(2, "Opened %s on channel %d (%ld bytes)\n", name, nr, length);
+    channel[nr].data = data;
+    channel[nr].size = length;
+    channel[nr].pos = 0;
+
+    c64->mem.pokeRam(ST, 0);
+    returnFromSubroutine(false);
+    return true;
+}
+
+bool
+VirtualDrive::chkin()
+{
+    uint8_t *ram = c64->mem.ram;
+
+    // On entry, A contains the device number
+    if (c64->cpu.getA() != deviceNumber || ram[FA] != deviceNumber || (ram[SA] & 0x80))
+        return false;
+
+    unsigned nr = ram[SA] & 0x0F;
+    if (!channel[nr].data)
+        return false;
+
+    talker = nr;
+    c64->mem.pokeRam(DFLTN, deviceNumber);
+    returnFromSubroutine(false);
+    return true;
+}
+
+bool
+VirtualDrive::acptr()
+{
+    uint8_t *ram = c64->mem.ram;
+
+    if (talker < 0 || ram[DFLTN] != deviceNumber || !channel[talker].data)
+        return false;
+
+    VirtualChannel &c = channel[talker];
+    uint8_t status = ram[ST];
+    uint8_t value;
+
+    if (c.pos < c.size) {
+        value = c.data[c.pos++];
+        if (c.pos == c.size)
+            status |= 0x40; // End of file
+    } else {
+        value = 0x0D;
+        status |= 0x42; // End of file, read timeout
+    }
+
+    c64->mem.pokeRam(ST, status);
+    c64->cpu.setA(value);
+    c64->cpu.setN(value & 0x80);
+    c64->cpu.setZ(value == 0);
+    returnFromSubroutine(false);
+    return true;
+}
+
+bool
+VirtualDrive::close()
+{
+    uint8_t *ram = c64->mem.ram;
+
+    if (ram[FA] != deviceNumber || (ram[SA] & 0x80))
+        return false;
+
+    unsigned nr = ram[SA] & 0x0F;
+    if (!channel[nr].data)
+        return false;
+
+    closeChannel(nr);
+    returnFromSubroutine(false);
+    return true;
+}
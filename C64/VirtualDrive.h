@@ -0,0 +1,202 @@
+/*!
+ * @header      VirtualDrive.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/* This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _VIRTUALDRIVE_INC
+#define _VIRTUALDRIVE_INC
+
+#include "VirtualComponent.h"
+
+// Forward declarations
+class Archive;
+class D64Archive;
+
+/*! @class    VirtualDrive
+ *  @brief    Kernal level emulation of device 8
+ *  @details  If enabled, the CPU is trapped whenever it enters one of the serial bus
+ *            routines of the Kernal. Instead of running the IEC protocol cycle by cycle,
+ *            the virtual drive serves the request directly from the inserted archive.
+ *            LOAD and SAVE complete within a single CPU cycle and OPEN, CHKIN, CHRIN,
+ *            and CLOSE work for reading files and the directory.
+ *
+ *            Each trap only fires if the Kernal ROM is visible and the code at the trap
+ *            address matches the stock Kernal. Requests that cannot be served (other
+ *            device numbers, the command channel, write channels, missing files) fall
+ *            through to the Kernal and reach the emulated VC1541. Fast loaders that talk
+ *            to the drive directly never enter the trapped routines and keep working
+ *            with the true drive emulation.
+ *
+ *  @note     Files written by SAVE are stored in the image of the virtual drive. They
+ *            are not visible to the emulated VC1541.
+ */
+class VirtualDrive : public VirtualComponent {
+
+public:
+
+    //! @brief    Device number served by the virtual drive
+    static const uint8_t deviceNumber = 8;
+
+    //! @brief    Maximum size of a file on a 1541 diskette
+    static const size_t maxFileSize = 683 * 254;
+
+private:
+
+    //! @brief    An open channel
+    typedef struct {
+
+        //! @brief    File contents (NULL if the channel is closed)
+        uint8_t *data;
+
+        //! @brief    Number of bytes in data
+        size_t size;
+
+        //! @brief    Read position
+        size_t pos;
+
+    } VirtualChannel;
+
+    //! @brief    File system image of the inserted disk (NULL if no disk is inserted)
+    D64Archive *archive;
+
+    //! @brief    Indicates if the Kernal traps are installed
+    bool enabled;
+
+    //! @brief    Channels 0 to 15 as selected by the secondary address
+    VirtualChannel channel[16];
+
+    //! @brief    Channel assigned by the most recent CHKIN (-1 if the drive isn't talking)
+    int talker;
+
+public:
+
+    //! @brief    Constructor
+    VirtualDrive();
+
+    //! @brief    Destructor
+    ~VirtualDrive();
+
+    //! @brief    Method from VirtualComponent
+    void reset();
+
+    //! @brief    Method from VirtualComponent
+    void loadFromBuffer(uint8_t **buffer, SnapshotFormat format);
+
+    //! @brief    Method from VirtualComponent
+    void dumpState();
+
+
+    //
+    //! @functiongroup Configuring the device
+    //
+
+    //! @brief    Returns true iff the Kernal traps are installed
+    bool isEnabled() { return enabled; }
+
+    //! @brief    Installs or removes the Kernal traps
+    void setEnabled(bool value);
+
+    //! @brief    Returns true iff a disk is accessible on file system level
+    bool hasDisk() { return archive != NULL; }
+
+    /*! @brief    Inserts a disk
+     *  @details  The virtual drive keeps a D64 copy of the archive. G64 and NIB archives
+     *            cannot be accessed on file system level. In this case, all requests are
+     *            served by the emulated VC1541.
+     */
+    void insertDisk(Archive *a);
+
+    //! @brief    Ejects the disk and closes all channels
+    void ejectDisk();
+
+
+    //
+    //! @functiongroup Serving Kernal requests
+    //
+
+    /*! @brief    Called by the CPU when it fetches an opcode from a trapped address
+     *  @details  If the request is served, the CPU registers are set up to continue
+     *            behind the JSR that called the Kernal routine.
+     *  @return   false, if the Kernal routine needs to be executed as usual
+     */
+    bool trap(uint16_t addr);
+
+private:
+
+    //! @brief    Returns true iff addr points to an unmodified Kernal routine
+    bool isGenuineKernalRoutine(uint16_t addr);
+
+    //! @brief    Emulates an RTS instruction with the specified carry flag
+    void returnFromSubroutine(bool carry);
+
+    //! @brief    Frees the buffer of a channel
+    void closeChannel(unsigned nr);
+
+    //! @brief    Closes all channels
+    void closeAllChannels();
+
+    /*! @brief    Reads the file name passed to SETNAM
+     *  @param    name  Buffer of at least 256 bytes
+     */
+    void readFileName(char *name);
+
+    /*! @brief    Splits a file name into its components
+     *  @details  Drive prefixes ("0:") are removed and the name is cut at the first comma.
+     *  @param    pattern  Buffer of at least 17 bytes
+     *  @param    replace  Set to true if the name starts with '@'
+     *  @param    write    Set to true if write or append mode is requested
+     */
+    void parseFileName(const char *name, char *pattern, bool *replace, bool *write);
+
+    /*! @brief    Searches the directory for a file
+     *  @details  The pattern may contain the wildcards '*' and '?'.
+     *  @param    prgOnly  If true, only PRG files are considered
+     *  @return   Item number or -1 if no matching file exists
+     */
+    int findFile(const char *pattern, bool prgOnly);
+
+    /*! @brief    Reads a complete file into a newly allocated buffer
+     *  @details  The buffer starts with the two byte load address.
+     */
+    uint8_t *readFile(int item, size_t *length);
+
+    /*! @brief    Creates a directory listing as produced by LOAD "$",8
+     *  @details  The listing is a BASIC program with load address $0401.
+     */
+    uint8_t *makeDirectoryListing(size_t *length);
+
+    //! @brief    Serves the LOAD routine of the Kernal
+    bool load();
+
+    //! @brief    Serves the SAVE routine of the Kernal
+    bool save();
+
+    //! @brief    Serves the serial part of the OPEN routine
+    bool open();
+
+    //! @brief    Serves the serial part of the CHKIN routine
+    bool chkin();
+
+    //! @brief    Serves the ACPTR routine (read a byte from the serial bus)
+    bool acptr();
+
+    //! @brief    Serves the serial part of the CLOSE routine
+    bool close();
+};
+
+#endif
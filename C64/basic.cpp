@@ -246,6 +246,24 @@ checkFileHeader(const char *filename, const uint8_t *header)
 	return result;
 }
 
+uint64_t
+hashBlock(uint64_t seed, const void *data, size_t size)
+{
+    const uint8_t *ptr = (const uint8_t *)data;
+    uint64_t hash = seed ^ (size * 0x9E3779B97F4A7C15ULL);
+    uint64_t word;
+    
+    for (; size >= 8; ptr += 8, size -= 8) {
+        memcpy(&word, ptr, 8);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+    for (; size > 0; ptr++, size--) {
+        hash = (hash ^ *ptr) * 0x100000001B3ULL;
+    }
+    return hash ^ (hash >> 29);
+}
+
 //! Returns elepased time since application start in microseconds
 uint64_t 
 usec()
@@ -288,23 +306,56 @@ sleepMicrosec(unsigned usec)
 	}
 }
 
+uint64_t
+nanos()
+{
+#ifdef __APPLE__
+    
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) mach_timebase_info(&timebase);
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+
+#else
+    
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+
+#endif
+}
+
 int64_t
-sleepUntil(uint64_t kernelTargetTime, uint64_t kernelEarlyWakeup)
+sleepUntil(uint64_t nanoTargetTime, uint64_t nanoEarlyWakeup)
 {
-    uint64_t now = mach_absolute_time();
+    uint64_t now = nanos();
     int64_t jitter;
     
-    if (now > kernelTargetTime)
+    if (now > nanoTargetTime)
         return 0;
     
     // Sleep
-    // printf("Sleeping for %d\n", kernelTargetTime - now);
-    mach_wait_until(kernelTargetTime - kernelEarlyWakeup);
+    // printf("Sleeping for %d\n", nanoTargetTime - now);
+    uint64_t wakeup = nanoTargetTime - nanoEarlyWakeup;
+    
+#ifdef __APPLE__
+    
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) mach_timebase_info(&timebase);
+    mach_wait_until(wakeup * timebase.denom / timebase.numer);
+
+#else
+    
+    struct timespec ts;
+    ts.tv_sec = wakeup / 1000000000;
+    ts.tv_nsec = wakeup % 1000000000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { }
+
+#endif
     
     // Count some sheep to increase precision
     unsigned sheep = 0;
     do {
-        jitter = mach_absolute_time() - kernelTargetTime;
+        jitter = nanos() - nanoTargetTime;
         sheep++;
     } while (jitter < 0);
     
@@ -32,8 +32,10 @@
 #include <sys/stat.h>
 #include <sys/param.h>
 #include <time.h>
+#ifdef __APPLE__
 #include <mach/mach.h>
 #include <mach/mach_time.h>
+#endif
 #include <unistd.h>
 #include <pthread.h>
 #include <errno.h>
@@ -203,6 +205,17 @@ bool checkFileSize(const char *filename, long min, long max);
 */
 bool checkFileHeader(const char *filename, const uint8_t *header);
 
+//
+//! @functiongroup Hashing
+//
+
+/*! @brief    Computes a fast, non-cryptographic 64 bit hash
+ *  @details  The data is processed in 64 bit words in host byte order. Hence, hash
+ *            values can only be compared between runs on the same architecture.
+ *            To hash multiple blocks, pass the result of the previous call as seed.
+ */
+uint64_t hashBlock(uint64_t seed, const void *data, size_t size);
+
 //
 //! @functiongroup Managing time
 //
@@ -230,12 +243,19 @@ uint8_t localTimeHour();
 //! @brief    Put the current thread to sleep for a certain amount of time.
 void sleepMicrosec(unsigned usec);
 
-/*! @brief    Sleeps until kernel timer reaches kernelTargetTime
- *  @param    kernelEarlyWakeup To increase timing precision, the function wakes up the thread earlier
+/*! @brief    Reads the host's monotonic clock
+ *  @details  On Mac OS X, mach_absolute_time() is queried and converted to nanoseconds.
+ *            On all other platforms, the function reads CLOCK_MONOTONIC.
+ *  @result   Elapsed nanoseconds since an arbitrary, but fixed point in time.
+ */
+uint64_t nanos();
+
+/*! @brief    Sleeps until the monotonic clock reaches nanoTargetTime
+ *  @param    nanoEarlyWakeup To increase timing precision, the function wakes up the thread earlier
  *            by this amount and waits actively in a delay loop until the deadline is reached.
- *  @result   Overshoot time (jitter), measured in kernel time. Smaller values are better, 0 is best.
+ *  @result   Overshoot time (jitter), measured in nanoseconds. Smaller values are better, 0 is best.
  */
-int64_t sleepUntil(uint64_t kernelTargetTime, uint64_t kernelEarlyWakeup);
+int64_t sleepUntil(uint64_t nanoTargetTime, uint64_t nanoEarlyWakeup);
 
 
 //
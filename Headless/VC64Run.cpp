@@ -0,0 +1,352 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* vc64-run
+ *
+ * Headless front end for the core emulator. The program loads the ROM images
+ * given on the command line, attaches the requested media, and runs the
+ * virtual C64 for a fixed number of frames. Timing synchronization is
+ * disabled, i.e., the emulator runs as fast as the host permits. At the end,
+ * the number of emulated cycles per host second is reported.
+ */
+
+#include "C64.h"
+#include <getopt.h>
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [options] rom1 rom2 rom3 rom4\n"
+            "\n"
+            "The four ROM images (Basic, Character, Kernal, VC1541) are detected automatically.\n"
+            "\n"
+            "Options:\n"
+            "  -f, --frames <n>       Number of frames to emulate (default: 500)\n"
+            "  -d, --disk <file>      Insert a disk (D64, G64, NIB, or any other archive)\n"
+            "  -t, --tape <file>      Insert a tape (TAP)\n"
+            "  -c, --cartridge <file> Attach a cartridge (CRT)\n"
+            "  -s, --snapshot <file>  Restore a snapshot before running\n"
+            "  -m, --movie <file>     Replay a recorded movie (starts from the movie's snapshot)\n"
+            "  -n, --ntsc             Emulate an NTSC machine (default: PAL)\n"
+            "  -i, --indexed          Render palette indices only (skip RGBA conversion)\n"
+            "  -r, --render <n>       Draw every n-th frame only (0: draw no frames at all)\n"
+            "  -k, --virtual-drive    Serve LOAD and SAVE on device 8 by Kernal traps\n"
+            "  -a, --no-audio         Switch off sound synthesis\n"
+            "  -y, --async-sid        Run sound synthesis on a worker thread\n"
+            "  -e, --no-drive-sleep   Execute the VC1541 in every cycle, even in its idle loop\n"
+            "  -p, --profile          Print host time per component (requires VC64_PROFILE)\n"
+            "  -T, --trace <file>     Write a binary trace of the C64 CPU (see vc64-trace)\n"
+            "  -D, --drive-trace <file> Write a binary trace of the VC1541 CPU\n"
+            "  -g, --guest-profile <file> Profile the C64 CPU (callgrind format, or text for *.txt)\n"
+            "  -G, --drive-profile <file> Profile the VC1541 CPU\n"
+            "  -o, --hash-stream <file> Write per-frame state hashes into a file\n"
+            "  -x, --hash-compare <file> Compare the state hashes against a reference stream\n"
+            "  -W, --watch <from[-to]> Stop when the CPU writes into the address range (hex)\n"
+            "  -v, --verbose          Print debug messages of the core emulator\n"
+            "  -h, --help             Print this message\n",
+            prog);
+}
+
+static bool
+saveProfile(GuestProfiler &profiler, const char *path, const char *name)
+{
+    size_t len = strlen(path);
+    if (len > 4 && strcmp(path + len - 4, ".txt") == 0) {
+        return profiler.saveFlat(path, name);
+    }
+    return profiler.saveCallgrind(path, name);
+}
+
+int
+main(int argc, char *argv[])
+{
+    static struct option longOptions[] = {
+        { "frames",    required_argument, NULL, 'f' },
+        { "disk",      required_argument, NULL, 'd' },
+        { "tape",      required_argument, NULL, 't' },
+        { "cartridge", required_argument, NULL, 'c' },
+        { "snapshot",  required_argument, NULL, 's' },
+        { "movie",     required_argument, NULL, 'm' },
+        { "ntsc",      no_argument,       NULL, 'n' },
+        { "indexed",   no_argument,       NULL, 'i' },
+        { "render",    required_argument, NULL, 'r' },
+        { "virtual-drive", no_argument,   NULL, 'k' },
+        { "no-audio",  no_argument,       NULL, 'a' },
+        { "async-sid", no_argument,       NULL, 'y' },
+        { "no-drive-sleep", no_argument,  NULL, 'e' },
+        { "profile",   no_argument,       NULL, 'p' },
+        { "trace",     required_argument, NULL, 'T' },
+        { "drive-trace", required_argument, NULL, 'D' },
+        { "guest-profile", required_argument, NULL, 'g' },
+        { "drive-profile", required_argument, NULL, 'G' },
+        { "hash-stream", required_argument, NULL, 'o' },
+        { "hash-compare", required_argument, NULL, 'x' },
+        { "watch",     required_argument, NULL, 'W' },
+        { "verbose",   no_argument,       NULL, 'v' },
+        { "help",      no_argument,       NULL, 'h' },
+        { NULL,        0,                 NULL, 0 }
+    };
+
+    long frames = 500;
+    const char *diskFile = NULL;
+    const char *tapeFile = NULL;
+    const char *crtFile = NULL;
+    const char *snapshotFile = NULL;
+    const char *movieFile = NULL;
+    bool ntsc = false;
+    bool indexed = false;
+    long render = 1;
+    bool virtualDrive = false;
+    bool noAudio = false;
+    bool asyncSid = false;
+    bool noDriveSleep = false;
+    bool profile = false;
+    const char *traceFile = NULL;
+    const char *driveTraceFile = NULL;
+    const char *guestProfileFile = NULL;
+    const char *driveProfileFile = NULL;
+    const char *hashFile = NULL;
+    const char *referenceFile = NULL;
+    const char *watchRange = NULL;
+    bool verbose = false;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "f:d:t:c:s:m:r:T:D:g:G:o:x:W:nikayepvh", longOptions, NULL)) != -1) {
+
+        switch (opt) {
+            case 'f': frames = strtol(optarg, NULL, 10); break;
+            case 'd': diskFile = optarg; break;
+            case 't': tapeFile = optarg; break;
+            case 'c': crtFile = optarg; break;
+            case 's': snapshotFile = optarg; break;
+            case 'm': movieFile = optarg; break;
+            case 'n': ntsc = true; break;
+            case 'i': indexed = true; break;
+            case 'r': render = strtol(optarg, NULL, 10); break;
+            case 'k': virtualDrive = true; break;
+            case 'a': noAudio = true; break;
+            case 'y': asyncSid = true; break;
+            case 'e': noDriveSleep = true; break;
+            case 'p': profile = true; break;
+            case 'T': traceFile = optarg; break;
+            case 'D': driveTraceFile = optarg; break;
+            case 'g': guestProfileFile = optarg; break;
+            case 'G': driveProfileFile = optarg; break;
+            case 'o': hashFile = optarg; break;
+            case 'x': referenceFile = optarg; break;
+            case 'W': watchRange = optarg; break;
+            case 'v': verbose = true; break;
+            case 'h': usage(argv[0]); return 0;
+            default: usage(argv[0]); return 1;
+        }
+    }
+
+    if (profile && !HostProfiler::isEnabled()) {
+        fprintf(stderr, "Profiling is not available (configure with -DVC64_PROFILE=ON)\n");
+        return 1;
+    }
+
+    if (frames <= 0) {
+        fprintf(stderr, "Number of frames must be positive\n");
+        return 1;
+    }
+    if (render < 0) {
+        fprintf(stderr, "Render interval must not be negative\n");
+        return 1;
+    }
+
+    // Create the emulator
+    VC64Object::setDefaultDebugLevel(verbose ? 2 : 0);
+    C64 *c64 = new C64();
+
+    if (ntsc) c64->setNTSC();
+
+    // Load ROMs
+    for (int i = optind; i < argc; i++) {
+        if (!c64->loadRom(argv[i])) {
+            fprintf(stderr, "%s: Not a valid ROM image\n", argv[i]);
+            return 1;
+        }
+    }
+    if (!c64->isRunnable()) {
+        fprintf(stderr, "Missing ROM images. Basic, Character, Kernal, and VC1541 ROM are required.\n");
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Attach media
+    if (crtFile) {
+        CRTContainer *container = CRTContainer::makeCRTContainerWithFile(crtFile);
+        if (!container || !c64->attachCartridgeAndReset(container)) {
+            fprintf(stderr, "%s: Cannot attach cartridge\n", crtFile);
+            return 1;
+        }
+        delete container;
+    }
+    if (diskFile) {
+        Archive *archive = Archive::makeArchiveWithFile(diskFile);
+        if (!archive || !c64->insertDisk(archive)) {
+            fprintf(stderr, "%s: Cannot insert disk\n", diskFile);
+            return 1;
+        }
+        delete archive;
+    }
+    if (tapeFile) {
+        TAPContainer *container = TAPContainer::makeTAPContainerWithFile(tapeFile);
+        if (!container || !c64->insertTape(container)) {
+            fprintf(stderr, "%s: Cannot insert tape\n", tapeFile);
+            return 1;
+        }
+        delete container;
+    }
+    if (snapshotFile) {
+        Snapshot *snapshot = Snapshot::makeSnapshotWithFile(snapshotFile);
+        if (!snapshot) {
+            fprintf(stderr, "%s: Cannot read snapshot\n", snapshotFile);
+            return 1;
+        }
+        c64->loadFromSnapshotUnsafe(snapshot);
+        delete snapshot;
+    }
+    if (movieFile && (!c64->movie.readFromFile(movieFile) || !c64->movie.startPlaying())) {
+        fprintf(stderr, "%s: Cannot replay movie\n", movieFile);
+        return 1;
+    }
+
+    // Run as fast as possible
+    c64->autoSaveSnapshots = false;
+    c64->setAlwaysWarp(true);
+    c64->vic.setPaletteIndexMode(indexed);
+    c64->vic.setRenderPolicy(render == 0 ? RENDER_NO_FRAMES :
+                             render == 1 ? RENDER_ALL_FRAMES : RENDER_EVERY_NTH);
+    c64->vic.setRenderInterval((unsigned)render);
+    c64->virtualDrive.setEnabled(virtualDrive);
+    c64->sid.setAudioOff(noAudio);
+    c64->sid.setAsync(asyncSid);
+    c64->floppy.setSleepMode(!noDriveSleep);
+
+    // Start tracing
+    if (traceFile && !c64->cpu.binaryTrace.openFile(traceFile, c64->cpu.chipModel)) {
+        fprintf(stderr, "%s: Cannot write trace file\n", traceFile);
+        return 1;
+    }
+    if (driveTraceFile && !c64->floppy.cpu.binaryTrace.openFile(driveTraceFile, c64->floppy.cpu.chipModel)) {
+        fprintf(stderr, "%s: Cannot write trace file\n", driveTraceFile);
+        return 1;
+    }
+
+    // Start profiling
+    if (guestProfileFile) c64->cpu.guestProfiler.enable();
+    if (driveProfileFile) c64->floppy.cpu.guestProfiler.enable();
+
+    // Start hashing
+    if (hashFile && !c64->hasher.startRecording(hashFile)) {
+        fprintf(stderr, "%s: Cannot write hash stream\n", hashFile);
+        return 1;
+    }
+    if (referenceFile && !c64->hasher.startComparing(referenceFile)) {
+        fprintf(stderr, "%s: Cannot read hash stream\n", referenceFile);
+        return 1;
+    }
+
+    // Set watchpoint
+    if (watchRange) {
+        char *end;
+        Watchpoint w = { 0, 0, WATCH_WRITE, OPERAND_VALUE, COND_ALWAYS, 0 };
+        w.from = w.to = (uint16_t)strtoul(watchRange, &end, 16);
+        if (*end == '-') w.to = (uint16_t)strtoul(end + 1, &end, 16);
+        if (*end != 0 || c64->mem.addWatchpoint(w) < 0) {
+            fprintf(stderr, "%s: Invalid address range\n", watchRange);
+            return 1;
+        }
+    }
+
+    c64->profiler.reset();
+    uint64_t startCycle = c64->getCycles();
+    uint64_t startTime = nanos();
+    long executed;
+
+    for (executed = 0; executed < frames; executed++) {
+        if (!c64->executeOneFrame()) {
+            fprintf(stderr, "Emulation stopped in frame %llu (CPU error state %d)\n",
+                    (unsigned long long)c64->getFrame(), c64->cpu.getErrorState());
+            if (c64->cpu.getErrorState() == CPU_WATCHPOINT_REACHED) {
+                WatchpointHit hit = c64->mem.getWatchpointHit();
+                fprintf(stderr, "Instruction at %04X wrote %02X into %04X\n",
+                        hit.pc, hit.value, hit.addr);
+            }
+            break;
+        }
+    }
+
+    uint64_t elapsed = nanos() - startTime;
+    c64->cpu.binaryTrace.closeFile();
+    c64->floppy.cpu.binaryTrace.closeFile();
+    if (guestProfileFile && !saveProfile(c64->cpu.guestProfiler, guestProfileFile, "C64")) {
+        fprintf(stderr, "%s: Cannot write profile\n", guestProfileFile);
+    }
+    if (driveProfileFile && !saveProfile(c64->floppy.cpu.guestProfiler, driveProfileFile, "VC1541")) {
+        fprintf(stderr, "%s: Cannot write profile\n", driveProfileFile);
+    }
+    c64->hasher.stop();
+    uint64_t cycles = c64->getCycles() - startCycle;
+    double seconds = elapsed / 1000000000.0;
+    double emulated = (double)executed / c64->vic.getFramesPerSecond();
+
+    printf("Frames          : %ld\n", executed);
+    printf("Emulated cycles : %llu\n", (unsigned long long)cycles);
+    printf("Host time       : %.3f sec\n", seconds);
+    printf("Cycles per sec  : %.0f\n", seconds > 0 ? cycles / seconds : 0.0);
+    printf("Speed           : %.2fx real time\n", seconds > 0 ? emulated / seconds : 0.0);
+
+    if (profile) {
+
+        static const char *names[PROF_COMPONENTS] = {
+            "VIC", "PixelEngine", "CPU", "VC1541", "VIAs", "CIAs",
+            "SID", "Datasette", "Snapshots", "Other" };
+        HostProfilerInfo info = c64->profiler.getInfo();
+
+        printf("\n");
+        for (unsigned i = 0; i < PROF_COMPONENTS; i++) {
+            printf("%-16s: %9.3f ms (%5.1f %%)\n", names[i],
+                   info.componentTime[i] / 1000000.0,
+                   info.totalTime ? 100.0 * info.componentTime[i] / info.totalTime : 0.0);
+        }
+        printf("Frame time      : %.3f ms (min %.3f ms, max %.3f ms)\n",
+               info.frameTimeAvg / 1000000.0, info.frameTimeMin / 1000000.0,
+               info.frameTimeMax / 1000000.0);
+        printf("Frame jitter    : %.3f ms (max %.3f ms)\n",
+               info.frameJitterAvg / 1000000.0, info.frameJitterMax / 1000000.0);
+    }
+
+    StateHasher::Divergence divergence = c64->hasher.getDivergence();
+    if (referenceFile) {
+        if (divergence.diverged) {
+            printf("State diverges  : frame %llu, cycle %llu, component %s\n",
+                   (unsigned long long)divergence.frame, (unsigned long long)divergence.cycle,
+                   divergence.component);
+        } else {
+            printf("State matches   : %llu frames\n",
+                   (unsigned long long)c64->hasher.getComparedFrames());
+        }
+    }
+
+    delete c64;
+    return (executed == frames && !divergence.diverged) ? 0 : 2;
+}
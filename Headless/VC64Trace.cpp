@@ -0,0 +1,124 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* vc64-trace
+ *
+ * Decoder for binary instruction traces as written by InstructionTrace (e.g.,
+ * vc64-run --trace). Each record is printed in the format of the text trace,
+ * prefixed with the cycle and the raster position it was recorded in.
+ */
+
+#include "C64.h"
+#include <getopt.h>
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [options] tracefile\n"
+            "\n"
+            "Options:\n"
+            "  -f, --from <cycle>     Skip all records before this cycle\n"
+            "  -t, --to <cycle>       Skip all records after this cycle\n"
+            "  -d, --decimal          Print numbers in decimal format\n"
+            "  -h, --help             Print this message\n",
+            prog);
+}
+
+int
+main(int argc, char *argv[])
+{
+    static struct option longOptions[] = {
+        { "from",      required_argument, NULL, 'f' },
+        { "to",        required_argument, NULL, 't' },
+        { "decimal",   no_argument,       NULL, 'd' },
+        { "help",      no_argument,       NULL, 'h' },
+        { NULL,        0,                 NULL, 0 }
+    };
+
+    uint64_t from = 0;
+    uint64_t to = UINT64_MAX;
+    bool hex = true;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "f:t:dh", longOptions, NULL)) != -1) {
+
+        switch (opt) {
+            case 'f': from = strtoull(optarg, NULL, 10); break;
+            case 't': to = strtoull(optarg, NULL, 10); break;
+            case 'd': hex = false; break;
+            case 'h': usage(argv[0]); return 0;
+            default: usage(argv[0]); return 1;
+        }
+    }
+
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *file = fopen(argv[optind], "rb");
+    if (file == NULL) {
+        fprintf(stderr, "%s: Cannot open file\n", argv[optind]);
+        return 1;
+    }
+
+    InstructionTrace::FileHeader header;
+    if (!InstructionTrace::readHeader(file, &header)) {
+        fprintf(stderr, "%s: Not a trace file or unsupported format version\n", argv[optind]);
+        fclose(file);
+        return 1;
+    }
+
+    // The CPU is only used for its instruction tables
+    VC64Object::setDefaultDebugLevel(0);
+    CPU *cpu = new CPU();
+    cpu->chipModel = (CPUChipModel)header.cpuModel;
+
+    static TraceRecord records[4096];
+    size_t n;
+
+    while ((n = fread(records, sizeof(TraceRecord), 4096, file)) > 0) {
+
+        for (size_t i = 0; i < n; i++) {
+
+            const TraceRecord &r = records[i];
+            if (r.cycle < from || r.cycle > to)
+                continue;
+
+            printf("%12llu %3d:%02d  ", (unsigned long long)r.cycle, r.rasterline, r.rasterCycle);
+
+            if (r.type == TRACE_IRQ || r.type == TRACE_NMI) {
+                printf("%s\n", r.type == TRACE_IRQ ? "IRQ" : "NMI");
+                continue;
+            }
+
+            DisassembledInstruction instr = cpu->disassemble(r, hex);
+            printf("%s: %s %s %s   %s %s %s %s %s %s\n",
+                   instr.pc,
+                   instr.byte1, instr.byte2, instr.byte3,
+                   instr.A, instr.X, instr.Y, instr.SP,
+                   instr.flags,
+                   instr.command);
+        }
+    }
+
+    delete cpu;
+    fclose(file);
+    return 0;
+}
@@ -134,6 +134,9 @@ struct ContainerWrapper;
 - (void) dump;
 
 - (void *) screenBuffer;
+- (BOOL) acquireFrame;
+- (void *) acquiredScreenBuffer;
+- (UInt64) acquiredFrame;
 
 - (NSColor *) color:(NSInteger)nr;
 - (NSInteger) colorScheme;
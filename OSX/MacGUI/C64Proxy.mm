@@ -158,6 +158,9 @@ struct CRTContainerWrapper { CRTContainer *crtcontainer; };
 - (void) dump { wrapper->vic->dumpState(); }
 
 - (void *) screenBuffer { return wrapper->vic->screenBuffer(); }
+- (BOOL) acquireFrame { return wrapper->vic->acquireFrame(); }
+- (void *) acquiredScreenBuffer { return wrapper->vic->acquiredScreenBuffer(); }
+- (UInt64) acquiredFrame { return wrapper->vic->acquiredFrame(); }
 
 - (NSColor *) color:(NSInteger)nr
 {
@@ -279,20 +282,21 @@ struct CRTContainerWrapper { CRTContainer *crtcontainer; };
 
 - (void) dump { wrapper->keyboard->dumpState(); }
 
+// Input is routed through the movie recorder which applies it in the emulator thread
 - (void) pressKeyAtRow:(NSInteger)row col:(NSInteger)col {
-    wrapper->keyboard->pressKey(row, col); }
+    wrapper->keyboard->c64->movie.pressKey(row, col); }
 - (void) pressRestoreKey {
-    wrapper->keyboard->pressRestoreKey(); }
+    wrapper->keyboard->c64->movie.pressRestoreKey(); }
 
 - (void) releaseKeyAtRow:(NSInteger)row col:(NSInteger)col {
-    wrapper->keyboard->releaseKey(row, col); }
+    wrapper->keyboard->c64->movie.releaseKey(row, col); }
 - (void) releaseRestoreKey {
-    wrapper->keyboard->releaseRestoreKey(); }
-- (void) releaseAll { wrapper->keyboard->releaseAll(); }
+    wrapper->keyboard->c64->movie.releaseRestoreKey(); }
+- (void) releaseAll { wrapper->keyboard->c64->movie.releaseAllKeys(); }
 
 - (BOOL) shiftLockIsPressed { return wrapper->keyboard->shiftLockIsPressed(); }
-- (void) lockShift { wrapper->keyboard->pressShiftLockKey(); }
-- (void) unlockShift { wrapper->keyboard->releaseShiftLockKey(); }
+- (void) lockShift { wrapper->keyboard->c64->movie.pressShiftLockKey(); }
+- (void) unlockShift { wrapper->keyboard->c64->movie.releaseShiftLockKey(); }
 
 @end
 
@@ -312,7 +316,8 @@ struct CRTContainerWrapper { CRTContainer *crtcontainer; };
     return self;
 }
 
-- (void) trigger:(JoystickEvent)event { wrapper->port->trigger(event); }
+- (void) trigger:(JoystickEvent)event {
+    wrapper->port->c64->movie.trigger(wrapper->port->getNr(), event); }
 - (void) dump { wrapper->port->dumpState(); }
 // - (NSInteger) potX { return wrapper->sid->getPotX(); }
 // - (NSInteger) potY { return wrapper->sid->getPotY(); }
@@ -756,10 +761,10 @@ struct CRTContainerWrapper { CRTContainer *crtcontainer; };
 - (void) connectMouse:(NSInteger)toPort { wrapper->c64->connectMouse((unsigned)toPort); }
 - (void) disconnectMouse { wrapper->c64->connectMouse(0); }
 - (void) setMouseXY:(NSPoint)pos {
-    wrapper->c64->mouse->setXY((uint64_t)pos.x, (uint64_t)pos.y);
+    wrapper->c64->movie.setMouseXY((int64_t)pos.x, (int64_t)pos.y);
 }
-- (void) setMouseLeftButton:(BOOL)pressed { wrapper->c64->mouse->leftButton = pressed; }
-- (void) setMouseRightButton:(BOOL)pressed { wrapper->c64->mouse->rightButton = pressed;  }
+- (void) setMouseLeftButton:(BOOL)pressed { wrapper->c64->movie.setMouseLeftButton(pressed); }
+- (void) setMouseRightButton:(BOOL)pressed { wrapper->c64->movie.setMouseRightButton(pressed); }
 
 - (bool) warp { return wrapper->c64->getWarp(); }
 - (void) setWarp:(bool)b { wrapper->c64->setWarp(b); }
@@ -776,6 +781,8 @@ struct CRTContainerWrapper { CRTContainer *crtcontainer; };
 - (NSInteger) numAutoSnapshots { return wrapper->c64->numAutoSnapshots(); }
 - (NSData *)autoSnapshotData:(NSInteger)nr {
     Snapshot *snapshot = wrapper->c64->autoSnapshot((unsigned)nr);
+    if (snapshot == NULL) return nil;
+    wrapper->c64->convertSnapshot(snapshot, PORTABLE_SNAPSHOT);
     return [NSData dataWithBytes: (void *)snapshot->header()
                           length: snapshot->sizeOnDisk()];
 }
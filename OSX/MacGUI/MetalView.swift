@@ -238,7 +238,9 @@ public class MetalView: MTKView {
         }
         */
         
-        let buf = controller.c64.vic.screenBuffer()
+        // Grab the latest complete frame (the emulator thread never writes into it)
+        controller.c64.vic.acquireFrame()
+        let buf = controller.c64.vic.acquiredScreenBuffer()
         precondition(buf != nil)
         
         let pixelSize = 4
@@ -291,6 +291,7 @@ extension MyController {
             break
             
         case MSG_CPU_HARD_BREAKPOINT_REACHED,
+             MSG_CPU_WATCHPOINT_REACHED,
              MSG_CPU_ILLEGAL_INSTRUCTION:
             self.debugOpenAction(self)
             refresh()
@@ -434,6 +435,12 @@ extension MyController {
             cartridgeIcon.isHidden = true
             break
             
+        case MSG_PROFILE:
+            break
+            
+        case MSG_STATE_DIVERGED:
+            break
+            
         default:
             track("Unknown message: \(msg)")
             assert(false)
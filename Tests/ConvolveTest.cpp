@@ -0,0 +1,141 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* convolve-test
+ *
+ * Checks that all convolution kernels of the reSID resampling filter compute
+ * the same value as a reference implementation. The reference sums up the
+ * products with unsigned arithmetic, i.e., with the 32 bit wraparound the
+ * kernels are specified with. The kernels are fed with random filter kernels
+ * and sample windows of random length and alignment. Every kernel that
+ * select_convolve_kernel() can return is tested if the host CPU supports it.
+ */
+
+#include "sid.h"
+#include <stdint.h>
+#include <stdio.h>
+
+using namespace reSID;
+
+//! @brief    Pseudo random numbers (xorshift64*)
+static uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+static unsigned
+rnd(unsigned range)
+{
+    seed ^= seed >> 12;
+    seed ^= seed << 25;
+    seed ^= seed >> 27;
+    return (unsigned)((seed * 0x2545F4914F6CDD1DULL) >> 32) % range;
+}
+
+//! @brief    Random sample value. Extreme values are drawn more often.
+static short
+rndShort()
+{
+    switch (rnd(8)) {
+        case 0: return -32768;
+        case 1: return 32767;
+        case 2: return (short)(rnd(64) - 32);
+        default: return (short)(rnd(65536) - 32768);
+    }
+}
+
+//! @brief    Reference implementation
+static int
+convolveReference(const short *a, const short *b, int n)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < n; i++) {
+        v += (uint32_t)((int)a[i] * (int)b[i]);
+    }
+    return (int)v;
+}
+
+//! @brief    Maximum window length (larger than any FIR filter reSID sets up)
+static const int maxLength = 4096;
+
+//! @brief    Number of random windows per kernel
+static const int rounds = 20000;
+
+static bool
+testKernel(const char *name, convolve_kernel convolve)
+{
+    // Some slack for misaligned windows
+    static short a[maxLength + 16], b[maxLength + 16];
+    unsigned errors = 0;
+
+    for (int r = 0; r < rounds; r++) {
+
+        // All short lengths are covered, longer ones are drawn at random
+        int n = r < 128 ? r : (int)rnd(maxLength + 1);
+        const short *sa = a + rnd(16);
+        const short *sb = b + rnd(16);
+
+        for (int i = 0; i < n + 16; i++) {
+            a[i] = rndShort();
+            b[i] = rndShort();
+        }
+
+        int expected = convolveReference(sa, sb, n);
+        int result = convolve(sa, sb, n);
+
+        if (result != expected) {
+            if (errors++ < 10) {
+                fprintf(stderr, "%s: n = %d: expected %d, got %d\n", name, n, expected, result);
+            }
+        }
+    }
+
+    printf("%-16s: %s (%d windows)\n", name, errors ? "FAILED" : "ok", rounds);
+    return errors == 0;
+}
+
+int
+main()
+{
+    bool success = true;
+    convolve_kernel selected = select_convolve_kernel();
+    bool selectedTested = false;
+
+    success &= testKernel("convolve_scalar", convolve_scalar);
+    selectedTested |= selected == convolve_scalar;
+
+#if RESID_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        success &= testKernel("convolve_sse2", convolve_sse2);
+        selectedTested |= selected == convolve_sse2;
+    } else {
+        printf("%-16s: skipped (no SSE2)\n", "convolve_sse2");
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        success &= testKernel("convolve_avx2", convolve_avx2);
+        selectedTested |= selected == convolve_avx2;
+    } else {
+        printf("%-16s: skipped (no AVX2)\n", "convolve_avx2");
+    }
+#endif
+
+    if (!selectedTested) {
+        fprintf(stderr, "select_convolve_kernel() returned an untested kernel\n");
+        success = false;
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+# Records a hash stream with one dispatch-test binary and compares it with another
+#
+# RECORD, COMPARE : dispatch-test binaries, e.g., linked against both dispatch variants
+# RECORD_OPTIONS,
+# COMPARE_OPTIONS : Optional options passed to RECORD and COMPARE
+# STREAM          : Hash stream written by RECORD and compared by COMPARE
+# FRAMES          : Number of frames to emulate
+# ROMS, DISK      : Optional ROM directory and disk image
+
+set(ARGS ${STREAM} ${FRAMES})
+if(ROMS)
+    list(APPEND ARGS ${ROMS})
+    if(DISK)
+        list(APPEND ARGS ${DISK})
+    endif()
+endif()
+
+execute_process(COMMAND ${RECORD} ${RECORD_OPTIONS} record ${ARGS} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Recording the hash stream failed")
+endif()
+
+execute_process(COMMAND ${COMPARE} ${COMPARE_OPTIONS} compare ${ARGS} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Hash streams diverge")
+endif()
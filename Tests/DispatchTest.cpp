@@ -0,0 +1,145 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* dispatch-test
+ *
+ * Checks that switch dispatch and threaded-code dispatch of the 6502 core
+ * behave identically. The program is linked twice, once against each variant
+ * of the core library. The first binary records a stream of per-frame state
+ * hashes (see StateHasher.h), the second one compares against it.
+ *
+ * By default, the emulator runs synthetic ROM images. Their Kernal and VC1541
+ * ROM contain a pseudo-random instruction stream covering all opcodes except
+ * the JAM opcodes, with all addressing modes and random operands. Interrupts
+ * from the CIAs, the VIC, and the VIAs are acknowledged by small handlers.
+ * Write accesses are kept below 0xE000 and the Kernal is copied into the RAM
+ * underneath, so the code survives random banking. The drive only writes into
+ * its RAM, because random VIA configurations flood the log with warnings.
+ * Alternatively, a directory with real ROM images (basic.rom, char.rom,
+ * kernal.rom, vc1541.rom) and a disk image can be given.
+ *
+ * With --no-drive-sleep, the VC1541 is executed in every cycle. Recording a
+ * stream this way and comparing it with a sleeping drive checks that drive
+ * sleep is invisible to the emulated machine. To make the drive fall asleep,
+ * the synthetic VC1541 ROM waits in an idle loop at VC1541_IDLE_LOOP until
+ * the IEC bus changes or a VIA timer interrupt has occurred.
+ */
+
+#include "SyntheticRoms.h"
+
+int
+main(int argc, char *argv[])
+{
+    bool driveSleep = true;
+    if (argc > 1 && strcmp(argv[1], "--no-drive-sleep") == 0) {
+        driveSleep = false;
+        argv++;
+        argc--;
+    }
+    
+    if (argc < 3 || argc > 6 ||
+        (strcmp(argv[1], "record") != 0 && strcmp(argv[1], "compare") != 0)) {
+        fprintf(stderr,
+                "Usage: %s [--no-drive-sleep] record|compare <hash file> "
+                "[frames [rom directory [disk]]]\n", argv[0]);
+        return 1;
+    }
+
+    bool record = strcmp(argv[1], "record") == 0;
+    const char *hashFile = argv[2];
+    long frames = argc > 3 ? atol(argv[3]) : 200;
+    const char *romDir = argc > 4 ? argv[4] : NULL;
+    const char *diskFile = argc > 5 ? argv[5] : NULL;
+
+    VC64Object::setDefaultDebugLevel(0);
+    C64 *c64 = new C64();
+
+    // Load ROMs
+    if (!loadRoms(c64, romDir))
+        return 1;
+
+    // Attach media
+    if (diskFile) {
+        Archive *archive = Archive::makeArchiveWithFile(diskFile);
+        if (!archive || !c64->insertDisk(archive)) {
+            fprintf(stderr, "%s: Cannot insert disk\n", diskFile);
+            return 1;
+        }
+        delete archive;
+    }
+
+    c64->autoSaveSnapshots = false;
+    c64->setAlwaysWarp(true);
+    c64->floppy.setSleepMode(driveSleep);
+
+    if (record ? !c64->hasher.startRecording(hashFile) : !c64->hasher.startComparing(hashFile)) {
+        fprintf(stderr, "%s: Cannot %s hash stream\n", hashFile, record ? "write" : "read");
+        return 1;
+    }
+
+    // Emulate line by line to see how long the drive sleeps
+    long sleepingLines = 0;
+    for (long i = 0; i < frames; i++) {
+        do {
+            if (!c64->executeOneLine()) {
+                fprintf(stderr, "Emulation stopped in frame %llu (CPU error state %d)\n",
+                        (unsigned long long)c64->getFrame(), c64->cpu.getErrorState());
+                return 1;
+            }
+            if (c64->floppy.isSleeping()) sleepingLines++;
+        } while (c64->getRasterline() != 0);
+    }
+    c64->hasher.stop();
+
+    // The synthetic programs never leave their ROM area (or the RAM copy)
+    c64->floppy.wakeUp();
+    printf("Frames          : %ld\n", frames);
+    printf("C64 PC          : %04X\n", c64->cpu.getPC_at_cycle_0());
+    printf("VC1541 PC       : %04X\n", c64->floppy.cpu.getPC_at_cycle_0());
+    printf("VC1541 sleeps   : %ld rasterlines\n", sleepingLines);
+    if (romDir == NULL && (c64->cpu.getPC_at_cycle_0() < 0xE000 ||
+                           c64->floppy.cpu.getPC_at_cycle_0() < 0xC000)) {
+        fprintf(stderr, "Synthetic program has run off\n");
+        return 1;
+    }
+    if (romDir == NULL && driveSleep && sleepingLines == 0) {
+        fprintf(stderr, "VC1541 has never been sent to sleep\n");
+        return 1;
+    }
+
+    int result = 0;
+    StateHasher::Divergence divergence = c64->hasher.getDivergence();
+    if (!record) {
+        if (divergence.diverged) {
+            printf("State diverges  : frame %llu, cycle %llu, component %s\n",
+                   (unsigned long long)divergence.frame, (unsigned long long)divergence.cycle,
+                   divergence.component);
+            result = 1;
+        } else if (c64->hasher.getComparedFrames() != (uint64_t)frames) {
+            printf("Reference stream ends after %llu frames\n",
+                   (unsigned long long)c64->hasher.getComparedFrames());
+            result = 1;
+        } else {
+            printf("State matches   : %llu frames\n",
+                   (unsigned long long)c64->hasher.getComparedFrames());
+        }
+    }
+
+    delete c64;
+    return result;
+}
@@ -0,0 +1,105 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* render-skip-test
+ *
+ * Checks that skipped frames leave the screen buffers untouched. The emulator
+ * draws some frames, switches to render policy RENDER_NO_FRAMES, and keeps
+ * running. Afterwards, the published RGBA buffer and the palette index buffer
+ * must be byte-identical to the ones of the last drawn frame. This is checked
+ * in RGBA mode and in palette index mode. By default, the synthetic ROM images
+ * of dispatch-test are run. They change the border color and the other VIC
+ * registers at random.
+ */
+
+#include "SyntheticRoms.h"
+
+//! @brief    Number of frames drawn before the frames are skipped
+static const long drawnFrames = 20;
+
+static bool
+testMode(bool paletteIndexMode, long frames, const char *romDir)
+{
+    const char *name = paletteIndexMode ? "Palette index mode" : "RGBA mode";
+    const size_t pixels = PAL_RASTERLINES * NTSC_PIXELS;
+    bool success = true;
+
+    C64 *c64 = new C64();
+    if (!loadRoms(c64, romDir)) {
+        delete c64;
+        return false;
+    }
+    c64->autoSaveSnapshots = false;
+    c64->setAlwaysWarp(true);
+    c64->vic.setPaletteIndexMode(paletteIndexMode);
+
+    // Draw some frames
+    for (long i = 0; i < drawnFrames; i++) {
+        c64->executeOneFrame();
+    }
+
+    // Remember the buffers of the last drawn frame
+    uint8_t *indexBuffer = new uint8_t[pixels];
+    memcpy(indexBuffer, c64->vic.indexScreenBuffer(), pixels);
+    uint32_t *screenBuffer = NULL;
+    if (!paletteIndexMode) {
+        screenBuffer = new uint32_t[pixels];
+        memcpy(screenBuffer, c64->vic.screenBuffer(), pixels * 4);
+    }
+
+    // Skip all following frames
+    c64->vic.setRenderPolicy(RENDER_NO_FRAMES);
+    for (long i = 0; i < frames; i++) {
+        c64->executeOneFrame();
+    }
+
+    if (memcmp(indexBuffer, c64->vic.indexScreenBuffer(), pixels) != 0) {
+        fprintf(stderr, "%s: Skipped frames have modified the palette index buffer\n", name);
+        success = false;
+    }
+    if (screenBuffer && memcmp(screenBuffer, c64->vic.screenBuffer(), pixels * 4) != 0) {
+        fprintf(stderr, "%s: Skipped frames have modified the screen buffer\n", name);
+        success = false;
+    }
+    printf("%-18s: %s (%ld frames skipped)\n", name, success ? "ok" : "FAILED", frames);
+
+    delete[] indexBuffer;
+    delete[] screenBuffer;
+    delete c64;
+    return success;
+}
+
+int
+main(int argc, char *argv[])
+{
+    if (argc > 3) {
+        fprintf(stderr, "Usage: %s [frames [rom directory]]\n", argv[0]);
+        return 1;
+    }
+
+    long frames = argc > 1 ? atol(argv[1]) : 100;
+    const char *romDir = argc > 2 ? argv[2] : NULL;
+
+    VC64Object::setDefaultDebugLevel(0);
+
+    bool success = true;
+    success &= testMode(false, frames, romDir);
+    success &= testMode(true, frames, romDir);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+/*
+ * (C) 2018 Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* Synthetic ROM images for the test programs
+ *
+ * writeSyntheticRoms() stores a Basic, Character, Kernal, and VC1541 ROM in
+ * the current directory (synthetic-basic.rom, ...). See DispatchTest.cpp for
+ * what the generated code does. loadRoms() loads either these images or the
+ * original ROMs from a directory.
+ */
+
+#ifndef _SYNTHETIC_ROMS_INC
+#define _SYNTHETIC_ROMS_INC
+
+#include "C64.h"
+
+// Addressing modes of all opcodes
+//
+//   i : implied      # : immediate    z : zero page    x : zero page,X
+//   y : zero page,Y  a : absolute     X : absolute,X   Y : absolute,Y
+//   ( : (zp,X)       ) : (zp),Y       r : relative     j : JMP abs
+//   J : JMP (ind)    s : JSR          b : BRK          R : RTS, RTI
+//   K : JAM
+static const char *modes =
+"b(K(zzzzi#i#aaaa" "r)K)xxxxiYiYXXXX"  // 0x00 - 0x1F
+"s(K(zzzzi#i#aaaa" "r)K)xxxxiYiYXXXX"  // 0x20 - 0x3F
+"R(K(zzzzi#i#jaaa" "r)K)xxxxiYiYXXXX"  // 0x40 - 0x5F
+"R(K(zzzzi#i#Jaaa" "r)K)xxxxiYiYXXXX"  // 0x60 - 0x7F
+"#(#(zzzzi#i#aaaa" "r)K)xxyyiYiYXXYY"  // 0x80 - 0x9F
+"#(#(zzzzi#i#aaaa" "r)K)xxyyiYiYXXYY"  // 0xA0 - 0xBF
+"#(#(zzzzi#i#aaaa" "r)K)xxxxiYiYXXXX"  // 0xC0 - 0xDF
+"#(#(zzzzi#i#aaaa" "r)K)xxxxiYiYXXXX"; // 0xE0 - 0xFF
+
+//! @brief    Pseudo random numbers (xorshift64*)
+static uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+static unsigned
+rnd(unsigned range)
+{
+    seed ^= seed >> 12;
+    seed ^= seed << 25;
+    seed ^= seed >> 27;
+    return (unsigned)((seed * 0x2545F4914F6CDD1DULL) >> 32) % range;
+}
+
+//! @brief    Generator for a synthetic ROM image
+struct RomImage {
+
+    //! @brief    ROM contents and the address of the first byte
+    uint8_t data[0x4000];
+    uint16_t base;
+    size_t size;
+
+    //! @brief    Upper bound for all addresses written to by the generated code
+    unsigned writeLimit;
+
+    //! @brief    Current position of the generator
+    uint16_t pc;
+
+    RomImage(uint16_t base, size_t size, unsigned writeLimit) :
+    base(base), size(size), writeLimit(writeLimit), pc(base) {
+        memset(data, 0xEA, sizeof(data));
+    }
+
+    void emit(uint8_t byte) { data[(uint16_t)(pc++ - base)] = byte; }
+    void emit(uint8_t op, uint8_t lo) { emit(op); emit(lo); }
+    void emit(uint8_t op, uint8_t lo, uint8_t hi) { emit(op); emit(lo); emit(hi); }
+    void emitWord(uint16_t addr) { emit(addr & 0xFF); emit(addr >> 8); }
+    void emit(const uint8_t *bytes, size_t count) { while (count--) emit(*bytes++); }
+    void org(uint16_t addr) { pc = addr; }
+
+    //! @brief    Emits code that stores a pointer into the zero page
+    void pointer(uint8_t zp, uint16_t addr) {
+        emit(0xA9, addr & 0xFF); emit(0x85, zp);
+        emit(0xA9, addr >> 8); emit(0x85, (uint8_t)(zp + 1));
+    }
+
+    //! @brief    Emits a random instruction
+    void instruction(uint16_t rts) {
+
+        uint8_t op = (uint8_t)rnd(256);
+        uint8_t zp, x;
+
+        switch (modes[op]) {
+
+            case 'i': emit(op); break;
+            case '#': emit(op, (uint8_t)rnd(256)); break;
+            case 'z':
+            case 'x':
+            case 'y': emit(op, (uint8_t)rnd(256)); break;
+            case 'a': emit(op); emitWord((uint16_t)rnd(writeLimit)); break;
+            case 'X':
+            case 'Y': emit(op); emitWord((uint16_t)rnd(writeLimit - 0xFF)); break;
+            case '(':
+                // Let (zp,X) point to a random address below the write limit
+                x = (uint8_t)rnd(256);
+                zp = (uint8_t)(2 + rnd(0xFC));
+                emit(0xA2, x); // LDX #
+                pointer(zp, (uint16_t)rnd(writeLimit));
+                emit(op, (uint8_t)(zp - x));
+                break;
+            case ')':
+                zp = (uint8_t)(2 + rnd(0xFC));
+                pointer(zp, (uint16_t)rnd(writeLimit - 0xFF));
+                emit(op, zp);
+                break;
+            case 'r':
+                // Branch to the next instruction or skip a NOP
+                if (rnd(2)) { emit(op, 0); } else { emit(op, 1); emit(0xEA); }
+                break;
+            case 'j': emit(op); emitWord((uint16_t)(pc + 2)); break;
+            case 'J':
+                // The pointer must not cross a page boundary (6502 bug)
+                if (((pc + 3) & 0xFF) == 0xFF) emit(0xEA);
+                emit(op); emitWord((uint16_t)(pc + 2)); emitWord((uint16_t)(pc + 2));
+                break;
+            case 's': emit(op); emitWord(rts); break;
+            case 'b': emit(op, (uint8_t)rnd(256)); break;
+            default: break; // RTS, RTI, and JAM are never generated
+        }
+    }
+
+    //! @brief    Fills the ROM with random instructions followed by a jump
+    void program(uint16_t start, uint16_t end, uint16_t rts, uint16_t next) {
+        org(start);
+        while (pc < end) instruction(rts);
+        emit(0x4C); emitWord(next); // JMP next
+    }
+
+    //! @brief    Fills the ROM with random instructions and closes the loop
+    void program(uint16_t start, uint16_t end, uint16_t rts) { program(start, end, rts, start); }
+
+    bool save(const char *path) {
+        FILE *file = fopen(path, "wb");
+        if (file == NULL) return false;
+        bool success = fwrite(data, 1, size, file) == size;
+        return fclose(file) == 0 && success;
+    }
+};
+
+static bool
+writeSyntheticRoms()
+{
+    // Basic and Character ROM only need to be recognized
+    RomImage basic(0xA000, 0x2000, 0);
+    RomImage chars(0xD000, 0x1000, 0);
+    for (unsigned i = 0; i < 0x2000; i++) basic.data[i] = (uint8_t)rnd(256);
+    for (unsigned i = 0; i < 0x1000; i++) chars.data[i] = (uint8_t)rnd(256);
+    basic.org(0xA000); basic.emit(0x94, 0xE3, 0x7B);
+    chars.org(0xD000); chars.emit(0x3C, 0x66, 0x6E);
+
+    // Kernal
+    RomImage kernal(0xE000, 0x2000, 0xE000);
+    kernal.emit(0x85, 0x56, 0x20); // Magic bytes
+    kernal.org(0xE004);
+    const uint8_t kernalInit[] = {
+        0x78,             // SEI
+        0xA2, 0xFF, 0x9A, // LDX #$FF, TXS
+        0xA9, 0x2F, 0x85, 0x00, 0xA9, 0x37, 0x85, 0x01, // Standard memory layout
+        0xA9, 0x00, 0x85, 0xFB, 0xA9, 0xE0, 0x85, 0xFC, // ($FB) = $E000
+        0xA0, 0x00,       // LDY #0
+        0xB1, 0xFB,       // Copy the Kernal into the RAM underneath
+        0x91, 0xFB,
+        0xC8,
+        0xD0, 0xF9,
+        0xE6, 0xFC,
+        0xD0, 0xF5,
+        0x58              // CLI
+    };
+    kernal.emit(kernalInit, sizeof(kernalInit));
+    const uint8_t kernalIrq[] = {
+        0x48,                                           // PHA
+        0xA9, 0x2F, 0x85, 0x00, 0xA9, 0x37, 0x85, 0x01, // Make I/O visible
+        0xAD, 0x0D, 0xDC,                               // LDA $DC0D
+        0xAD, 0x0D, 0xDD,                               // LDA $DD0D
+        0xA9, 0xFF, 0x8D, 0x19, 0xD0,                   // Acknowledge VIC interrupts
+        0x68,                                           // PLA
+        0x40                                            // RTI
+    };
+    kernal.program(kernal.pc, 0xFEF0, 0xFF00);
+    kernal.org(0xFF00); kernal.emit(0x60); // RTS
+    kernal.org(0xFF10); kernal.emit(kernalIrq, sizeof(kernalIrq));
+    kernal.org(0xFFFA); kernal.emitWord(0xFF10); kernal.emitWord(0xE004); kernal.emitWord(0xFF10);
+
+    // VC1541 ROM
+    RomImage drive(0xC000, 0x4000, 0x0800);
+    drive.emit(0x97, 0xAA, 0xAA); // Magic bytes
+    
+    // The drive is reset to $EAA0 like the original ROM expects
+    const uint8_t driveInit[] = {
+        0x78, 0xA2, 0xFF, 0x9A,                         // SEI, LDX #$FF, TXS
+        0xA9, 0x6F, 0x8D, 0x02, 0x1C,                   // Keep the motor off
+        0xA9, 0x40, 0x8D, 0x0B, 0x1C,                   // VIA2 timer 1 runs continuously
+        0xA9, 0x98, 0x8D, 0x04, 0x1C,
+        0xA9, 0x3A, 0x8D, 0x05, 0x1C,
+        0xA9, 0xC0, 0x8D, 0x0E, 0x1C,                   // Enable its interrupt
+        0xA9, 0x00, 0x8D, 0x0B, 0x18,                   // VIA1 timer 1 fires once
+        0xA9, 0x00, 0x8D, 0x04, 0x18,
+        0xA9, 0x60, 0x8D, 0x05, 0x18,
+        0xA9, 0xC0, 0x8D, 0x0E, 0x18,                   // Enable its interrupt
+        0x58,                                           // CLI
+        0x4C, 0x04, 0xC0                                // JMP $C004
+    };
+    const uint8_t driveIrq[] = {
+        0x48,                   // PHA
+        0xA9, 0x7F,             // Acknowledge VIA interrupts
+        0x8D, 0x0D, 0x18,
+        0x8D, 0x0D, 0x1C,
+        0xE6, 0x03,             // Count interrupts
+        0x68,                   // PLA
+        0x40                    // RTI
+    };
+    
+    // The drive waits in an idle loop until the IEC bus changes or an
+    // interrupt has occurred. The loop must not write to avoid waking up.
+    const uint8_t driveWait[] = {
+        0xAD, 0x00, 0x18,       // LDA $1800
+        0x85, 0x02,             // STA $02
+        0xA5, 0x03,             // LDA $03
+        0x85, 0x04,             // STA $04
+        0x4C, 0xFF, 0xEB        // JMP VC1541_IDLE_LOOP
+    };
+    const uint8_t driveIdle[] = {
+        0xAD, 0x00, 0x18,       // LDA $1800
+        0xC5, 0x02,             // CMP $02
+        0xD0, 0x06,             // BNE $EC0C
+        0xA5, 0x03,             // LDA $03
+        0xC5, 0x04,             // CMP $04
+        0xF0, 0xF3,             // BEQ VC1541_IDLE_LOOP
+        0x4C, 0x20, 0xEC        // JMP $EC20
+    };
+    drive.program(0xC004, 0xEA80, 0xFF00, 0xEBF0);
+    drive.org(0xEAA0); drive.emit(driveInit, sizeof(driveInit));
+    drive.org(0xEBF0); drive.emit(driveWait, sizeof(driveWait));
+    drive.org(VC1541_IDLE_LOOP); drive.emit(driveIdle, sizeof(driveIdle));
+    drive.program(0xEC20, 0xFEF0, 0xFF00, 0xC004);
+    drive.org(0xFF00); drive.emit(0x60); // RTS
+    drive.org(0xFF10); drive.emit(driveIrq, sizeof(driveIrq));
+    drive.org(0xFFFA); drive.emitWord(0xFF10); drive.emitWord(0xEAA0); drive.emitWord(0xFF10);
+
+    return
+    basic.save("synthetic-basic.rom") && chars.save("synthetic-char.rom") &&
+    kernal.save("synthetic-kernal.rom") && drive.save("synthetic-vc1541.rom");
+}
+
+/*! @brief    Loads all ROM images
+ *  @details  If no directory is given, the synthetic ROM images are written and loaded.
+ */
+static bool
+loadRoms(C64 *c64, const char *romDir)
+{
+    const char *names[] = { "basic.rom", "char.rom", "kernal.rom", "vc1541.rom" };
+    if (romDir == NULL && !writeSyntheticRoms()) {
+        fprintf(stderr, "Cannot write synthetic ROM images\n");
+        return false;
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        char path[1024];
+        if (romDir) {
+            snprintf(path, sizeof(path), "%s/%s", romDir, names[i]);
+        } else {
+            snprintf(path, sizeof(path), "synthetic-%s", names[i]);
+        }
+        if (!c64->loadRom(path)) {
+            fprintf(stderr, "%s: Not a valid ROM image\n", path);
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif